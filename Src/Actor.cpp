@@ -2,8 +2,13 @@
 @file Actor.cpp
 */
 #include "Actor.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "CollisionBatch.h"
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/constants.hpp>
 #include <algorithm>
+#include <atomic>
 
 /*
 RXgN^
@@ -22,24 +27,40 @@ Actor::Actor(const std::string& name, int health,
 	: name(name), health(health), position(position),
 	rotation(rotation), scale(scale)
 {
-
+	SaveTransform();
+	Interpolate(1.0f);
 }
 
 /*
-AN^[̏ԂXV(ʒuȂ)
+ʒuՓˌ`AABB̍łp܂ł̋vZ
 
-@param deltaTime oߎ
+@param position ʒu
+@param box      Փˌ`AABB
 
-UpdataDrawData()OɎs邱
+@return BՓˌ`󂪂Ȃ(AABB)ꍇ0
 */
-void Actor::Update(float deltaTime)
+static float CalcReach(const glm::vec3& position, const Collision::AABB& box)
 {
-	position += velocity * deltaTime;
+	if (box.min.x > box.max.x)
+	{
+		return 0;
+	}
+	return glm::length(glm::max(glm::abs(box.min - position), glm::abs(box.max - position)));
+}
 
-	//Փ˔̍XV
+/*
+[hWn̏Փˌ`vZ
+
+@param colLocal [JWn̏Փˌ`
+@param position ʒu
+@param rotation ]
+@param scale    g嗦
+@param colWorld vZʂ̊i[
+*/
+static void CalcColWorld(const Collision::Shape& colLocal, const glm::vec3& position,
+	const glm::vec3& rotation, const glm::vec3& scale, Collision::Shape& colWorld)
+{
 	const glm::mat4 matT = glm::translate(glm::mat4(1), position);
-	const glm::mat4 matR_Y = glm::rotate(glm::mat4(1), rotation.y, glm::vec3(0, 1, 0));
-	const glm::mat4 matR_ZY = glm::rotate(glm::mat4(1), rotation.z, glm::vec3(0, 0, -1));
 	const glm::mat4 matR_XZY = glm::rotate(glm::mat4(1), rotation.x, glm::vec3(1, 0, 0));
 	const glm::mat4 matS = glm::scale(glm::mat4(1), scale);
 	const glm::mat4 matModel = matT * matR_XZY * matS;
@@ -69,6 +90,35 @@ void Actor::Update(float deltaTime)
 	}
 }
 
+/*
+AN^[̏ԂXV(ʒuȂ)
+
+@param deltaTime oߎ
+
+UpdataDrawData()OɎs邱
+*/
+void Actor::Update(float deltaTime)
+{
+	position += velocity * deltaTime;
+
+	//Փ˔̍XV
+	CalcColWorld(colLocal, position, rotation, scale, colWorld);
+}
+
+/*
+lύXƂo^̃Xgɒʒm
+
+Xg͎Update()ŁAʒmꂽAN^[̒lSoAɎ荞
+Update()ƎɎĂAN^[͖荞܂̂ŁAʒmȂĂ悢
+*/
+void Actor::MarkChanged()
+{
+	for (ActorListBase* list : ownerLists)
+	{
+		list->MarkChanged(this);
+	}
+}
+
 /*
 `̍XV
 
@@ -89,6 +139,44 @@ void Actor::Draw()
 
 }
 
+/*
+݂̈ʒuƉ]Ԃ̎n_Ƃĕۑ
+
+V~[V̍XVn߂OɎs邱
+*/
+void Actor::SaveTransform()
+{
+	prevPosition = position;
+	prevRotation = rotation;
+}
+
+/*
+`ɎgfsvZ
+
+@param alpha ԌW(0ȂO̍XVJnA1Ȃ猻݂̎p)
+
+]͊px̍łȂɕԂ
+*/
+void Actor::Interpolate(float alpha)
+{
+	const float pi = glm::pi<float>();
+	glm::vec3 diff = rotation - prevRotation;
+	for (int i = 0; i < 3; ++i)
+	{
+		diff[i] -= glm::floor((diff[i] + pi) / (pi * 2)) * pi * 2;
+	}
+	const glm::vec3 pos = glm::mix(prevPosition, position, alpha);
+	const glm::vec3 rot = rotation - diff * (1.0f - alpha);
+
+	// AN^[ɐݒ肳ꂽʒuA]Ag嗦烂fsvZ
+	const glm::mat4 matT = glm::translate(glm::mat4(1), pos);
+	const glm::mat4 matR_Y = glm::rotate(glm::mat4(1), rot.y, glm::vec3(0, 1, 0));
+	const glm::mat4 matR_ZY = glm::rotate(matR_Y, rot.z, glm::vec3(0, 0, -1));
+	const glm::mat4 matR_XZY = glm::rotate(matR_ZY, rot.x, glm::vec3(1, 0, 0));
+	const glm::mat4 matS = glm::scale(glm::mat4(1), scale);
+	matModel = matT * matR_XZY * matS;
+}
+
 /*
 RXgN^
 
@@ -114,14 +202,6 @@ void StaticMeshActor::Draw()
 {
 	if (mesh)
 	{
-	// AN^[ɐݒ肳ꂽʒuA]Ag嗦烂fsvZ
-		const glm::mat4 matT = glm::translate(glm::mat4(1), position);
-		const glm::mat4 matR_Y = glm::rotate(glm::mat4(1), rotation.y, glm::vec3(0, 1, 0));
-		const glm::mat4 matR_ZY = glm::rotate(matR_Y, rotation.z, glm::vec3(0, 0, -1));
-		const glm::mat4 matR_XZY = glm::rotate(matR_ZY, rotation.x, glm::vec3(1, 0, 0));
-		const glm::mat4 matS = glm::scale(glm::mat4(1), scale);
-		const glm::mat4 matModel = matT * matR_XZY * matS;
-
 		if (!mesh->material.empty())
 		{
 			// gp郉Cg̃CfbNXjtH[ϐɃRs[
@@ -168,281 +248,1336 @@ void StaticMeshActor::SetSpotLightList(const std::vector<int>& v)
 /*
 i[\ȃAN^[mۂ
 
-@param reserveCount AN^[z̊mې
+@param reserveCount z̊mې
 */
-void ActorList::Reserve(size_t reserveCount)
+void ActorStore::Reserve(size_t reserveCount)
 {
-	actors.reserve(reserveCount);
+	actor.reserve(reserveCount);
+	position.reserve(reserveCount);
+	velocity.reserve(reserveCount);
+	rotation.reserve(reserveCount);
+	scale.reserve(reserveCount);
+	health.reserve(reserveCount);
+	colLocal.reserve(reserveCount);
+	colWorld.reserve(reserveCount);
+	bounds.reserve(reserveCount);
+	layer.reserve(reserveCount);
+	mask.reserve(reserveCount);
+	ownUpdate.reserve(reserveCount);
+	changed.reserve(reserveCount);
+	dirty.reserve(reserveCount);
 }
 
 /*
 AN^[ǉ
 
-@param actor ǉAN^[
+@param p            ǉAN^[
+@param hasOwnUpdate pUpdate()ƎɎĂtrue
 */
-void ActorList::Add(const ActorPtr& actor)
+void ActorStore::Add(Actor* p, bool hasOwnUpdate)
 {
-	actors.push_back(actor);
+	actor.push_back(p);
+	position.push_back(p->position);
+	velocity.push_back(p->velocity);
+	rotation.push_back(p->rotation);
+	scale.push_back(p->scale);
+	health.push_back(p->health);
+	colLocal.push_back(p->colLocal);
+	colWorld.push_back(p->colWorld);
+	bounds.push_back(Collision::CalcAABB(p->colWorld));
+	layer.push_back(p->collisionLayer);
+	mask.push_back(p->collisionMask);
+	ownUpdate.push_back(hasOwnUpdate ? 1 : 0);
+	changed.push_back(0);
+	dirty.push_back(1);
 }
 
 /*
-AN^[폜
+vfړ
 
-@param actor 폜AN^[
+@param from ړ̃CfbNX
+@param to   ړ̃CfbNX
+
+ړ̗vf͕sɂȂ̂ŁAResize()Ő؂l߂邱
 */
-bool ActorList::Remove(const ActorPtr& actor)
+void ActorStore::Move(size_t from, size_t to)
 {
-	//|C^vAN^T
-	//
-	for (auto itr = actors.begin(); itr != actors.end(); ++itr)
-	{
-		if (*itr == actor)
-		{
-			actors.erase(itr);
-			return true;
-		}
-	}
-	return false;
+	actor[to] = actor[from];
+	position[to] = position[from];
+	velocity[to] = velocity[from];
+	rotation[to] = rotation[from];
+	scale[to] = scale[from];
+	health[to] = health[from];
+	colLocal[to] = colLocal[from];
+	colWorld[to] = colWorld[from];
+	bounds[to] = bounds[from];
+	layer[to] = layer[from];
+	mask[to] = mask[from];
+	ownUpdate[to] = ownUpdate[from];
+	changed[to] = changed[from];
+	dirty[to] = dirty[from];
 }
 
 /*
-w肳ꂽWɑΉiq̃CfbNX擾
+vfύX
 
-@param pos CfbNX̌ɂȂʒu
+@param n Vvf
 
-@retun posɑΉiq̃CfbNX
+vf炷ꍇɎg
 */
-glm::ivec2 ActorList::CalcMapIndex(const glm::vec3& pos) const
+void ActorStore::Resize(size_t n)
 {
-	const int x = std::max(0,
-		std::min(sepalationSizeX - 1, static_cast<int>(pos.x / mapGridSizeX)));
-	const int y = std::max(0,
-		std::min(sepalationSizeY - 1, static_cast<int>(pos.z / mapGridSizeY)));
-	return glm::ivec2(x, y);
+	actor.resize(n);
+	position.resize(n);
+	velocity.resize(n);
+	rotation.resize(n);
+	scale.resize(n);
+	health.resize(n);
+	colLocal.resize(n);
+	colWorld.resize(n);
+	bounds.resize(n);
+	layer.resize(n);
+	mask.resize(n);
+	ownUpdate.resize(n);
+	changed.resize(n);
+	dirty.resize(n);
 }
 
 /*
-AN^[̏ԂXV
+AN^[ŕύXꂽl荞
 
-@param deltaTime O̍XV̌oߎ
+@param begin ͈͂̐擪
+@param end   ͈͂̏I[
+
+荞ނ̂́AUpdate()ƎɎĂAN^[ƁAύXʒmꂽAN^[
+ȊÕAN^[͖{̂ǂȂ
+ʒuA]Ag嗦OύXꂽAN^[͏Փˌ`̍ČvZΏۂɂ
 */
-void ActorList::Update(float deltaTime)
+void ActorStore::Sync(size_t begin, size_t end)
 {
-	//͈for
-	for (const ActorPtr& e : actors)
+	for (size_t i = begin; i < end; ++i)
 	{
-		if (e && e->health > 0)
+		if (!ownUpdate[i] && !changed[i])
 		{
-			e->Update(deltaTime);
+			continue;
 		}
-	}
-
-	for (auto i = actors.begin(); i != actors.end();)
-	{
-		const ActorPtr& e = *i;
-		if (!e || e->health <= 0)
+		changed[i] = 0;
+		const Actor& e = *actor[i];
+		health[i] = e.health;
+		velocity[i] = e.velocity;
+		layer[i] = e.collisionLayer;
+		mask[i] = e.collisionMask;
+		if (ownUpdate[i])
 		{
-			// erase => vectorvf폜邽߂Ɏg
-			// sA̗vfwlԂĂ
-			i = actors.erase(i);
+			// ōXVAN^[͌ʂ󂯎
+			position[i] = e.position;
+			rotation[i] = e.rotation;
+			scale[i] = e.scale;
+			colWorld[i] = e.colWorld;
+			bounds[i] = Collision::CalcAABB(colWorld[i]);
+			continue;
 		}
-		else
+		if (e.position != position[i] || e.rotation != rotation[i] || e.scale != scale[i])
 		{
-			++i;
+			position[i] = e.position;
+			rotation[i] = e.rotation;
+			scale[i] = e.scale;
+			dirty[i] = 1;
 		}
 	}
+}
+
+/*
+xϕĈʒuXV
 
-	// iqԂɃAN^[蓖Ă
-	for (int y = 0; y < sepalationSizeY; ++y)
+@param deltaTime oߎ
+@param begin     ͈͂̐擪
+@param end       ͈͂̏I[
+*/
+void ActorStore::Integrate(float deltaTime, size_t begin, size_t end)
+{
+	for (size_t i = begin; i < end; ++i)
 	{
-		for (int x = 0; x < sepalationSizeX; ++x)
+		if (!ownUpdate[i] && velocity[i] != glm::vec3(0))
 		{
-			grid[y][x].clear();
+			position[i] += velocity[i] * deltaTime;
+			dirty[i] = 1;
 		}
 	}
-	for (auto i = actors.begin(); i != actors.end(); ++i)
-	{
-		const glm::ivec2 mapIndex = CalcMapIndex((*i)->position);
-		grid[mapIndex.y][mapIndex.x].push_back(*i);
-	}
 }
 
+/*
+[hWn̏Փˌ`XV
 
+@param begin ͈͂̐擪
+@param end   ͈͂̏I[
 
-/*
-AN^[`f[^XV
+Î~ĂAN^[͌vZȗ
 */
-void ActorList::UpdateDrawData(float deltaTime)
+void ActorStore::UpdateColWorld(size_t begin, size_t end)
 {
-	for (const ActorPtr& e : actors)
+	for (size_t i = begin; i < end; ++i)
 	{
-		if (e && e->health > 0) {
-			e->UpdateDrawData(deltaTime);
+		if (dirty[i])
+		{
+			CalcColWorld(colLocal[i], position[i], rotation[i], scale[i], colWorld[i]);
+			bounds[i] = Collision::CalcAABB(colWorld[i]);
 		}
 	}
 }
 
 /*
-AN^[`悷
+XVʒuƏՓˌ`AN^[ɏ߂
+
+@param begin ͈͂̐擪
+@param end   ͈͂̏I[
 */
-void ActorList::Draw()
+void ActorStore::WriteBack(size_t begin, size_t end)
 {
-	for (const ActorPtr& e : actors)
+	for (size_t i = begin; i < end; ++i)
 	{
-		if (e && e->health > 0) {
-			e->Draw();
+		if (dirty[i])
+		{
+			actor[i]->position = position[i];
+			actor[i]->colWorld = colWorld[i];
+			dirty[i] = 0;
 		}
 	}
 }
 
 /*
-w肳ꂽW̋ߖTɂAN^[̃Xg擾
+RXgN^
 
-@param pos         ̊_ƂȂW
-@param maxDistance ߖTƂ݂Ȃő勗()
+@param cellSize  ԃCfbNX̊iq̑傫()
+@param boundsMin zŊǗ͈͂̍ŏW(XZ)
+@param boundsMax zŊǗ͈͂̍őW(XZ)
+
+̃Xgp̋ԃCfbNX
+*/
+ActorListBase::ActorListBase(float cellSize, const glm::vec2& boundsMin,
+	const glm::vec2& boundsMax)
+	: ownWorld(new World(cellSize, boundsMin, boundsMax))
+{
+	world = ownWorld.get();
+	world->AddList(this);
+}
+
+/*
+RXgN^
+
+@param world o^̋ԃCfbNX
 
-@return Actor::positionpos甼amaxDistanceȓɂAN^[̔z
+worldL鑼̃XgɔjȂ悤ɂ邱
 */
-std::vector<ActorPtr> ActorList::FindNearbyActors(
-	const glm::vec3& pos, float maxDistance) const
+ActorListBase::ActorListBase(World& world) : world(&world)
 {
-	std::vector<std::pair<float, ActorPtr>> buffer;
-	buffer.reserve(1000);
+	world.AddList(this);
+}
+
+/*
+fXgN^
 
-	const glm::ivec2 mapIndex = CalcMapIndex(pos);
-	const glm::ivec2 min = glm::max(mapIndex - 1, 0);
-	const glm::ivec2 max = glm::min(
-		mapIndex + 1, glm::ivec2(sepalationSizeX - 1, sepalationSizeY - 1));
-	for (int y = min.y; y <= max.y; ++y)
+LĂԃCfbNXo^O
+*/
+ActorListBase::~ActorListBase()
+{
+	for (uint32_t id : worldIds)
 	{
-		for (int x = min.x; x <= max.x; ++x)
+		if (id != invalidId)
 		{
-			const std::vector<ActorPtr>& list = grid[y][x];
-			for (auto actor : list)
-			{
-				const float distance = glm::distance(glm::vec3(actor->position), pos);
-				buffer.push_back(std::make_pair(distance, actor));
-			}
+			world->Unregister(id);
 		}
 	}
+	world->RemoveList(this);
+}
+
+/*
+SẴAN^[ÃXgւ̓o^
 
-	std::vector<ActorPtr> result;
-	result.reserve(100);
-	for (const auto& e : buffer)
+hNX̃fXgN^ŁAAN^[zjOɌĂяo
+*/
+void ActorListBase::ReleaseOwners()
+{
+	for (Actor* p : store.actor)
 	{
-		if (e.first <= maxDistance)
-		{
-			result.push_back(e.second);
-		}
+		RemoveOwner(p);
 	}
-	return result;
 }
 
 /*
-Փ˔s
+i[\ȃAN^[mۂ
 
-@param a       Ώۂ̃AN^[1
-@param b       Ώۂ̃AN^[2
-@param handler Փ˂ꍇɎs֐
+@param reserveCount AN^[z̊mې
 */
-void DetectCollision(const ActorPtr& a, const ActorPtr& b, CollisionHandlerType handler)
+void ActorListBase::ReserveBase(size_t reserveCount)
+{
+	store.Reserve(reserveCount);
+	worldIds.reserve(reserveCount);
+	removed.reserve(reserveCount);
+	indexMap.reserve(reserveCount);
+}
+
+/*
+AN^[̏Ԃo^
+
+@param actor        ǉAN^[
+@param hasOwnUpdate actorUpdate()ƎɎĂtrue
+
+@retval true  o^
+@retval false ɓo^Ă
+
+hNXtrueԂꍇAN^[z̖ɒǉ邱
+*/
+bool ActorListBase::AddBase(Actor* actor, bool hasOwnUpdate)
 {
-	if (a->health <= 0 || b->health <= 0)
+	const uint32_t index = static_cast<uint32_t>(store.Size());
+	if (!indexMap.insert(std::make_pair(actor, index)).second)
 	{
-		return;
+		return false;
 	}
-	glm::vec3 pa, pb;
-	if (Collision::TestShapeShape(a->colWorld, b->colWorld, &pa, &pb))
+	worldIds.push_back(world->Register(this, index, actor->position));
+	removed.push_back(0);
+	store.Add(actor, hasOwnUpdate);
+	maxReach = std::max(maxReach, CalcReach(actor->position, store.bounds.back()));
+	actor->ownerLists.push_back(this);
+	isStaticTreeDirty = true;
+	return true;
+}
+
+/*
+AN^[̒lύXꂽƂL^
+
+@param actor lύXAN^[
+
+Update()ŃAN^[̒lSoAɎ荞
+Update()̕񏈗́AXṼAN^[gɂĂĂяoĂ悢
+*/
+void ActorListBase::MarkChanged(const Actor* actor)
+{
+	const auto itr = indexMap.find(actor);
+	if (itr != indexMap.end())
 	{
-		if (handler)
-		{
-			handler(a, b, pb);
-		}
-		else
-		{
-			a->OnHit(b, pb);
-			b->OnHit(a, pa);
-		}
+		store.changed[itr->second] = 1;
 	}
 }
 
 /*
-Փ˔s
+AN^[̓o^悩炱̃XgO
 
-@param a       Ώۂ̃AN^[
-@param b       Ώۂ̃AN^[Xg
-@param handler Փ˂ꍇɎs֐
+@param actor o^OAN^[
+*/
+void ActorListBase::RemoveOwner(Actor* actor)
+{
+	std::vector<ActorListBase*>& lists = actor->ownerLists;
+	lists.erase(std::remove(lists.begin(), lists.end(), this), lists.end());
+}
+
+/*
+AN^[̍폜\񂷂
+
+@param actor 폜AN^[
+
+@retval true  폜\񂵂
+@retval false actor͓o^ĂȂAɍ폜\ς
+*/
+bool ActorListBase::RemoveBase(const Actor* actor)
+{
+	const auto itr = indexMap.find(actor);
+	if (itr == indexMap.end() || removed[itr->second])
+	{
+		return false;
+	}
+	MarkRemoved(itr->second);
+	return true;
+}
+
+/*
+w肳ꂽCfbNX̃AN^[ɍ폜\̈t
+
+@param i AN^[̃CfbNX
+
+ԃCfbNX͂ɊOASoȂ̗͂0ɂ
+`Փ˔̑ΏۂO
+*/
+void ActorListBase::MarkRemoved(size_t i)
+{
+	world->Unregister(worldIds[i]);
+	worldIds[i] = invalidId;
+	store.health[i] = 0;
+	removed[i] = 1;
+	++removedCount;
+	isStaticTreeDirty = true;
+}
+
+/*
+AN^[ʂ̃CfbNXɈړ
+
+@param from ړ̃CfbNX
+@param to   ړ̃CfbNX
+*/
+void ActorListBase::MoveEntry(size_t from, size_t to)
+{
+	MoveActor(from, to);
+	store.Move(from, to);
+	worldIds[to] = worldIds[from];
+	removed[to] = removed[from];
+	if (!removed[to])
+	{
+		indexMap[store.actor[to]] = static_cast<uint32_t>(to);
+		world->SetIndex(worldIds[to], static_cast<uint32_t>(to));
+	}
+}
+
+/*
+폜\񂳂ꂽAN^[z񂩂菜
+
+keepOrderfalseȂ疖̃AN^[󂢂ʒuɈڂċl߁A
+trueȂc̃AN^[̏Ԃۂ܂1̑ŋl߂
 */
-void DetectCollision(const ActorPtr& a, ActorList& b, CollisionHandlerType handler)
+void ActorListBase::Flush()
 {
-	if (a->health <= 0)
+	if (removedCount == 0)
 	{
 		return;
 	}
-	for (const ActorPtr& actorB : b)
+	for (size_t i = 0; i < store.Size(); ++i)
 	{
-		if (actorB->health <= 0)
+		if (removed[i])
 		{
-			continue;
+			indexMap.erase(store.actor[i]);
+			RemoveOwner(store.actor[i]);
 		}
-		glm::vec3 pa, pb;
-		if (Collision::TestShapeShape(a->colWorld, actorB->colWorld, &pa, &pb))
+	}
+
+	size_t n = store.Size();
+	if (keepOrder)
+	{
+		size_t w = 0;
+		for (size_t r = 0; r < n; ++r)
 		{
-			if (handler)
+			if (!removed[r])
 			{
-				handler(a, actorB, pb);
+				if (w != r)
+				{
+					MoveEntry(r, w);
+				}
+				++w;
 			}
-			else
+		}
+		n = w;
+	}
+	else
+	{
+		for (size_t i = 0; i < n;)
+		{
+			if (!removed[i])
 			{
-				a->OnHit(actorB, pb);
-				actorB->OnHit(a, pa);
+				++i;
+				continue;
 			}
-			if (a->health <= 0)
+			// ̃AN^[ڂāAڂAN^[xׂ
+			--n;
+			if (i != n)
 			{
-				break;
+				MoveEntry(n, i);
 			}
 		}
 	}
+
+	ResizeActors(n);
+	store.Resize(n);
+	worldIds.resize(n);
+	removed.resize(n);
+	removedCount = 0;
 }
 
 /*
-Փ˔s
+AN^[̏ԂXV
 
-@param a       Ώۂ̃AN^[Xg1
-@param b       Ώۂ̃AN^[Xg2
-@param handler Փ˂ꍇɎs֐
+@param deltaTime O̍XV̌oߎ
+
+eAN^[͎̏Ԃ̂ŁAWuVXeŕĕɍXV
+Update()̒łRaycast()ȂǂSoAǂނ̂ŁASoAւ̎荞݂͑S̍XVIĂs
 */
-void DetectCollision(ActorList& a, ActorList& b, CollisionHandlerType handler)
+void ActorListBase::Update(float deltaTime)
 {
-	for (const ActorPtr& actorA : a)
+	PROFILE_SCOPE("ActorList::Update");
+	JobSystem& jobSystem = JobSystem::Instance();
+
+	jobSystem.ParallelFor(store.Size(), updateGrainSize,
+		[this, deltaTime](size_t begin, size_t end)
 	{
-		if (actorA->health <= 0)
-		{
-			continue;
-		}
-		for (const ActorPtr& actorB : b)
+		// Update()ƎɎĂAN^[z֐ōXV
+		for (size_t i = begin; i < end; ++i)
 		{
-			if (actorB->health <= 0)
+			if (store.ownUpdate[i] && !removed[i] && store.actor[i]->health > 0)
 			{
-				continue;
+				store.actor[i]->Update(deltaTime);
 			}
-			glm::vec3 pa, pb;
-			if (Collision::TestShapeShape(actorA->colWorld, actorB->colWorld, &pa, &pb))
+		}
+	});
+
+	// AN^[̏ԂSoAɎ荞
+	jobSystem.ParallelFor(store.Size(), storeGrainSize,
+		[this](size_t begin, size_t end)
+	{
+		store.Sync(begin, end);
+	});
+
+	// ̗͂ȂȂAN^[ƁA폜\񂳂ꂽAN^[܂Ƃ߂Ď菜
+	for (size_t i = 0; i < store.Size(); ++i)
+	{
+		if (!removed[i] && store.health[i] <= 0)
+		{
+			MarkRemoved(i);
+		}
+	}
+	Flush();
+
+	// c̃AN^[͈ʒuƏՓˌ`SoAł܂Ƃ߂čXV
+	std::atomic<bool> isColWorldChanged{ false };
+	jobSystem.ParallelFor(store.Size(), storeGrainSize,
+		[this, deltaTime, &isColWorldChanged](size_t begin, size_t end)
+	{
+		store.Integrate(deltaTime, begin, end);
+		store.UpdateColWorld(begin, end);
+		if (isStatic)
+		{
+			// ōXVAN^[͏Փˌ`󂪕ςȂ̂ŁAς̂Ƃ݂Ȃ
+			for (size_t i = begin; i < end; ++i)
 			{
-				if (handler)
-				{
-					handler(actorA, actorB, pb);
-				}
-				else
-				{
-					actorA->OnHit(actorB, pb);
-					actorB->OnHit(actorA, pa);
-				}
-				if (actorA->health <= 0)
+				if (store.dirty[i] || store.ownUpdate[i])
 				{
+					isColWorldChanged.store(true, std::memory_order_relaxed);
 					break;
 				}
 			}
 		}
+		store.WriteBack(begin, end);
+	});
+
+	// BVHŐV̏Ԃɂ
+	if (isStatic)
+	{
+		if (isStaticTreeDirty)
+		{
+			BuildStaticTree();
+		}
+		else if (isColWorldChanged)
+		{
+			staticTree.Refit(store.colWorld);
+		}
+	}
+
+	MoveInWorld();
+}
+
+/*
+ԃCfbNẌʒuSoÄʒuɍ킹
+
+iq܂AN^[iqڂւAQueryOverlap()͈̗̌͂]ߒ
+*/
+void ActorListBase::MoveInWorld()
+{
+	maxReach = 0;
+	for (size_t i = 0; i < worldIds.size(); ++i)
+	{
+		if (worldIds[i] == invalidId)
+		{
+			continue;
+		}
+		world->Move(worldIds[i], store.position[i]);
+		maxReach = std::max(maxReach, CalcReach(store.position[i], store.bounds[i]));
+	}
+}
+
+/*
+݂̈ʒuƉ]Ԃ̎n_Ƃĕۑ
+
+V~[V̍XVn߂OɎs邱
+*/
+void ActorListBase::SaveTransform()
+{
+	for (size_t i = 0; i < store.Size(); ++i)
+	{
+		store.actor[i]->SaveTransform();
 	}
-}
\ No newline at end of file
+}
+
+/*
+AN^[`f[^XV
+
+@param deltaTime O̕`悩̌oߎ
+@param alpha     p̕ԌW(SaveTransform()̎_0A݂1)
+*/
+void ActorListBase::UpdateDrawData(float deltaTime, float alpha)
+{
+	PROFILE_SCOPE("ActorList::UpdateDrawData");
+	JobSystem::Instance().ParallelFor(store.Size(), updateGrainSize,
+		[this, deltaTime, alpha](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			if (store.health[i] > 0) {
+				store.actor[i]->Interpolate(alpha);
+				store.actor[i]->UpdateDrawData(deltaTime);
+			}
+		}
+	});
+}
+
+/*
+AN^[`悷
+*/
+void ActorListBase::Draw()
+{
+	PROFILE_SCOPE("ActorList::Draw");
+	for (size_t i = 0; i < store.Size(); ++i)
+	{
+		if (store.health[i] > 0) {
+			store.actor[i]->Draw();
+		}
+	}
+}
+
+/*
+ȂAN^[̃XgƂĈݒ肷
+
+@param b trueȂBVHďՓ˔⌟Ɏg
+*/
+void ActorListBase::SetStatic(bool b)
+{
+	isStatic = b;
+	if (isStatic)
+	{
+		BuildStaticTree();
+	}
+	else
+	{
+		staticTree.Clear();
+	}
+}
+
+/*
+BVH蒼
+
+x̓ǂݍ݂ŃAN^[ǉIĂяo
+ĂяoȂĂAUpdate()ō蒼
+ǉ΂̃AN^[͏Փˌ`󂪌vZĂȂ̂ŁAɌvZĂ
+*/
+void ActorListBase::BuildStaticTree()
+{
+	if (!isStatic)
+	{
+		return;
+	}
+	store.Sync(0, store.Size());
+	store.UpdateColWorld(0, store.Size());
+	store.WriteBack(0, store.Size());
+	staticTree.Build(store.colWorld);
+	MoveInWorld();
+
+	// 폜\񂳂ꂽAN^[cĂԂBVHgȂ
+	isStaticTreeDirty = removedCount > 0;
+}
+
+/*
+BVH擾
+
+@return ŐVBVH
+        SetStatic(true)ĂȂAǉE폜̌ō蒼ĂȂꍇnullptr
+*/
+const StaticBVH* ActorListBase::StaticTree() const
+{
+	if (!isStatic || isStaticTreeDirty)
+	{
+		return nullptr;
+	}
+	return &staticTree;
+}
+
+/*
+AABBƏՓˌ`AABBdȂAN^[
+
+@param box    ͈
+@param result AN^[̃CfbNXǉz(CfbNX̏)
+
+BVHgȂXǵAԃCfbNXňʒu߂AN^[ɍiĂAABBׂ
+ԃCfbNXɂ̓AN^[̈ʒuo^ĂȂ̂ŁA
+Փˌ`󂪈ʒułꂽAN^[̋(maxReach)͈͂L
+*/
+void ActorListBase::QueryOverlap(const Collision::AABB& box, std::vector<uint32_t>& result) const
+{
+	const size_t first = result.size();
+	if (const StaticBVH* tree = StaticTree())
+	{
+		tree->QueryOverlap(box, result);
+		std::sort(result.begin() + first, result.end());
+		return;
+	}
+	if (store.Size() <= linearQueryLimit)
+	{
+		for (size_t i = 0; i < store.Size(); ++i)
+		{
+			if (!removed[i] && Collision::TestAABBAABB(box, store.bounds[i]))
+			{
+				result.push_back(static_cast<uint32_t>(i));
+			}
+		}
+		return;
+	}
+
+	// Փˌ`AABBboxƏdȂAN^[́Aʒubox̒S
+	// (box̑Ίp̔ + maxReach)ȓɂ
+	const glm::vec3 center = (box.min + box.max) * 0.5f;
+	const float radius = glm::length(box.max - center) + maxReach;
+	world->Query(center, radius, this, result);
+	size_t n = first;
+	for (size_t k = first; k < result.size(); ++k)
+	{
+		const uint32_t i = result[k];
+		if (!removed[i] && Collision::TestAABBAABB(box, store.bounds[i]))
+		{
+			result[n] = i;
+			++n;
+		}
+	}
+	result.resize(n);
+	std::sort(result.begin() + first, result.end());
+}
+
+/*
+_ɍł߂Փˌ`AN^[
+
+@param p           ̊_
+@param maxDistance ő勗
+@param index       AN^[̃CfbNX̊i[
+@param closest     Փˌ`̍ŋߐړ_̊i[(pɂꍇp)
+
+@retval true  maxDistanceȓɌ
+@retval false Ȃ
+*/
+bool ActorListBase::FindClosest(const glm::vec3& p, float maxDistance,
+	size_t* index, glm::vec3* closest) const
+{
+	if (const StaticBVH* tree = StaticTree())
+	{
+		uint32_t i;
+		if (!tree->FindClosest(store.colWorld, p, maxDistance, &i, closest))
+		{
+			return false;
+		}
+		*index = i;
+		return true;
+	}
+	float bestSq = maxDistance * maxDistance;
+	bool found = false;
+	for (size_t i = 0; i < store.Size(); ++i)
+	{
+		if (removed[i])
+		{
+			continue;
+		}
+		const glm::vec3 q = Collision::ClosestPointShape(store.colWorld[i], p);
+		const float d2 = glm::dot(p - q, p - q);
+		if (d2 <= bestSq)
+		{
+			bestSq = d2;
+			*index = i;
+			*closest = q;
+			found = true;
+		}
+	}
+	return found;
+}
+
+/*
+CƍŏɌՓˌ`AN^[
+
+@param origin      C̎n_
+@param dir         Č(KĂ邱)
+@param maxDistance C̒
+@param index       AN^[̃CfbNX̊i[
+@param t           _܂ł̋̊i[
+@param ignore      肵ȂAN^[(Ȃnullptr)
+@param layerMask   Ώۂ̃C[
+
+@retval true  AN^[
+@retval false Ȃ
+
+BVHgȂꍇAՓˌ`AABBƌȂAN^[͏ڍׂȔȗ
+C[i荞ޏꍇABVH̓CAABBW߂邽߂Ɏg
+*/
+bool ActorListBase::Raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+	size_t* index, float* t, const Actor* ignore, Collision::LayerMask layerMask) const
+{
+	uint32_t ignoreIndex = StaticBVH::invalidIndex;
+	if (ignore)
+	{
+		const auto itr = indexMap.find(ignore);
+		if (itr != indexMap.end())
+		{
+			ignoreIndex = itr->second;
+		}
+	}
+	const StaticBVH* tree = StaticTree();
+	if (tree && layerMask == Collision::allLayers)
+	{
+		uint32_t i;
+		if (!tree->Raycast(store.colWorld, origin, dir, maxDistance, &i, t, ignoreIndex))
+		{
+			return false;
+		}
+		*index = i;
+		return true;
+	}
+	const glm::vec3 invDir = Collision::InverseDirection(dir);
+	float best = maxDistance;
+	bool found = false;
+	const auto test = [&](size_t i) {
+		float tHit;
+		if (removed[i] || i == ignoreIndex || !(store.layer[i] & layerMask) ||
+			!Collision::IntersectRayAABB(origin, invDir, store.bounds[i], best, &tHit))
+		{
+			return;
+		}
+		if (Collision::IntersectRayShape(origin, dir, store.colWorld[i], best, &tHit) &&
+			(!found || tHit < best || (tHit == best && i < *index)))
+		{
+			best = tHit;
+			*index = i;
+			found = true;
+		}
+	};
+	if (tree)
+	{
+		thread_local std::vector<uint32_t> candidates;
+		candidates.clear();
+		tree->QueryRay(origin, dir, maxDistance, candidates);
+		for (const uint32_t i : candidates)
+		{
+			test(i);
+		}
+	}
+	else
+	{
+		for (size_t i = 0; i < store.Size(); ++i)
+		{
+			test(i);
+		}
+	}
+	if (found)
+	{
+		*t = best;
+	}
+	return found;
+}
+
+/*
+CƏՓˌ`AABBAN^[
+
+@param origin      C̎n_
+@param dir         Č(KĂ邱)
+@param maxDistance C̒
+@param result      AN^[̃CfbNXǉz(CfbNX̏)
+*/
+void ActorListBase::QueryRay(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+	std::vector<uint32_t>& result) const
+{
+	const size_t first = result.size();
+	if (const StaticBVH* tree = StaticTree())
+	{
+		tree->QueryRay(origin, dir, maxDistance, result);
+		std::sort(result.begin() + first, result.end());
+		return;
+	}
+	const glm::vec3 invDir = Collision::InverseDirection(dir);
+	for (size_t i = 0; i < store.Size(); ++i)
+	{
+		float t;
+		if (!removed[i] &&
+			Collision::IntersectRayAABB(origin, invDir, store.bounds[i], maxDistance, &t))
+		{
+			result.push_back(static_cast<uint32_t>(i));
+		}
+	}
+}
+
+/*
+w肳ꂽW̋ߖTɂAN^[̃CfbNX擾
+
+@param pos         ̊_ƂȂW
+@param maxDistance ߖTƂ݂Ȃő勗()
+@param result      AN^[̃CfbNXǉz
+@param layerMask   Ώۂ̃C[
+*/
+void ActorListBase::FindNearbyIndices(const glm::vec3& pos, float maxDistance,
+	std::vector<uint32_t>& result, Collision::LayerMask layerMask) const
+{
+	world->Query(pos, maxDistance, this, result, layerMask);
+}
+
+namespace /* unnamed */ {
+
+// ₪̐ȏȂȀՓ˔SIMD߂ł܂Ƃ߂čs
+const size_t batchThreshold = 4;
+
+/*
+AN^[ƃXg̗vfAC[ƃ}XNŏՓ˔̑ΏۂɂȂĂ邩ׂ
+
+@param pA     Ώۂ̃AN^[
+@param storeB ̃XgSoA
+@param i      ̃CfbNX
+@param layers C[̑gݍ킹̕\B
+*/
+bool CanCollide(const Actor* pA, const ActorStore& storeB, uint32_t i,
+	const Collision::LayerMatrix& layers)
+{
+	return Collision::TestLayerMask(pA->collisionLayer, pA->collisionMask,
+		storeB.layer[i], storeB.mask[i]) &&
+		layers.Test(pA->collisionLayer, storeB.layer[i]);
+}
+
+/*
+AN^[ƂՓ˂ȂݒɂȂĂ邩ׂ
+*/
+bool IsCollisionDisabled(const Actor* p)
+{
+	return p->collisionLayer == 0 || p->collisionMask == 0;
+}
+
+/*
+ƌ̏Փˌ`܂Ƃ߂Ĕ肷
+
+@param s          
+@param store      ܂SoA
+@param candidates ̃CfbNX
+@param count      ̐
+@param hits       茋ʂ̊i[(ƓԂŁAՓ˂Ă1)
+@param points     Փ˂W̊i[(Ɠ)
+
+`̎ނƂSoAɋlߒĂ画肷
+*/
+void TestSphereCandidates(const Collision::Sphere& s, const ActorStore& store,
+	const uint32_t* candidates, size_t count,
+	std::vector<uint8_t>& hits, std::vector<glm::vec3>& points)
+{
+	thread_local Collision::SphereSoA spheres;
+	thread_local Collision::CapsuleSoA capsules;
+	thread_local Collision::OBBSoA obbs;
+	thread_local std::vector<uint32_t> order[3]; // ނƂ́Alߒvf̌ł̈ʒu
+	thread_local std::vector<uint32_t> hitMask;
+	thread_local std::vector<glm::vec3> hitPoints;
+
+	spheres.Clear();
+	capsules.Clear();
+	obbs.Clear();
+	for (auto& e : order)
+	{
+		e.clear();
+	}
+	for (size_t k = 0; k < count; ++k)
+	{
+		const Collision::Shape& shape = store.colWorld[candidates[k]];
+		switch (shape.type)
+		{
+		case Collision::Shape::Type::sphere:
+			spheres.Push(shape.s);
+			order[0].push_back(static_cast<uint32_t>(k));
+			break;
+		case Collision::Shape::Type::capsule:
+			capsules.Push(shape.c);
+			order[1].push_back(static_cast<uint32_t>(k));
+			break;
+		case Collision::Shape::Type::obb:
+			obbs.Push(shape.obb);
+			order[2].push_back(static_cast<uint32_t>(k));
+			break;
+		default:
+			break;
+		}
+	}
+
+	hits.assign(count, 0);
+	points.resize(count);
+	for (int type = 0; type < 3; ++type)
+	{
+		const size_t n = order[type].size();
+		if (n == 0)
+		{
+			continue;
+		}
+		hitMask.resize((n + 31) / 32);
+		hitPoints.resize(n);
+		size_t hitCount = 0;
+		if (type == 0)
+		{
+			hitCount = Collision::TestSphereSphereBatch(s, spheres, hitMask.data(), hitPoints.data());
+		}
+		else if (type == 1)
+		{
+			hitCount = Collision::TestSphereCapsuleBatch(s, capsules, hitMask.data(), hitPoints.data());
+		}
+		else
+		{
+			hitCount = Collision::TestSphereOBBBatch(s, obbs, hitMask.data(), hitPoints.data());
+		}
+		for (size_t i = 0; hitCount > 0 && i < n; ++i)
+		{
+			if (hitMask[i / 32] & (1u << (i % 32)))
+			{
+				hits[order[type][i]] = 1;
+				points[order[type][i]] = hitPoints[i];
+				--hitCount;
+			}
+		}
+	}
+}
+
+/*
+AN^[ƁAʂ̃XǧƂ̏Փ˂
+
+@param pA         Ώۂ̃AN^[
+@param getActorA  pAActorPtr擾֐(Փ˂ƂĂяo)
+@param b          ܂ރAN^[Xg
+@param candidates ̃CfbNX()
+@param count      ̐
+@param handler    Փ˂ꍇɎs֐
+
+茋ʂWorldContactCacheɋL^Aǂ̌`O񂩂قƂǓĂȂ
+ڍׂȔȗđǑʂg
+C[ƃ}XNőΏۊOɂȂ́AL^sȂ
+Ăgݍ킹͋L^ʂ̂܂܎g
+肵₪ApAȂ܂Ƃ߂Ĕ肷
+ՓˏpǍ`󂪕ςꍇAč͋L^ƔׂĕKvȂ1肵
+*/
+template<typename GetActor>
+void ResolveCandidates(Actor* pA, GetActor getActorA, ActorListBase& b,
+	const uint32_t* candidates, size_t count, const CollisionHandlerType& handler)
+{
+	const ActorStore& storeB = b.Store();
+	ContactCache& cache = b.GetWorld().Contacts();
+	const Collision::LayerMatrix& layers = b.GetWorld().Layers();
+	const bool isStaticB = b.IsStatic();
+	thread_local std::vector<ContactCache::Contact*> contacts;
+	thread_local std::vector<uint8_t> isAsleep;
+	thread_local std::vector<uint32_t> pending;
+	thread_local std::vector<uint32_t> pendingIndex;
+	thread_local std::vector<uint8_t> hits;
+	thread_local std::vector<glm::vec3> points;
+
+	// L^擾āA肵KvW߂
+	contacts.assign(count, nullptr);
+	isAsleep.assign(count, 0);
+	pending.clear();
+	pendingIndex.clear();
+	cache.Touch(pA);
+	for (size_t k = 0; k < count; ++k)
+	{
+		const uint32_t i = candidates[k];
+		if (storeB.health[i] <= 0 || !CanCollide(pA, storeB, i, layers))
+		{
+			continue;
+		}
+		const Actor* pB = storeB.actor[i];
+		if (!isStaticB)
+		{
+			cache.Touch(pB);
+		}
+		ContactCache::Contact& c = cache.Find(pA, pB);
+		c.isStaticB = isStaticB;
+		contacts[k] = &c;
+		isAsleep[k] = c.isValid && cache.IsSleeping(pA) && (isStaticB || cache.IsSleeping(pB));
+		if (!isAsleep[k] && !ContactCache::IsReusable(c, pA->colWorld, storeB.colWorld[i]))
+		{
+			pending.push_back(i);
+			pendingIndex.push_back(static_cast<uint32_t>(k));
+		}
+	}
+	if (pA->colWorld.type == Collision::Shape::Type::sphere && pending.size() >= batchThreshold)
+	{
+		const Collision::Sphere& s = pA->colWorld.s;
+		TestSphereCandidates(s, storeB, pending.data(), pending.size(), hits, points);
+		for (size_t n = 0; n < pending.size(); ++n)
+		{
+			ContactCache::Store(*contacts[pendingIndex[n]], pA->colWorld, storeB.colWorld[pending[n]],
+				hits[n] != 0, s.center, points[n]);
+		}
+	}
+
+	ActorPtr actorA; // Փ˂Ƃ擾
+	for (size_t k = 0; k < count && pA->health > 0; ++k)
+	{
+		const uint32_t i = candidates[k];
+		if (!contacts[k] || storeB.health[i] <= 0)
+		{
+			continue;
+		}
+
+		// ȌՓˏŉoꂽ肵Č`󂪕ςĂ画肵
+		ContactCache::Contact& c = *contacts[k];
+		if (!isAsleep[k] && !ContactCache::IsReusable(c, pA->colWorld, storeB.colWorld[i]))
+		{
+			glm::vec3 pa(0), pb(0);
+			const bool isHit = Collision::TestShapeShape(pA->colWorld, storeB.colWorld[i], &pa, &pb);
+			ContactCache::Store(c, pA->colWorld, storeB.colWorld[i], isHit, pa, pb);
+		}
+		if (!c.isHit)
+		{
+			continue;
+		}
+
+		// Փˏ̒œ|Ăꍇ̂Ŗ{̗̂̑͂mF
+		Actor* pB = storeB.actor[i];
+		if (pB->health <= 0)
+		{
+			continue;
+		}
+		if (!actorA)
+		{
+			actorA = getActorA();
+		}
+		const ActorPtr actorB = b.GetActor(i);
+		const glm::vec3 pa = c.pa;
+		const glm::vec3 pb = c.pb;
+		if (handler)
+		{
+			handler(actorA, actorB, pb);
+		}
+		else
+		{
+			actorA->OnHit(actorB, pb);
+			actorB->OnHit(actorA, pa);
+		}
+
+		// NĂAN^[ƐڐGAĂAChN
+		if (!isAsleep[k])
+		{
+			if (cache.IsSleeping(pA))
+			{
+				cache.Wake(pA);
+			}
+			if (!isStaticB && cache.IsSleeping(pB))
+			{
+				cache.Wake(pB);
+			}
+		}
+	}
+}
+
+/*
+AN^[AՓˑɍŏɐڐGʒu܂Ŗ߂(AՓ˔)
+
+@param pA Ώۂ̃AN^[
+@param b  Փˑ̃AN^[Xg
+
+@retval true  ڐGʒu܂Ŗ߂
+@retval false ߂Kv͂Ȃ
+
+1̍XVł̈ړ(prevPosition̈ړ)̔a𒴂AN^[́A
+ǂʂ蔲Ă܂Ƃ̂ŁAړ͈͂̑ŜŐڐG𒲂ׂ
+ړJn_ŊɏdȂĂ鑊́Aʏ̔ŉôőΏۂɂȂ
+C[ƃ}XNŏՓ˔̑ΏۊOɂȂĂ鑊͒ʂ蔲
+*/
+bool SweepToImpact(Actor* pA, const ActorListBase& b)
+{
+	if (pA->colWorld.type != Collision::Shape::Type::sphere)
+	{
+		return false;
+	}
+	const glm::vec3 move = pA->position - pA->prevPosition;
+	const Collision::Sphere end = pA->colWorld.s;
+	if (glm::dot(move, move) <= end.r * end.r)
+	{
+		return false;
+	}
+	const Collision::Sphere start{ end.center - move, end.r };
+
+	// ړJnƏI̋͂AABBŌi荞
+	Collision::AABB box;
+	box.min = glm::min(start.center, end.center) - glm::vec3(end.r);
+	box.max = glm::max(start.center, end.center) + glm::vec3(end.r);
+	thread_local std::vector<uint32_t> candidates;
+	candidates.clear();
+	b.QueryOverlap(box, candidates);
+
+	const ActorStore& storeB = b.Store();
+	const Collision::LayerMatrix& layers = b.GetWorld().Layers();
+	float tMin = 1;
+	for (const uint32_t i : candidates)
+	{
+		float t;
+		if (storeB.health[i] > 0 && CanCollide(pA, storeB, i, layers) &&
+			Collision::SweepSphereShape(start, move, storeB.colWorld[i], &t) && t > 0 && t < tMin)
+		{
+			tMin = t;
+		}
+	}
+	if (tMin >= 1)
+	{
+		return false;
+	}
+	const glm::vec3 back = move * (1 - tMin);
+	pA->position -= back;
+	pA->colWorld.s.center -= back;
+	return true;
+}
+
+} // unnamed namespace
+
+/*
+Փ˔s
+
+@param a       Ώۂ̃AN^[1
+@param b       Ώۂ̃AN^[2
+@param handler Փ˂ꍇɎs֐
+
+݂̃}XNɑ̃C[܂܂Ȃꍇ͔肵Ȃ
+(WorldɏȂ̂ŁAC[̑gݍ킹̕\͎gȂ)
+*/
+void DetectCollision(const ActorPtr& a, const ActorPtr& b, CollisionHandlerType handler)
+{
+	if (a->health <= 0 || b->health <= 0 ||
+		!Collision::TestLayerMask(a->collisionLayer, a->collisionMask, b->collisionLayer, b->collisionMask))
+	{
+		return;
+	}
+	glm::vec3 pa, pb;
+	if (Collision::TestShapeShape(a->colWorld, b->colWorld, &pa, &pb))
+	{
+		if (handler)
+		{
+			handler(a, b, pb);
+		}
+		else
+		{
+			a->OnHit(b, pb);
+			b->OnHit(a, pa);
+		}
+	}
+}
+
+/*
+Փ˔s
+
+@param a       Ώۂ̃AN^[
+@param b       Ώۂ̃AN^[Xg
+@param handler Փ˂ꍇɎs֐
+
+b̏Փˌ`Ƒ̗͂SoAǂݍ
+AABBdȂȂvf͏ڍׂȔȗ(bȂXgȂBVHōi荞)
+C[ƃ}XNAbWorld̃C[̑gݍ킹̕\őΏۊOɂȂvf͔肵Ȃ
+O񂩂瓮ĂȂgݍ킹bWorldContactCacheɋL^ʂg
+aȂA肵SIMD߂ł܂Ƃ߂Ĕ肷
+äړʂa𒴂Ăꍇ́AɐڐGʒu܂Ŗ߂Ă画肷
+*/
+void DetectCollision(const ActorPtr& a, ActorListBase& b, CollisionHandlerType handler)
+{
+	if (a->health <= 0 || IsCollisionDisabled(a.get()))
+	{
+		return;
+	}
+	SweepToImpact(a.get(), b);
+	thread_local std::vector<uint32_t> candidates;
+	candidates.clear();
+	b.QueryOverlap(Collision::CalcAABB(a->colWorld), candidates);
+	ResolveCandidates(a.get(), [&a]() { return a; }, b,
+		candidates.data(), candidates.size(), handler);
+}
+
+/*
+Փ˔s
+
+@param a       Ώۂ̃AN^[Xg1
+@param b       Ώۂ̃AN^[Xg2
+@param handler Փ˂ꍇɎs֐
+
+Փˌ`Ƒ̗͂SoAǂݍ
+u[htF[YAABBdȂgݍ킹IсȂgݍ킹ڍׂɔ肷
+bȂXgȂbBVHAłȂ΃XC[vEAhEv[g
+gݍ킹́AڍׂȔ̑OɃC[ƃ}XNōi荞
+Փˏ͑Ɠ(ãCfbNXAa̒łb̃CfbNX)ōs
+
+AABB͌Ăяo_̏Փˌ`󂩂vẐŁAՓˏŉoꂽAN^[
+VɏdȂ͎̔ŏ
+ړʂa𒴂ĂãAN^[́AAABBvZOɐڐGʒu܂Ŗ߂
+ڍׂȔ̌ʂbWorldContactCacheɋL^Ãt[ōėp
+*/
+void DetectCollision(ActorListBase& a, ActorListBase& b, CollisionHandlerType handler)
+{
+	PROFILE_SCOPE("DetectCollision");
+	const ActorStore& storeA = a.Store();
+	const ActorStore& storeB = b.Store();
+
+	// Ɨpz(ĂяoƂɊmۂȂ悤ɃXbhƂɎ)
+	thread_local std::vector<Collision::AABB> aabbA;
+	thread_local std::vector<Collision::AABB> aabbB;
+	thread_local std::vector<Collision::Pair> pairs;
+
+	// ̗͂̂ȂAN^[ƁAƂՓ˂ȂAN^[͋AABBɂău[htF[YO
+	// (폜\ς݂̃AN^[SoȂ̗͂0ɂȂĂ)
+	const Collision::AABB empty = Collision::CalcAABB(Collision::Shape());
+	aabbA.resize(storeA.Size());
+	for (size_t j = 0; j < storeA.Size(); ++j)
+	{
+		Actor* pA = storeA.actor[j];
+		if (storeA.health[j] > 0 && !IsCollisionDisabled(pA))
+		{
+			SweepToImpact(pA, b);
+			aabbA[j] = Collision::CalcAABB(pA->colWorld);
+		}
+		else
+		{
+			aabbA[j] = empty;
+		}
+	}
+	if (b.StaticTree())
+	{
+		PROFILE_SCOPE("StaticBVH::QueryOverlap");
+		thread_local std::vector<uint32_t> found;
+		pairs.clear();
+		for (size_t j = 0; j < aabbA.size(); ++j)
+		{
+			found.clear();
+			b.QueryOverlap(aabbA[j], found);
+			for (const uint32_t i : found)
+			{
+				pairs.push_back({ static_cast<uint32_t>(j), i });
+			}
+		}
+	}
+	else
+	{
+		PROFILE_SCOPE("SweepAndPrune");
+		aabbB.resize(storeB.Size());
+		for (size_t i = 0; i < storeB.Size(); ++i)
+		{
+			aabbB[i] = storeB.health[i] > 0 && storeB.layer[i] != 0 && storeB.mask[i] != 0 ?
+				Collision::CalcAABB(storeB.colWorld[i]) : empty;
+		}
+		Collision::SweepAndPrune(aabbA, aabbB, pairs);
+	}
+
+	// ãAN^[ƂɌ܂Ƃ߂ďڍׂȔs
+	thread_local std::vector<uint32_t> candidates;
+	for (size_t first = 0; first < pairs.size();)
+	{
+		const uint32_t j = pairs[first].a;
+		candidates.clear();
+		size_t last = first;
+		for (; last < pairs.size() && pairs[last].a == j; ++last)
+		{
+			candidates.push_back(pairs[last].b);
+		}
+		first = last;
+
+		// Փˏ̒œ|Ăꍇ̂Ŗ{̗̂̑͂mF
+		Actor* pA = storeA.actor[j];
+		if (storeA.health[j] <= 0 || pA->health <= 0)
+		{
+			continue;
+		}
+		ResolveCandidates(pA, [&a, j]() { return a.GetActor(j); }, b,
+			candidates.data(), candidates.size(), handler);
+	}
+}
@@ -6,16 +6,29 @@
 #include <GL/glew.h>
 #include "Mesh.h"
 #include "Collision.h"
+#include "ActorPool.h"
+#include "World.h"
+#include "StaticBVH.h"
 #include <glm/glm.hpp>
 #include <vector>
 #include <memory>
 #include <functional>
+#include <unordered_map>
+#include <typeinfo>
+#include <type_traits>
+#include <stdint.h>
 
 class Actor;
+class ActorListBase;
 using ActorPtr = std::shared_ptr<Actor>;
 
 /*
 V[ɔzuIuWFNg
+
+Update()ƎɎĂȂAN^[́AActorListSoAňʒuƏՓˌ`܂Ƃ߂čXVA
+AN^[{̂̒l͕ύXʒmꂽꍇ荞
+XgɒǉƂňʒu̗͂ȂǂύXƂ́ASetPosition()Ȃǂ̊֐gA
+o[𒼐ڏƂMarkChanged()Ăяo
 */
 class Actor
 {
@@ -31,18 +44,64 @@ public:
 	virtual void Draw();
 	virtual void OnHit(const ActorPtr&, const glm::vec3&){}
 
+	// Œ莞ԃXebvōXVƂA`p̎pO̍XVʂԂ
+	void SaveTransform();
+	void Interpolate(float alpha);
+
+	// lύXƂo^̃Xgɒʒm
+	void MarkChanged();
+
 public:
 	std::string name; // AN^[̖O
 	glm::vec3 position = glm::vec3(0); //ʒu
 	glm::vec3 rotation = glm::vec3(0); //]
 	glm::vec3 scale = glm::vec3(1); //傫
 	glm::vec3 velocity = glm::vec3(0); // x
+	glm::vec3 prevPosition = glm::vec3(0); // O̍XVJn̈ʒu
+	glm::vec3 prevRotation = glm::vec3(0); // O̍XVJn̉]
+	glm::mat4 matModel = glm::mat4(1); // `Ɏgfs(Interpolate()ŌvZ)
 	int health = 0; // ̗
 	Collision::Shape colLocal; // [JWn̏Փˌ`
 	Collision::Shape colWorld; // [hWn̏Փˌ`
+	Collision::LayerMask collisionLayer = Collision::ToMask(Collision::Layer::defaultLayer); // 郌C[
+	Collision::LayerMask collisionMask = Collision::allLayers; // Փ˔s̃C[
+
+	void SetCollisionLayer(Collision::Layer layer, Collision::LayerMask mask = Collision::allLayers)
+	{
+		collisionLayer = Collision::ToMask(layer);
+		collisionMask = mask;
+		MarkChanged();
+	}
+	void SetPosition(const glm::vec3& v) { position = v; MarkChanged(); }
+	void SetRotation(const glm::vec3& v) { rotation = v; MarkChanged(); }
+	void SetScale(const glm::vec3& v) { scale = v; MarkChanged(); }
+	void SetVelocity(const glm::vec3& v) { velocity = v; MarkChanged(); }
+	void SetHealth(int hp) { health = hp; MarkChanged(); }
+
+private:
+	friend class ActorListBase;
+	std::vector<ActorListBase*> ownerLists; // o^Ă郊Xg(MarkChanged()Œʒm)
 };
 using ActorPtr = std::shared_ptr<Actor>;
 
+/*
+AN^[Update()ƎɎĂ邩ׂ
+
+@param actor ׂAN^[
+
+@retval true  Update()ƎɎĂ邩AĂ邩ǂȂ
+@retval false Actor::Update()̂܂܎gĂ
+
+^TUpdate()錾ĂȂ΁A&T::UpdateActor̃o[֐|C^ɂȂ
+ۂ̌^T̔hNX̏ꍇ́AUpdate()Ă邩Ȃ̂trueԂ
+*/
+template<typename T>
+bool HasOwnUpdate(const T& actor)
+{
+	return !std::is_same<decltype(&T::Update), void (Actor::*)(float)>::value ||
+		typeid(actor) != typeid(T);
+}
+
 class StaticMeshActor : public Actor
 {
 public:
@@ -68,22 +127,181 @@ private:
 };
 using StaticMeshActorPtr = std::shared_ptr<StaticMeshActor>;
 
-class ActorList
+/*
+AN^[̏Ԃ\̔z(SoA)ŕێNX
+
+ʒuAxA]Ag嗦Aϋv́AՓˌ`ނƂ̘Azɂ܂Ƃ߁A
+t[̍XVՓ˔ŃAN^[{̂ǂ炸ɍςނ悤ɂ
+AN^[{̂̒l荞ނ̂́AUpdate()ƎɎĂAN^[ƁA
+MarkChanged()ŕύXʒmꂽAN^[
+colLocalAdd()̎_̒lĝŁAǉɕύXȂ
+*/
+class ActorStore
 {
 public:
-	//Ce[^[`
-	using iterator = std::vector<ActorPtr>::iterator;
-	using const_iterator = std::vector<ActorPtr>::const_iterator;
-	ActorList() = default;
-	~ActorList() = default;
+	ActorStore() = default;
+	~ActorStore() = default;
 
 	void Reserve(size_t);
-	void Add(const ActorPtr&);
-	bool Remove(const ActorPtr&);
+	void Add(Actor*, bool hasOwnUpdate);
+	void Move(size_t from, size_t to);
+	void Resize(size_t);
+	size_t Size() const { return actor.size(); }
+
+	// [begin, end)͈̔͂(͈͂dȂȂΕɌĂяo)
+	void Sync(size_t begin, size_t end);
+	void Integrate(float, size_t begin, size_t end);
+	void UpdateColWorld(size_t begin, size_t end);
+	void WriteBack(size_t begin, size_t end);
+
+public:
+	std::vector<Actor*> actor;               // ΉAN^[
+	std::vector<glm::vec3> position;         // ʒu
+	std::vector<glm::vec3> velocity;         // x
+	std::vector<glm::vec3> rotation;         // ]
+	std::vector<glm::vec3> scale;            // 傫
+	std::vector<int> health;                 // ̗
+	std::vector<Collision::Shape> colLocal;  // [JWn̏Փˌ`
+	std::vector<Collision::Shape> colWorld;  // [hWn̏Փˌ`
+	std::vector<Collision::AABB> bounds;     // colWorld͂AABB(colWorldƓɍXV)
+	std::vector<Collision::LayerMask> layer; // 郌C[
+	std::vector<Collision::LayerMask> mask;  // Փ˔s̃C[
+	std::vector<uint8_t> ownUpdate;          // 1ȂAN^[gʒuXV
+	std::vector<uint8_t> changed;            // 1ȂAN^[{̂̒l̎荞݂Kv
+	std::vector<uint8_t> dirty;              // 1ȂcolWorld̍ČvZKv
+};
+
+/*
+AN^[Xǧ^ɈˑȂ
+
+AN^[̏(SoA)ƁAԃCfbNXւ̓o^Ǘ
+ԃCfbNXWorldw肷Ƒ̃XgƋLA
+w肵Ȃ΃Xgp̂̂
+
+AN^[̍폜͗\񂾂sAFlush()ł܂Ƃ߂Ĕzl߂
+\񂳂ꂽAN^[͕`Փ˔AߖT̑Ώۂ璼ɊO
+
+SetStatic(true)ɂXg͏Փˌ`󂩂狫E{[Kw(BVH)A
+Փ˔Փˌ`̌ɎgBBVH͒ǉE폜΍蒼A
+Փˌ`󂪓ꍇ͌`ۂ܂ܔ͈͂XV
+*/
+class ActorListBase
+{
+public:
+	ActorListBase(float cellSize, const glm::vec2& boundsMin, const glm::vec2& boundsMax);
+	explicit ActorListBase(World& world);
+	virtual ~ActorListBase();
+	ActorListBase(const ActorListBase&) = delete;
+	ActorListBase& operator=(const ActorListBase&) = delete;
+
 	void Update(float);
-	void UpdateDrawData(float);
+	void SaveTransform();
+	void UpdateDrawData(float, float alpha = 1.0f);
 	void Draw();
-	bool Empty() const { return actors.empty(); }
+	void Flush();
+	size_t Size() const { return store.Size(); }
+	bool Empty() const { return store.Size() == 0; }
+
+	// trueȂ폜Ɏc̃AN^[̏Ԃۂ(`揇dvȃXgp)
+	// falseȂ疖̃AN^[󂢂ʒuɈڂċl߂
+	void KeepOrder(bool b) { keepOrder = b; }
+
+	// ^킸ɃAN^[擾֐
+	virtual ActorPtr GetActor(size_t) const = 0;
+
+	// SoA擾֐
+	const ActorStore& Store() const { return store; }
+
+	// ԃCfbNX擾֐
+	World& GetWorld() const { return *world; }
+
+	// ȂAN^[̃XgƂBVHg
+	void SetStatic(bool);
+	bool IsStatic() const { return isStatic; }
+	void BuildStaticTree();
+	const StaticBVH* StaticTree() const;
+
+	// Փˌ`̌(BVHgȂꍇ͑Svf𒲂ׂ)
+	void QueryOverlap(const Collision::AABB& box, std::vector<uint32_t>& result) const;
+	bool FindClosest(const glm::vec3& p, float maxDistance,
+		size_t* index, glm::vec3* closest) const;
+	bool Raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+		size_t* index, float* t, const Actor* ignore = nullptr,
+		Collision::LayerMask layerMask = Collision::allLayers) const;
+	void QueryRay(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+		std::vector<uint32_t>& result) const;
+
+protected:
+	void ReserveBase(size_t);
+	bool AddBase(Actor*, bool hasOwnUpdate);
+	bool RemoveBase(const Actor*);
+	void ReleaseOwners();
+	void FindNearbyIndices(const glm::vec3& pos, float maxDistance,
+		std::vector<uint32_t>& result, Collision::LayerMask layerMask) const;
+
+	// hNXێAN^[z𑀍삷
+	virtual void MoveActor(size_t from, size_t to) = 0;
+	virtual void ResizeActors(size_t) = 0;
+
+private:
+	friend class Actor;
+	void MarkChanged(const Actor*);
+	void RemoveOwner(Actor*);
+	void MarkRemoved(size_t);
+	void MoveEntry(size_t from, size_t to);
+	void MoveInWorld();
+
+	static const uint32_t invalidId = 0xffffffff;
+	static const size_t updateGrainSize = 16; // z֐Ăԏ1Wu󂯎AN^[
+	static const size_t storeGrainSize = 256; // SoA1Wu󂯎AN^[
+	static const size_t linearQueryLimit = 32; // AN^[ȉȂԃCfbNXg킸Ɍ
+
+	std::unique_ptr<World> ownWorld; // Worldw肳Ȃꍇ̐pCfbNX
+	World* world = nullptr;          // o^̋ԃCfbNX
+	ActorStore store;                // AN^[ƓԂŃAN^[̏Ԃێ
+	std::vector<uint32_t> worldIds;  // AN^[ƓԂworld̗vfIDێ
+	std::vector<uint8_t> removed;    // AN^[ƓԂŁA1Ȃ폜\ς
+	size_t removedCount = 0;         // 폜\ς݂̃AN^[
+	float maxReach = 0;              // ʒuՓˌ`AABB̊p܂ł̋̍ől
+	std::unordered_map<const Actor*, uint32_t> indexMap; // AN^[z̃CfbNX\B
+	bool keepOrder = false;          // trueȂ폜ɏԂۂ
+	bool isStatic = false;           // trueȂBVHg
+	bool isStaticTreeDirty = false;  // trueȂBVH̍蒼Kv
+	StaticBVH staticTree;            // Փˌ`BVH(storeƓCfbNXg)
+};
+
+/*
+^w肵AN^[Xg
+
+ێ^̂܂܃Ce[^[ߖTŎôŁA
+dynamic_pointer_castŌ^𒲂ׂKvȂ
+*/
+template<typename T>
+class TypedActorList : public ActorListBase
+{
+public:
+	using ActorTypePtr = std::shared_ptr<T>;
+
+	//Ce[^[`
+	using iterator = typename std::vector<ActorTypePtr>::iterator;
+	using const_iterator = typename std::vector<ActorTypePtr>::const_iterator;
+	explicit TypedActorList(float cellSize = 10.0f,
+		const glm::vec2& boundsMin = glm::vec2(0),
+		const glm::vec2& boundsMax = glm::vec2(200))
+		: ActorListBase(cellSize, boundsMin, boundsMax) {}
+	explicit TypedActorList(World& world) : ActorListBase(world) {}
+	virtual ~TypedActorList() { ReleaseOwners(); }
+
+	void Reserve(size_t);
+	template<typename U>
+	void Add(const std::shared_ptr<U>&);
+	bool Remove(const ActorTypePtr&);
+
+	// v[̃nhŒǉE폜֐
+	template<typename U>
+	void Add(const ActorPool<U>& pool, ActorHandle h) { Add(ActorTypePtr(pool.GetPtr(h))); }
+	template<typename U>
+	bool Remove(const ActorPool<U>& pool, ActorHandle h) { return Remove(ActorTypePtr(pool.GetPtr(h))); }
 
 	// Ce[^[擾֐
 	iterator begin() { return actors.begin(); }
@@ -91,28 +309,104 @@ public:
 	const_iterator begin() const { return actors.begin(); }
 	const_iterator end() const { return actors.end(); }
 
-	std::vector<ActorPtr> FindNearbyActors(const glm::vec3& pos, float maxDistance) const;
+	std::vector<ActorTypePtr> FindNearbyActors(const glm::vec3& pos, float maxDistance,
+		Collision::LayerMask layerMask = Collision::allLayers) const;
+
+	virtual ActorPtr GetActor(size_t i) const override { return actors[i]; }
 
+protected:
+	virtual void MoveActor(size_t from, size_t to) override { actors[to] = std::move(actors[from]); }
+	virtual void ResizeActors(size_t n) override { actors.resize(n); }
 
 private:
 	//std::vectorŕێāAێĂ邷ׂẴAN^[ɑ΂ē̑s
-	std::vector<ActorPtr> actors;
-
-	static const int mapGridSizeX = 10;
-	static const int mapGridSizeY = 10;
-	static const int sepalationSizeX = 20;
-	static const int sepalationSizeY = 20;
-	std::vector<ActorPtr> grid[sepalationSizeY][sepalationSizeX];
-	glm::ivec2 CalcMapIndex(const glm::vec3& pos) const;
+	std::vector<ActorTypePtr> actors;
 };
+using ActorList = TypedActorList<Actor>;
+
+/*
+i[\ȃAN^[mۂ
+
+@param reserveCount AN^[z̊mې
+*/
+template<typename T>
+void TypedActorList<T>::Reserve(size_t reserveCount)
+{
+	actors.reserve(reserveCount);
+	ReserveBase(reserveCount);
+}
+
+/*
+AN^[ǉ
+
+@param actor ǉAN^[
+
+ɒǉĂAN^[͒ǉȂ
+Update()ƎɎĂ邩ǂ́Aactoř^画肷
+*/
+template<typename T>
+template<typename U>
+void TypedActorList<T>::Add(const std::shared_ptr<U>& actor)
+{
+	if (!actor)
+	{
+		return;
+	}
+	if (AddBase(actor.get(), HasOwnUpdate(*actor)))
+	{
+		actors.push_back(actor);
+	}
+}
+
+/*
+AN^[̍폜\񂷂
+
+@param actor 폜AN^[
+
+@retval true  폜\񂵂
+@retval false actor͂̃XgɂȂ
+
+z񂩂Flush()(Update()̒ŌĂ΂)Ŏ菜
+*/
+template<typename T>
+bool TypedActorList<T>::Remove(const ActorTypePtr& actor)
+{
+	return RemoveBase(actor.get());
+}
+
+/*
+w肳ꂽW̋ߖTɂAN^[̃Xg擾
+
+@param pos         ̊_ƂȂW
+@param maxDistance ߖTƂ݂Ȃő勗()
+@param layerMask   Ώۂ̃C[
+
+@return Actor::positionpos甼amaxDistanceȓɂAN^[̔z
+*/
+template<typename T>
+std::vector<typename TypedActorList<T>::ActorTypePtr> TypedActorList<T>::FindNearbyActors(
+	const glm::vec3& pos, float maxDistance, Collision::LayerMask layerMask) const
+{
+	std::vector<uint32_t> indices;
+	indices.reserve(100);
+	FindNearbyIndices(pos, maxDistance, indices, layerMask);
+
+	std::vector<ActorTypePtr> result;
+	result.reserve(indices.size());
+	for (uint32_t i : indices)
+	{
+		result.push_back(actors[i]);
+	}
+	return result;
+}
 
 using CollisionHandlerType = 
 	std::function<void(const ActorPtr&, const ActorPtr&, const glm::vec3&)>;
 void DetectCollision(const ActorPtr& a, const ActorPtr& b,
 	CollisionHandlerType handler = nullptr);
-void DetectCollision(const ActorPtr& a, ActorList& b,
+void DetectCollision(const ActorPtr& a, ActorListBase& b,
 	CollisionHandlerType handler = nullptr);
-void DetectCollision(ActorList& a, ActorList& b,
+void DetectCollision(ActorListBase& a, ActorListBase& b,
 	CollisionHandlerType handler = nullptr);
 
 #endif // !ACTOR_H_INCLUDED
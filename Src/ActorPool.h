@@ -0,0 +1,237 @@
+/*
+@file ActorPool.h
+*/
+#ifndef ACTORPOOL_H_INCLUDED
+#define ACTORPOOL_H_INCLUDED
+#include <vector>
+#include <memory>
+#include <new>
+#include <utility>
+#include <stdint.h>
+
+/*
+v[ɊmۂAN^[ʂnh
+
+XbgԍƐԍ̑gŁAjꂽXbgėpĂ
+Ânh͎擾łȂ悤ɂ
+*/
+struct ActorHandle
+{
+	static const uint32_t invalidIndex = 0xffffffff;
+
+	uint32_t index = invalidIndex; // Xbgԍ
+	uint32_t generation = 0;       // ԍ(0͖)
+
+	bool IsNull() const { return generation == 0; }
+	explicit operator bool() const { return !IsNull(); }
+	bool operator==(const ActorHandle& h) const
+	{
+		return index == h.index && generation == h.generation;
+	}
+	bool operator!=(const ActorHandle& h) const { return !(*this == h); }
+};
+
+/*
+AN^[܂Ƃ߂Ċmۂv[
+
+Xbg̓`NPʂŊmۂAxmۂAhX͓Ȃ
+jXbg̓t[Xgɖ߂ĎCreate()ōėp̂ŁA
+eʂ͈͓̔ŐƔjJԂĂq[vmۂ͔Ȃ
+
+GetPtr()Ԃ|C^͎QƃJEgȂ(Rs[Ăq삪NȂ)
+̓v[Ǘ̂ŁADestroy()ɎgȂ
+*/
+template<typename T>
+class ActorPool
+{
+public:
+	explicit ActorPool(size_t chunkSize = 32) : chunkSize(chunkSize > 0 ? chunkSize : 1) {}
+	~ActorPool() { Clear(); }
+	ActorPool(const ActorPool&) = delete;
+	ActorPool& operator=(const ActorPool&) = delete;
+
+	void Reserve(size_t);
+	template<typename... Args>
+	ActorHandle Create(Args&&... args);
+	bool Destroy(ActorHandle);
+	void Clear();
+
+	T* Get(ActorHandle) const;
+	std::shared_ptr<T> GetPtr(ActorHandle) const;
+	bool IsValid(ActorHandle h) const { return Get(h) != nullptr; }
+	size_t Size() const { return liveCount; }
+	size_t Capacity() const { return chunks.size() * chunkSize; }
+
+private:
+	struct Slot
+	{
+		alignas(T) unsigned char storage[sizeof(T)];
+		uint32_t generation = 1; // Ɋ蓖Ănh̐ԍ
+		bool used = false;       // trueȂstorageɃAN^[Ă
+	};
+
+	Slot& At(uint32_t i) const { return chunks[i / chunkSize][i % chunkSize]; }
+	static T* Object(Slot& s) { return reinterpret_cast<T*>(s.storage); }
+
+	size_t chunkSize;                             // 1`ÑXbg
+	std::vector<std::unique_ptr<Slot[]>> chunks;  // Xbg̎
+	std::vector<uint32_t> freeList;               // gpXbg̔ԍ
+	size_t liveCount = 0;                         // ς݂̃AN^[
+};
+
+/*
+Xbgmۂ
+
+@param reserveCount mۂXbg
+
+Ɋmۍς݂̃Xbg͈ړȂ
+*/
+template<typename T>
+void ActorPool<T>::Reserve(size_t reserveCount)
+{
+	if (reserveCount <= Capacity())
+	{
+		return;
+	}
+	const size_t chunkCount = (reserveCount + chunkSize - 1) / chunkSize;
+	const size_t oldCapacity = Capacity();
+	chunks.reserve(chunkCount);
+	while (chunks.size() < chunkCount)
+	{
+		chunks.emplace_back(new Slot[chunkSize]);
+	}
+
+	// ԍ̏Xbgg悤ɁA傫ԍς
+	// Destroy()push_backĂĊmۂNȂ悤AeʕmۂĂ
+	freeList.reserve(Capacity());
+	for (size_t i = Capacity(); i > oldCapacity; --i)
+	{
+		freeList.push_back(static_cast<uint32_t>(i - 1));
+	}
+}
+
+/*
+AN^[𐶐
+
+@param args AN^[̃RXgN^
+
+@return AN^[̃nh
+*/
+template<typename T>
+template<typename... Args>
+ActorHandle ActorPool<T>::Create(Args&&... args)
+{
+	if (freeList.empty())
+	{
+		Reserve(Capacity() + chunkSize);
+	}
+	const uint32_t index = freeList.back();
+	freeList.pop_back();
+
+	Slot& s = At(index);
+	new(s.storage) T(std::forward<Args>(args)...);
+	s.used = true;
+	++liveCount;
+
+	ActorHandle h;
+	h.index = index;
+	h.generation = s.generation;
+	return h;
+}
+
+/*
+AN^[j
+
+@param h jAN^[̃nh
+
+@retval true  j
+@retval false nh
+*/
+template<typename T>
+bool ActorPool<T>::Destroy(ActorHandle h)
+{
+	if (!IsValid(h))
+	{
+		return false;
+	}
+	Slot& s = At(h.index);
+	Object(s)->~T();
+	s.used = false;
+
+	// i߂ČÂnh𖳌ɂ(0͖lȂ̂Ŕ΂)
+	if (++s.generation == 0)
+	{
+		s.generation = 1;
+	}
+	freeList.push_back(h.index);
+	--liveCount;
+	return true;
+}
+
+/*
+ׂẴAN^[j
+
+Xbg͉Aȍ~Create()ōėp
+*/
+template<typename T>
+void ActorPool<T>::Clear()
+{
+	for (size_t i = 0; i < Capacity() && liveCount > 0; ++i)
+	{
+		Slot& s = At(static_cast<uint32_t>(i));
+		if (s.used)
+		{
+			ActorHandle h;
+			h.index = static_cast<uint32_t>(i);
+			h.generation = s.generation;
+			Destroy(h);
+		}
+	}
+}
+
+/*
+AN^[擾
+
+@param h AN^[̃nh
+
+@return hɑΉAN^[
+        hȏꍇnullptr
+*/
+template<typename T>
+T* ActorPool<T>::Get(ActorHandle h) const
+{
+	if (h.IsNull() || h.index >= Capacity())
+	{
+		return nullptr;
+	}
+	Slot& s = At(h.index);
+	if (!s.used || s.generation != h.generation)
+	{
+		return nullptr;
+	}
+	return Object(s);
+}
+
+/*
+QƃJEgȂ|C^擾
+
+@param h AN^[̃nh
+
+@return hɑΉAN^[w|C^
+        hȏꍇnullptr
+
+shared_ptrL҂ɂʖRXgN^ō̂ŁA
+Rs[jŎQƃJEg̑삪Ȃ
+*/
+template<typename T>
+std::shared_ptr<T> ActorPool<T>::GetPtr(ActorHandle h) const
+{
+	T* p = Get(h);
+	if (!p)
+	{
+		return nullptr;
+	}
+	return std::shared_ptr<T>(std::shared_ptr<T>(), p);
+}
+
+#endif // !ACTORPOOL_H_INCLUDED
@@ -1,145 +1,748 @@
-#include"Astar.h"
-#include<stdio.h>
+/*
+@file Astar.cpp
+*/
+#include "Astar.h"
+#include "NavGrid.h"
+#include "JumpPointMap.h"
+#include <algorithm>
+#include <limits.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+namespace /* unnamed */ {
 
-#define ARRAY_NUM(a) (sizeof(a)/sizeof(a[0]))
-#define NODE_MAX 1000
+const float diagonalCost = 1.41421356f; // ΂߂ɈړRXg
 
 /*
-̃m[h쐬
+ׂ̊iqւ̈ړ
+
+0`3͏cA4`7͎΂߁B΂߂̈ړɂaAb̏cʂKv
 */
-Astar::NODE *Astar::CreateNode(int x, int z, int cost)
+const struct
 {
-	static Astar::NODE n[NODE_MAX];
-	static int index = 0;
-	n[index].x = x;
-	n[index].z = z;
-	n[index].cost = cost;
-	return &n[index++];
+	int dx;
+	int dz;
+	int a;
+	int b;
+} neighbors[8] = {
+	{ -1, 0, -1, -1 }, { 1, 0, -1, -1 }, { 0, -1, -1, -1 }, { 0, 1, -1, -1 },
+	{ -1, -1, 0, 2 }, { 1, -1, 1, 2 }, { -1, 1, 0, 3 }, { 1, 1, 1, 3 },
+};
+
+/*
+xNg̊evf-1A0A1̂ꂩɂ
+*/
+glm::ivec2 StepDirection(const glm::ivec2& v)
+{
+	return glm::ivec2((v.x > 0) - (v.x < 0), (v.y > 0) - (v.y < 0));
+}
+
+} // unnamed namespace
+
+/*
+T͈͂ݒ肷
+
+@param areaMin T͈͂̍ŏW
+@param areaMax T͈͂̍őW(̍W͈͂Ɋ܂)
+
+͈͂̑傫ςꍇƗ̈mۂ
+*/
+void Astar::SetArea(const glm::ivec2& areaMin, const glm::ivec2& areaMax)
+{
+	this->areaMin = areaMin;
+	const glm::ivec2 size = glm::max(areaMax - areaMin + 1, glm::ivec2(0));
+	if (size != areaSize)
+	{
+		areaSize = size;
+		nodes.assign(static_cast<size_t>(size.x) * size.y, Node());
+		generation = 0;
+	}
 }
 
 /*
-X^[gm[hn܂ł̍ŏRXgԂ
+oHT
+
+@param start      X^[gn_̊iq
+@param goal       S[n_̊iq
+@param isWalkable iqʂ邩ǂԂ֐
+@param path       oH̊i[(X^[gS[܂ł̊iqɊi[)
+
+@retval true  oH
+@retval false X^[gS[T͈͊OA܂͌oH݂Ȃ
+
+X^[gƃS[̊iq́AisWalkablěʂɂ炸ʂ̂ƂĈ
+ړRXg͑SēȂ̂ŁAJPSLȂJPSŒT
+isWalkabléAA*łׂ͒iqƂ1񂾂AJPSł͓iqɂĉxĂяo
 */
-int Astar::G(NODE *s, NODE *n)
+bool Astar::FindPath(const glm::ivec2& start, const glm::ivec2& goal,
+	const WalkableFunc& isWalkable, std::vector<glm::ivec2>& path)
 {
-	return n->cost;
+	method = SelectMethod(start, goal, nullptr);
+	return Search(start, goal, [&isWalkable](int x, int z) {
+		return static_cast<uint8_t>(isWalkable(x, z) ? NavGrid::flatCost : NavGrid::blockedCost);
+	}, path);
 }
 
 /*
-S[m[hn܂ł̍ŏRXgԂ
+irQ[ViqgČoHT
+
+@param start X^[gn_̊iq
+@param goal  S[n_̊iq
+@param grid  iqƂ̈ړRXg
+@param path  oH̊i[(X^[gS[܂ł̊iqɊi[)
+
+@retval true  oH
+@retval false X^[gS[T͈͊OA܂͌oH݂Ȃ
+
+X^[gƃS[̊iq́AgridŒʂȂiqłʂ̂ƂĈ
 */
-int Astar::H(NODE *e, NODE *n)
+bool Astar::FindPath(const glm::ivec2& start, const glm::ivec2& goal,
+	const NavGrid& grid, std::vector<glm::ivec2>& path)
 {
-	return 0;
+	method = SelectMethod(start, goal, &grid);
+	return Search(start, goal, [&grid](int x, int z) { return grid.Cost(x, z); }, path);
 }
 
 /*
-*m[h𒲂ׂ
-*
-*@param open    vZ̃m[hi[Ă߂̃I[vXg
-*@param close    vZς݂̃m[hi[邽߂̃N[YXg
-*@param s    X^[gm[h
-*@param e    S[m[h
-*@param n    ݂̃m[h
-*@param m    ñm[hɗאڂĂm[h
+irQ[ViqgTJn
+
+@param start X^[gn_̊iq
+@param goal  S[n_̊iq
+@param grid  iqƂ̈ړRXg
+
+@return T̏ԁBsearchingȂStep()ŒTi߂
+
+grid͒TI܂Ő邱
+T̓rgridꂽꍇA׏Iiqɂ͏ÕRXgg
 */
-void Astar::SearchNode(LIST *open, LIST *close, NODE *s,
-	NODE *e, NODE *n, NODE *m)
+Astar::SearchState Astar::BeginSearch(const glm::ivec2& start, const glm::ivec2& goal, const NavGrid& grid)
 {
-	int inOpen = -1; // openXgp̃`FbNϐ
-	int inClose = -1; // closeXgp̃`FbNϐ
-	int i; // forp̕ϐ
-	// G + H + (nm܂ňړRXg)
-	int fdmCost = G(s, n) + H(e, m) + 1;
-	// G + H
-	int fsmCost = G(s, m) + H(e, m);
+	this->grid = &grid;
+	method = SelectMethod(start, goal, &grid);
+	return Begin(start, goal, [&grid](int x, int z) { return grid.Cost(x, z); });
+}
+
+/*
+Ti߂
 
-	// mopenXgɊ܂܂Ă邩
-	for (i = 0; i < open->index; i++)
+@param maxExpansions N[YXgɈڂm[h̍ő吔
+
+@return T̏ԁBsearchingȂAxStep()ĂяoĒT𑱂
+*/
+Astar::SearchState Astar::Step(size_t maxExpansions)
+{
+	if (searchState != SearchState::searching || !grid)
 	{
-		if (open->node[i] != NULL &&
-			m->x == open->node[i]->x &&
-			m->z == open->node[i]->z)
+		return searchState;
+	}
+	const NavGrid& g = *grid;
+	return Expand([&g](int x, int z) { return g.Cost(x, z); }, maxExpansions);
+}
+
+/*
+oH擾
+
+@param path oH̊i[(X^[gS[܂ł̊iqɊi[)
+            oHĂȂ΋ɂȂ
+
+JPS̏ꍇAWv|Cg̊Ԃ͏c΂߂̒Ȃ̂ŁAr̊iqĊi[
+*/
+void Astar::GetPath(std::vector<glm::ivec2>& path) const
+{
+	path.clear();
+	if (searchState != SearchState::found)
+	{
+		return;
+	}
+	for (uint32_t i = goalIndex; ; i = nodes[i].parent)
+	{
+		const glm::ivec2 cell = ToCell(i);
+		path.push_back(cell);
+		if (i == startIndex)
 		{
-			inOpen = i;
 			break;
 		}
+		const glm::ivec2 parent = ToCell(nodes[i].parent);
+		const glm::ivec2 step = StepDirection(parent - cell);
+		for (glm::ivec2 p = cell + step; p != parent; p += step)
+		{
+			path.push_back(p);
+		}
 	}
+	std::reverse(path.begin(), path.end());
+}
 
-	// mcloseXgɊ܂܂Ă邩
-	for (i = 0; i < close->index; i++)
+/*
+oHT
+
+@param start    X^[gn_̊iq
+@param goal     S[n_̊iq
+@param cellCost iq̈ړRXgԂ֐(0ȂʂȂ)
+@param path     oH̊i[
+
+@retval true  oH
+@retval false X^[gS[T͈͊OA܂͌oH݂Ȃ
+*/
+template<typename F>
+bool Astar::Search(const glm::ivec2& start, const glm::ivec2& goal,
+	const F& cellCost, std::vector<glm::ivec2>& path)
+{
+	grid = nullptr;
+	if (Begin(start, goal, cellCost) == SearchState::searching)
+	{
+		Expand(cellCost, SIZE_MAX);
+	}
+	GetPath(path);
+	return searchState == SearchState::found;
+}
+
+/*
+TJn
+
+@param start    X^[gn_̊iq
+@param goal     S[n_̊iq
+@param cellCost iq̈ړRXgԂ֐(0ȂʂȂ)
+
+@return T̏ԁBX^[gS[T͈͊OȂnotFound
+*/
+template<typename F>
+Astar::SearchState Astar::Begin(const glm::ivec2& start, const glm::ivec2& goal, const F& cellCost)
+{
+	expandedCount = 0;
+	open.clear();
+	if (!IsInArea(start) || !IsInArea(goal))
+	{
+		searchState = SearchState::notFound;
+		return searchState;
+	}
+
+	// Tԍi߂āAO܂ł̃m[hSĖgpɂ
+	if (++generation == 0)
 	{
-		if (close->node[i] != NULL &&
-			m->x == close->node[i]->x &&
-			m->z == close->node[i]->z)
+		for (Node& e : nodes)
 		{
-			inClose = i;
-			break;
+			e.generation = 0;
 		}
+		generation = 1;
 	}
 
-	// mopenXgɂcloseXgɂ܂܂ĂȂꍇ
-	if (inOpen == -1 && inClose == -1)
+	this->goal = goal;
+	goalIndex = ToIndex(goal);
+	Node& goalNode = nodes[goalIndex];
+	goalNode.generation = generation;
+	goalNode.state = State::unknown;
+	const uint8_t goalCost = cellCost(goal.x, goal.y);
+	goalNode.cost = goalCost != NavGrid::blockedCost ? goalCost : NavGrid::flatCost;
+
+	startIndex = ToIndex(start);
+	Node& startNode = nodes[startIndex];
+	startNode.generation = generation;
+	startNode.g = 0;
+	startNode.f = Heuristic(start, goal);
+	startNode.parent = startIndex;
+	PushOpen(startIndex);
+
+	searchState = SearchState::searching;
+	return searchState;
+}
+
+/*
+I[vXg̃m[h𒲂ׂĒTi߂
+
+@param cellCost      iq̈ړRXgԂ֐(0ȂʂȂ)
+@param maxExpansions N[YXgɈڂm[h̍ő吔
+
+@return T̏
+*/
+template<typename F>
+Astar::SearchState Astar::Expand(const F& cellCost, size_t maxExpansions)
+{
+	for (size_t count = 0; count < maxExpansions; ++count)
 	{
-		m->parent = n; // m̐enƂĊi[
-		open->node[open->index++] = m; // mopenXgɒǉ
+		if (open.empty())
+		{
+			searchState = SearchState::notFound;
+			return searchState;
+		}
+
+		const uint32_t current = PopOpen();
+		Node& n = nodes[current];
+		n.state = State::closed;
+		++expandedCount;
+
+		// S[ɒTI(oHGetPath()Őeǂč)
+		if (current == goalIndex)
+		{
+			searchState = SearchState::found;
+			return searchState;
+		}
+
+		if (method == Method::astar)
+		{
+			AddNeighbors(current, cellCost);
+		}
+		else
+		{
+			AddJumpPoints(current, cellCost);
+		}
 	}
+	return searchState;
+}
+
+/*
+ׂ̊iqSăI[vXgɒǉ(A*)
 
-	// mopenXgɊ܂܂Ăꍇ
-	if (inOpen > -1)
+@param current  ׂm[h̔ԍ
+@param cellCost iq̈ړRXgԂ֐
+*/
+template<typename F>
+void Astar::AddNeighbors(uint32_t current, const F& cellCost)
+{
+	const float currentG = nodes[current].g;
+	const glm::ivec2 cell = ToCell(current);
+	bool isPassable[4] = {};
+	for (int i = 0; i < 8; ++i)
 	{
-		if (fdmCost < fsmCost)
+		const glm::ivec2 next(cell.x + neighbors[i].dx, cell.y + neighbors[i].dz);
+		if (!IsInArea(next))
+		{
+			continue;
+		}
+		if (i >= 4 && !(isPassable[neighbors[i].a] && isPassable[neighbors[i].b]))
 		{
-			m->parent = n; // m̐enƂĊi[
+			continue;
 		}
+		const uint32_t nextIndex = ToIndex(next);
+		Node& m = GetNode(nextIndex, cellCost);
+		if (m.state == State::blocked)
+		{
+			continue;
+		}
+		if (i < 4)
+		{
+			isPassable[i] = true;
+		}
+		if (m.state == State::closed)
+		{
+			continue;
+		}
+		Relax(current, nextIndex, next, currentG + (i < 4 ? 1.0f : diagonalCost) * m.cost);
 	}
+}
+
+/*
+Wv|CgI[vXgɒǉ(JPSAJPS+)
+
+@param current  ׂm[h̔ԍ
+@param cellCost iq̈ړRXgԂ֐
 
-	// mcloseXgɊ܂܂Ăꍇ
-	if (inClose > -1)
+e痈̐ɂiq𒲂ׂBق̊iqւ͐e璼ڍsقZ
+cɐiłꍇ́ÅiqʂāA1Ỏ̊iqʂȂ΁A
+Ǝ΂ߑOɂi(ǂ̊p荞ތoH͂̊iqʂ邵Ȃ)
+*/
+template<typename F>
+void Astar::AddJumpPoints(uint32_t current, const F& cellCost)
+{
+	const float currentG = nodes[current].g;
+	const glm::ivec2 cell = ToCell(current);
+	const glm::ivec2 from = StepDirection(cell - ToCell(nodes[current].parent));
+	for (const auto& e : neighbors)
 	{
-		if (fdmCost < fsmCost)
+		const glm::ivec2 direction(e.dx, e.dz);
+		if (from.x && from.y)
 		{
-			m->parent = n; // m̐enƂĊi[
-			open->node[open->index++] = m; // mopenXgɒǉ
-			close->node[inClose] = NULL; // closeXgɂ
+			// ΂߂ɐiłꍇ́AcƎ΂߂̑O
+			if ((direction.x && direction.x != from.x) || (direction.y && direction.y != from.y))
+			{
+				continue;
+			}
 		}
+		else if (from.x || from.y)
+		{
+			// cɐiłꍇ́AOƁA荞߂ꍇ̉Ǝ΂ߑO
+			const int forward = direction.x * from.x + direction.y * from.y;
+			const glm::ivec2 side = direction - from * forward;
+			if (forward < 0 || (side != glm::ivec2(0) &&
+				!(IsPassable(cell + side, cellCost) && !IsPassable(cell - from + side, cellCost))))
+			{
+				continue;
+			}
+		}
+
+		glm::ivec2 jumpPoint;
+		if (method == Method::jpsPlus ? !JumpPlus(cell, direction, jumpPoint) :
+			!Jump(cell, direction, cellCost, jumpPoint))
+		{
+			continue;
+		}
+		const uint32_t index = ToIndex(jumpPoint);
+		if (GetNode(index, cellCost).state == State::closed)
+		{
+			continue;
+		}
+		const glm::ivec2 distance = glm::abs(jumpPoint - cell);
+		const int steps = std::max(distance.x, distance.y);
+		Relax(current, index, jumpPoint,
+			currentG + static_cast<float>(steps) * (direction.x && direction.y ? diagonalCost : 1.0f));
 	}
 }
 
-Astar::NODE* Astar::GetMinCost(Astar::NODE *n)
+/*
+iq1ׂāÃWv|CgT(JPS)
+
+@param cell      Tn߂iq(̊iq͊܂܂Ȃ)
+@param direction iޕ
+@param cellCost  iq̈ړRXgԂ֐
+@param jumpPoint Wv|Cg̊i[
+
+@retval true  Wv|Cg
+@retval false ǂT͈͂̒[ɒ
+
+S[̊iq̓Wv|CgƂĈ
+΂߂ɐiޏꍇ́Acǂ炩̕ɃWv|CgiqWv|CgƂ
+*/
+template<typename F>
+bool Astar::Jump(glm::ivec2 cell, const glm::ivec2& direction, const F& cellCost, glm::ivec2& jumpPoint) const
 {
-	for (int x = 0; x < open.index; x++)
+	const bool isDiagonal = direction.x && direction.y;
+	const glm::ivec2 side(direction.y, direction.x); // cɐiޏꍇ̉
+	for (;;)
 	{
-		if (open.node[x] != NULL)
+		const glm::ivec2 next = cell + direction;
+		if (!IsPassable(next, cellCost))
+		{
+			return false;
+		}
+		if (isDiagonal)
+		{
+			if (!IsPassable(glm::ivec2(next.x, cell.y), cellCost) || !IsPassable(glm::ivec2(cell.x, next.y), cellCost))
+			{
+				return false;
+			}
+		}
+		cell = next;
+		if (cell == goal)
+		{
+			jumpPoint = cell;
+			return true;
+		}
+
+		if (isDiagonal)
 		{
-			int cost = open.node[x]->cost;
-			if (n == NULL || n->cost > cost)
+			glm::ivec2 p;
+			if (Jump(cell, glm::ivec2(direction.x, 0), cellCost, p) || Jump(cell, glm::ivec2(0, direction.y), cellCost, p))
 			{
-				// m[h̒ňԍŏ̃RXg𓾂
-				n = open.node[x];
-				open.node[x] = NULL;
+				jumpPoint = cell;
+				return true;
 			}
 		}
+		else if ((IsPassable(cell + side, cellCost) && !IsPassable(cell - direction + side, cellCost)) ||
+			(IsPassable(cell - side, cellCost) && !IsPassable(cell - direction - side, cellCost)))
+		{
+			jumpPoint = cell;
+			return true;
+		}
 	}
-	return n;
 }
 
-glm::vec3  Astar::CreateRoute(Astar::NODE *n)
+/*
+OvZWvgāÃWv|CgT(JPS+)
+
+@param cell      Tn߂iq(̊iq͊܂܂Ȃ)
+@param direction iޕ
+@param jumpPoint Wv|Cg̊i[
+
+@retval true  Wv|Cg
+@retval false ǂT͈͂̒[ɒ
+
+T͈͂̊O͕ǂƂ݂ȂāAWv͈͓ɐ؂l߂
+S[܂ł̓rɕǂȂꍇ́AS[(΂߂ɐiޏꍇ̓S[ƏcɕԊiq)Ԃ
+*/
+bool Astar::JumpPlus(const glm::ivec2& cell, const glm::ivec2& direction, glm::ivec2& jumpPoint) const
+{
+	const glm::ivec2 areaMax = areaMin + areaSize - 1;
+	int limit = INT_MAX;
+	if (direction.x)
+	{
+		limit = direction.x > 0 ? areaMax.x - cell.x : cell.x - areaMin.x;
+	}
+	if (direction.y)
+	{
+		limit = std::min(limit, direction.y > 0 ? areaMax.y - cell.y : cell.y - areaMin.y);
+	}
+	int distance = jumpPointMap->Distance(cell, direction);
+	if (abs(distance) > limit)
+	{
+		distance = -limit;
+	}
+
+	// (Wv|Cg)܂łɃS[Əc΂߂ɕԊiq΁AŎ~܂
+	const glm::ivec2 toGoal = goal - cell;
+	int goalSteps = 0;
+	if (direction.x && direction.y)
+	{
+		if (StepDirection(toGoal) == direction)
+		{
+			goalSteps = std::min(abs(toGoal.x), abs(toGoal.y));
+		}
+	}
+	else
+	{
+		const int forward = toGoal.x * direction.x + toGoal.y * direction.y;
+		if (forward > 0 && toGoal == direction * forward)
+		{
+			goalSteps = forward;
+		}
+	}
+	if (goalSteps > 0 && goalSteps <= abs(distance))
+	{
+		jumpPoint = cell + direction * goalSteps;
+		return true;
+	}
+
+	if (distance > 0)
+	{
+		jumpPoint = cell + direction * distance;
+		return true;
+	}
+	return false;
+}
+
+/*
+2̊iq̊Ԃ̐RXgvZ
+
+@param a iq1
+@param b iq2
+
+@return QȂꍇ8ړ̍ŏRXg(IN^C)
+*/
+float Astar::Heuristic(const glm::ivec2& a, const glm::ivec2& b)
+{
+	const int dx = abs(a.x - b.x);
+	const int dz = abs(a.y - b.y);
+	return static_cast<float>(dx + dz) + (diagonalCost - 2.0f) * static_cast<float>(std::min(dx, dz));
+}
+
+/*
+iqʂ邩ׂ
+
+@param cell     iq
+@param cellCost iq̈ړRXgԂ֐
+
+@retval true  T͈͓̒ʂiq(X^[gƃS[܂)
+@retval false T͈͊OAʂȂiq
+
+JPSŊiq1ׂƂɎgBm[hcellCost𒼐ڌĂяo
+*/
+template<typename F>
+bool Astar::IsPassable(const glm::ivec2& cell, const F& cellCost) const
+{
+	if (!IsInArea(cell))
+	{
+		return false;
+	}
+	return cellCost(cell.x, cell.y) != NavGrid::blockedCost || cell == goal || ToIndex(cell) == startIndex;
+}
+
+/*
+m[h擾
+
+@param index    m[hԍ
+@param cellCost iq̈ړRXgԂ֐
+
+@return m[hB̒Tŏ߂Ď擾ꍇ͏AړRXg𒲂ׂĂ
+*/
+template<typename F>
+Astar::Node& Astar::GetNode(uint32_t index, const F& cellCost)
+{
+	Node& node = nodes[index];
+	if (node.generation != generation)
+	{
+		node.generation = generation;
+		const glm::ivec2 cell = ToCell(index);
+		node.cost = cellCost(cell.x, cell.y);
+		node.state = node.cost != NavGrid::blockedCost ? State::unknown : State::blocked;
+	}
+	return node;
+}
+
+/*
+m[h̃RXgXV
+
+@param parent em[h̔ԍ
+@param index  m[hԍ(GetNode()ŏς݂ŁAN[YXgɂȂ)
+@param cell   m[h̊iq
+@param g      parentoRꍇ̃X^[g̃RXg
+
+I[vXgɂȂΒǉA΂ꍇetւ
+*/
+void Astar::Relax(uint32_t parent, uint32_t index, const glm::ivec2& cell, float g)
+{
+	Node& m = nodes[index];
+	if (m.state == State::open)
+	{
+		if (g < m.g)
+		{
+			m.f += g - m.g;
+			m.g = g;
+			m.parent = parent;
+			SiftUp(m.heapIndex);
+		}
+	}
+	else
+	{
+		m.g = g;
+		m.f = g + Heuristic(cell, goal);
+		m.parent = parent;
+		PushOpen(index);
+	}
+}
+
+/*
+T̕@I
+
+@param start X^[gn_̊iq
+@param goal  S[n_̊iq
+@param grid  iqƂ̈ړRXg(nullptrȂړRXg͑Sē)
+
+@return T͈͂̒ʂiq̈ړRXgSēȂJPSAႤiqA*
+        JPS̏ꍇAWv̕\gridƈvĂāAX^[gƃS[ʂJPS+
+*/
+Astar::Method Astar::SelectMethod(const glm::ivec2& start, const glm::ivec2& goal, const NavGrid* grid) const
+{
+	if (!isJumpPointEnabled)
+	{
+		return Method::astar;
+	}
+	if (!grid)
+	{
+		return Method::jps;
+	}
+	if (!grid->IsUniform(areaMin, areaMin + areaSize - 1))
+	{
+		return Method::astar;
+	}
+	// \̓X^[gƃS[ʂ̂ƂĈȂ̂ŁAʂȂꍇJPSŒT
+	if (jumpPointMap && jumpPointMap->IsValid(*grid) &&
+		grid->IsWalkable(start.x, start.y) && grid->IsWalkable(goal.x, goal.y))
+	{
+		return Method::jpsPlus;
+	}
+	return Method::jps;
+}
+
+/*
+iqTׂ͈͓
+*/
+bool Astar::IsInArea(const glm::ivec2& cell) const
+{
+	const glm::ivec2 local = cell - areaMin;
+	return local.x >= 0 && local.y >= 0 && local.x < areaSize.x && local.y < areaSize.y;
+}
+
+/*
+iqm[hԍɕϊ
+*/
+uint32_t Astar::ToIndex(const glm::ivec2& cell) const
+{
+	const glm::ivec2 local = cell - areaMin;
+	return static_cast<uint32_t>(local.y * areaSize.x + local.x);
+}
+
+/*
+m[hԍiqɕϊ
+*/
+glm::ivec2 Astar::ToCell(uint32_t index) const
+{
+	return areaMin + glm::ivec2(index % areaSize.x, index / areaSize.x);
+}
+
+/*
+I[vXgabɎoׂ
+
+fȂg傫(S[ɋ߂)قɂ
+*/
+bool Astar::IsLess(uint32_t a, uint32_t b) const
+{
+	const Node& na = nodes[a];
+	const Node& nb = nodes[b];
+	return na.f < nb.f || (na.f == nb.f && na.g > nb.g);
+}
+
+/*
+m[hI[vXgɒǉ
+*/
+void Astar::PushOpen(uint32_t index)
+{
+	nodes[index].state = State::open;
+	nodes[index].heapIndex = static_cast<uint32_t>(open.size());
+	open.push_back(index);
+	SiftUp(nodes[index].heapIndex);
+}
+
+/*
+I[vXgŏRXg̃m[ho
+*/
+uint32_t Astar::PopOpen()
 {
-	glm::vec3 p;
-	costError = false;
-	if (n->cost >= n->parent->cost)
+	const uint32_t top = open.front();
+	open.front() = open.back();
+	nodes[open.front()].heapIndex = 0;
+	open.pop_back();
+	if (!open.empty())
 	{
-		n = n->parent;
-		p = glm::vec3(n->x, 0, n->z);
+		SiftDown(0);
 	}
-	// em[h̃RXg傫ꍇ̗O
-	else if (n->cost < n->parent->cost)
+	return top;
+}
+
+/*
+q[v̗vfeƔrďɈړ
+*/
+void Astar::SiftUp(uint32_t pos)
+{
+	const uint32_t index = open[pos];
+	while (pos > 0)
 	{
-		printf("RXgG[\n");
-		// em[h̋ɂ
-		n->parent = NULL;
-		costError = true;
+		const uint32_t parent = (pos - 1) / 2;
+		if (!IsLess(index, open[parent]))
+		{
+			break;
+		}
+		open[pos] = open[parent];
+		nodes[open[pos]].heapIndex = pos;
+		pos = parent;
 	}
-	return p;
-}
\ No newline at end of file
+	open[pos] = index;
+	nodes[index].heapIndex = pos;
+}
+
+/*
+q[v̗vfqƔrĉɈړ
+*/
+void Astar::SiftDown(uint32_t pos)
+{
+	const uint32_t index = open[pos];
+	const uint32_t size = static_cast<uint32_t>(open.size());
+	for (;;)
+	{
+		uint32_t child = pos * 2 + 1;
+		if (child >= size)
+		{
+			break;
+		}
+		if (child + 1 < size && IsLess(open[child + 1], open[child]))
+		{
+			++child;
+		}
+		if (!IsLess(open[child], index))
+		{
+			break;
+		}
+		open[pos] = open[child];
+		nodes[open[pos]].heapIndex = pos;
+		pos = child;
+	}
+	open[pos] = index;
+	nodes[index].heapIndex = pos;
+}
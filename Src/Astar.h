@@ -1,47 +1,151 @@
+/*
+@file Astar.h
+*/
 #ifndef ASTAR_H_INCLUDED
-#define ASRAR_H_INCLUDED
+#define ASTAR_H_INCLUDED
 #include <glm/glm.hpp>
+#include <functional>
+#include <vector>
+#include <stdint.h>
 
-#define NODE_MAX 1000
+class NavGrid;
+class JumpPointMap;
 
+/*
+iq̌oHA*ŒTNX
+
+8ɈړłAc̈ړRXg1A΂߂̈ړRXǵ2Ƃ
+NavGridgꍇ́Aړ̊iq̃RXg|
+΂߂̈ړ́Acׂ̗ʂꍇ(ǂ̊p蔲Ȃ悤ɂ)
+
+T̍Ɨ̈(m[h̔z)SetArea()ŊmۂAT̂тɎg
+FindPath()͌oH܂ŒT邪ABeginSearch()Step()gƁA
+T񂩂ɕďi߂邱Ƃł(ȑԂ͂̃IuWFNgɎc)
+m[hɂ͒TԍL^ĂAԍ̈Ⴄm[h͖gpƂ݂Ȃ̂ŁA
+T̊JnɔzKv͂Ȃ
+I[vXg̓m[ḧʒuL^񕪃q[vŊǗ
+
+͈͓̒ʂiq̈ړRXgSēꍇ́AIJump Point Search(JPS)ŒT
+܂i߂Ԃ͓r̊iqI[vXgɓꂸAȂpɂȂ肤iq(Wv|Cg)܂Ŕ
+A*ƓRXg̍ŒZoHԂAI[vXgɓm[h͑啝ɏȂȂ
+SetJumpPointMap()ŎOvZWvnƁAiq1ׂɕ\(JPS+)
+
+1̃IuWFNg𕡐̃Xbh瓯ɎgȂ
+*/
 class Astar
 {
 public:
-	struct NODE
+	// iqʂ邩ǂԂ֐
+	using WalkableFunc = std::function<bool(int x, int z)>;
+
+	// T̕@
+	enum class Method
 	{
-		int x;
-		int z;
-		int cost;
-		struct NODE *parent;	 // em[h
+		astar,   // ׂ̊iqSĒׂ
+		jps,     // Jump Point Search
+		jpsPlus, // OvZWvgJump Point Search
 	};
-	typedef struct NODE NODE;
 
-	struct LIST
+	// T̏
+	enum class SearchState
 	{
-		NODE *node[NODE_MAX];
-		int index;
+		searching, // T
+		found,     // oH
+		notFound,  // oH݂Ȃ
 	};
-	typedef struct LIST LIST;
 
-	NODE *CreateNode(int x, int z, int cost);
-	int G(NODE *s, NODE *n);
-	int H(NODE *e, NODE *n);
-	void SearchNode(LIST *open, LIST *close, NODE *s,
-		NODE *e, NODE *n, NODE *m);
-	
-	NODE* GetMinCost(NODE *n);
-	glm::vec3 CreateRoute(NODE *n);
+	Astar() = default;
+	~Astar() = default;
 
-	NODE s = { 0, 0, 0 };
-	NODE e = { 0, 0, 0 };
-	LIST open;
-	LIST close;
+	void SetArea(const glm::ivec2& areaMin, const glm::ivec2& areaMax);
+	void SetJumpPointEnabled(bool enabled) { isJumpPointEnabled = enabled; }
+	void SetJumpPointMap(const JumpPointMap* map) { jumpPointMap = map; }
+	bool FindPath(const glm::ivec2& start, const glm::ivec2& goal,
+		const WalkableFunc& isWalkable, std::vector<glm::ivec2>& path);
+	bool FindPath(const glm::ivec2& start, const glm::ivec2& goal,
+		const NavGrid& grid, std::vector<glm::ivec2>& path);
 
-	bool costError = false;
+	SearchState BeginSearch(const glm::ivec2& start, const glm::ivec2& goal, const NavGrid& grid);
+	SearchState Step(size_t maxExpansions);
+	SearchState GetSearchState() const { return searchState; }
+	void GetPath(std::vector<glm::ivec2>& path) const;
+
+	// O̒TŃN[YXgɈڂm[h̐
+	size_t ExpandedCount() const { return expandedCount; }
+
+	// O̒T̕@
+	Method GetMethod() const { return method; }
+
+	static float Heuristic(const glm::ivec2& a, const glm::ivec2& b);
 
 private:
+	// m[h̏
+	enum class State : uint8_t
+	{
+		unknown, // 
+		open,    // I[vXgɂ
+		closed,  // N[YXgɂ
+		blocked, // ʂȂ
+	};
 
-};
+	// m[h
+	struct Node
+	{
+		float g = 0;                 // X^[g̍ŏRXg
+		float f = 0;                 // g + S[܂ł̐RXg
+		uint32_t parent = 0;         // em[h̔ԍ
+		uint32_t heapIndex = 0;      // I[vXg̈ʒu
+		uint32_t generation = 0;     // ŌɎgT̔ԍ
+		State state = State::unknown;
+		uint8_t cost = 1;            // iq̈ړRXg
+	};
+
+	template<typename F>
+	bool Search(const glm::ivec2& start, const glm::ivec2& goal,
+		const F& cellCost, std::vector<glm::ivec2>& path);
+	template<typename F>
+	SearchState Begin(const glm::ivec2& start, const glm::ivec2& goal, const F& cellCost);
+	template<typename F>
+	SearchState Expand(const F& cellCost, size_t maxExpansions);
+	template<typename F>
+	void AddNeighbors(uint32_t current, const F& cellCost);
+	template<typename F>
+	void AddJumpPoints(uint32_t current, const F& cellCost);
+	template<typename F>
+	bool Jump(glm::ivec2 cell, const glm::ivec2& direction, const F& cellCost, glm::ivec2& jumpPoint) const;
+	bool JumpPlus(const glm::ivec2& cell, const glm::ivec2& direction, glm::ivec2& jumpPoint) const;
+	template<typename F>
+	bool IsPassable(const glm::ivec2& cell, const F& cellCost) const;
+	template<typename F>
+	Node& GetNode(uint32_t index, const F& cellCost);
+	void Relax(uint32_t parent, uint32_t index, const glm::ivec2& cell, float g);
+	Method SelectMethod(const glm::ivec2& start, const glm::ivec2& goal, const NavGrid* grid) const;
+	bool IsInArea(const glm::ivec2& cell) const;
+	uint32_t ToIndex(const glm::ivec2& cell) const;
+	glm::ivec2 ToCell(uint32_t index) const;
 
+	bool IsLess(uint32_t a, uint32_t b) const;
+	void PushOpen(uint32_t index);
+	uint32_t PopOpen();
+	void SiftUp(uint32_t pos);
+	void SiftDown(uint32_t pos);
+
+	glm::ivec2 areaMin = glm::ivec2(0);  // T͈͂̍ŏW
+	glm::ivec2 areaSize = glm::ivec2(0); // T͈͂̑傫
+	std::vector<Node> nodes;             // T͈͂̊iqƂ̃m[h
+	std::vector<uint32_t> open;          // I[vXg(m[hԍ̓񕪃q[v)
+	uint32_t generation = 0;             // ݂̒T̔ԍ
+	size_t expandedCount = 0;            // O̒TŃN[YXgɈڂm[h̐
+
+	SearchState searchState = SearchState::notFound; // O̒T̏
+	glm::ivec2 goal = glm::ivec2(0);     // T̃S[n_̊iq
+	uint32_t startIndex = 0;             // X^[gn_̃m[hԍ
+	uint32_t goalIndex = 0;              // S[n_̃m[hԍ
+	const NavGrid* grid = nullptr;       // Step()Ŏgiq
+
+	Method method = Method::astar;              // ݂̒T̕@
+	bool isJumpPointEnabled = true;             // falseȂJPSgȂ
+	const JumpPointMap* jumpPointMap = nullptr; // JPS+ŎgWv(nullptrȂJPS+gȂ)
+};
 
 #endif // !ASTAR_H_INCLUDED
@@ -2,6 +2,84 @@
 @file Collision.cpp
 */
 #include "Collision.h"
+#include <algorithm>
+#include <cmath>
+#include <float.h>
+
+namespace /* unnamed */ {
+
+// XC[vEAhEv[ŕבւvf
+struct SweepEntry
+{
+	float min; // |̍ŏW
+	float max; // |̍őW
+	uint32_t index; // ̔z̃CfbNX
+};
+
+// בւɎgƗpz(ĂяoƂɊmۂȂ悤ɃXbhƂɎ)
+thread_local std::vector<SweepEntry> sweepA;
+thread_local std::vector<SweepEntry> sweepB;
+
+/*
+|̍Wŕבւz
+
+@param boxes  AABB̔z
+@param axis   |(0=X 1=Y 2=Z)
+@param result בւʂ̊i[
+
+AABB͊܂߂Ȃ
+*/
+void BuildSweepList(const std::vector<Collision::AABB>& boxes, int axis,
+	std::vector<SweepEntry>& result)
+{
+	result.clear();
+	result.reserve(boxes.size());
+	for (size_t i = 0; i < boxes.size(); ++i)
+	{
+		const Collision::AABB& e = boxes[i];
+		if (e.min.x > e.max.x || e.min.y > e.max.y || e.min.z > e.max.z)
+		{
+			continue;
+		}
+		result.push_back({ e.min[axis], e.max[axis], static_cast<uint32_t>(i) });
+	}
+	std::sort(result.begin(), result.end(),
+		[](const SweepEntry& l, const SweepEntry& r) { return l.min < r.min; });
+}
+
+/*
+|ɎgWI
+
+@param a AABB̔z񂻂1
+@param b AABB̔z񂻂2
+
+@return SW̕Uł傫(0=X 1=Y 2=Z)
+
+vfLU΂Ă鎲قǁA|ɏdȂԂȂȂ
+*/
+int ChooseSweepAxis(const std::vector<Collision::AABB>& a, const std::vector<Collision::AABB>& b)
+{
+	glm::vec3 sum(0);
+	glm::vec3 sumSq(0);
+	for (const auto* boxes : { &a, &b })
+	{
+		for (const Collision::AABB& e : *boxes)
+		{
+			const glm::vec3 c = (e.min + e.max) * 0.5f;
+			sum += c;
+			sumSq += c * c;
+		}
+	}
+	const float n = static_cast<float>(std::max<size_t>(a.size() + b.size(), 1));
+	const glm::vec3 variance = sumSq / n - (sum / n) * (sum / n);
+	if (variance.x >= variance.y && variance.x >= variance.z)
+	{
+		return 0;
+	}
+	return variance.z >= variance.y ? 2 : 1;
+}
+
+} // unnamed namespace
 
 namespace Collision
 {
@@ -163,6 +241,285 @@ namespace Collision
 		return dot(distance, distance) <= s.r * s.r;
 	}
 
+	/*
+	Ɛ̍ŋߐړ_𒲂ׂ
+
+	@param s0 1
+	@param s1 2
+	@param p0 s0̍ŋߐړ_̊i[
+	@param p1 s1̍ŋߐړ_̊i[
+
+	@return ŋߐړ_Ԃ̋2
+	*/
+	float ClosestPointSegmentSegment(const Segment& s0, const Segment& s1,
+		glm::vec3* p0, glm::vec3* p1)
+	{
+		const glm::vec3 d0 = s0.b - s0.a;
+		const glm::vec3 d1 = s1.b - s1.a;
+		const glm::vec3 r = s0.a - s1.a;
+		const float a = glm::dot(d0, d0);
+		const float e = glm::dot(d1, d1);
+		const float f = glm::dot(d1, r);
+
+		float t0 = 0; // s0̈ʒu(0`1)
+		float t1 = 0; // s1̈ʒu(0`1)
+		if (a <= FLT_EPSILON && e <= FLT_EPSILON)
+		{
+			// Ƃ_
+		}
+		else if (a <= FLT_EPSILON)
+		{
+			// s0_
+			t1 = glm::clamp(f / e, 0.0f, 1.0f);
+		}
+		else
+		{
+			const float c = glm::dot(d0, r);
+			if (e <= FLT_EPSILON)
+			{
+				// s1_
+				t0 = glm::clamp(-c / a, 0.0f, 1.0f);
+			}
+			else
+			{
+				// m̍ŋߐړ_s0ŋ߁As1͈̔͂Ɏ܂ȂΒ[_狁ߒ
+				const float b = glm::dot(d0, d1);
+				const float denom = a * e - b * b;
+				if (denom > 0)
+				{
+					t0 = glm::clamp((b * f - c * e) / denom, 0.0f, 1.0f);
+				}
+				t1 = (b * t0 + f) / e;
+				if (t1 < 0)
+				{
+					t1 = 0;
+					t0 = glm::clamp(-c / a, 0.0f, 1.0f);
+				}
+				else if (t1 > 1)
+				{
+					t1 = 1;
+					t0 = glm::clamp((b - c) / a, 0.0f, 1.0f);
+				}
+			}
+		}
+		*p0 = s0.a + d0 * t0;
+		*p1 = s1.a + d1 * t1;
+		const glm::vec3 v = *p0 - *p1;
+		return glm::dot(v, v);
+	}
+
+	/*
+	JvZƃJvZՓ˂Ă邩ׂ
+
+	@param c0 JvZ1
+	@param c1 JvZ2
+	@param p0 c0̒S̐̍ŋߐړ_̊i[
+	@param p1 c1̒S̐̍ŋߐړ_̊i[
+
+	@retval true  Փ˂Ă
+	@retval false Փ˂ĂȂ
+	*/
+	bool TestCapsuleCapsule(const Capsule& c0, const Capsule& c1, glm::vec3* p0, glm::vec3* p1)
+	{
+		const float radiusSum = c0.r + c1.r;
+
+		// ͂ދmĂ΁Aŋߐړ_߂܂łȂ
+		const glm::vec3 m = (c0.seg.a + c0.seg.b - c1.seg.a - c1.seg.b) * 0.5f;
+		const float bound = radiusSum + (glm::length(c0.seg.b - c0.seg.a) +
+			glm::length(c1.seg.b - c1.seg.a)) * 0.5f;
+		if (glm::dot(m, m) > bound * bound)
+		{
+			return false;
+		}
+		return ClosestPointSegmentSegment(c0.seg, c1.seg, p0, p1) <= radiusSum * radiusSum;
+	}
+
+	/*
+	JvZOBBՓ˂Ă邩ׂ
+
+	@param c   JvZ
+	@param obb LE{bNX
+	@param pc  JvZ̒S̐ŁAobbɍł߂_̊i[
+	@param pb  obbpcɍł߂_̊i[
+
+	@retval true  Փ˂Ă
+	@retval false Փ˂ĂȂ
+
+	̓_OBB̋2́AOBB̖ʂ܂ޕʂƌʒuŋ؂
+	eԂł2֐ɂȂBԂƂɍŏl߁Ał̗̂p
+	*/
+	bool TestCapsuleOBB(const Capsule& c, const OrientedBoundingBox& obb,
+		glm::vec3* pc, glm::vec3* pb)
+	{
+		// ͂ދOBB͂ދĂ΁Aŋߐړ_߂܂łȂ
+		const glm::vec3 m = (c.seg.a + c.seg.b) * 0.5f - obb.center;
+		const float bound = c.r + glm::length(c.seg.b - c.seg.a) * 0.5f + glm::length(obb.e);
+		if (glm::dot(m, m) > bound * bound)
+		{
+			return false;
+		}
+
+		// OBB̍Wnɕϊ
+		glm::vec3 p0, dir;
+		for (int i = 0; i < 3; ++i)
+		{
+			p0[i] = glm::dot(c.seg.a - obb.center, obb.axis[i]);
+			dir[i] = glm::dot(c.seg.b - c.seg.a, obb.axis[i]);
+		}
+
+		// eʂ̕ʂƌʒuŋ؂([܂߂čő8)
+		float ts[8] = { 0, 1 };
+		int count = 2;
+		for (int i = 0; i < 3; ++i)
+		{
+			if (std::abs(dir[i]) <= FLT_EPSILON)
+			{
+				continue;
+			}
+			for (const float plane : { -obb.e[i], obb.e[i] })
+			{
+				const float t = (plane - p0[i]) / dir[i];
+				if (t > 0 && t < 1)
+				{
+					ts[count++] = t;
+				}
+			}
+		}
+		// ő8Ȃ̂ő}\[gŕׂ(std::sort͔z̑傫𒴂镪܂݁Ax̌ɂȂ)
+		for (int i = 1; i < count; ++i)
+		{
+			const float t = ts[i];
+			int j = i;
+			for (; j > 0 && ts[j - 1] > t; --j)
+			{
+				ts[j] = ts[j - 1];
+			}
+			ts[j] = t;
+		}
+
+		float bestT = 0;
+		float bestDistance = FLT_MAX;
+		for (int k = 0; k + 1 < count && bestDistance > 0; ++k)
+		{
+			// Ԃ̒OBB̊Oɂ鎲𒲂ׁA2At^2 + Bt + Č`ŕ\
+			const float t0 = ts[k];
+			const float t1 = ts[k + 1];
+			const float mid = (t0 + t1) * 0.5f;
+			float A = 0, B = 0, C = 0;
+			for (int i = 0; i < 3; ++i)
+			{
+				const float x = p0[i] + dir[i] * mid;
+				float plane;
+				if (x > obb.e[i])
+				{
+					plane = obb.e[i];
+				}
+				else if (x < -obb.e[i])
+				{
+					plane = -obb.e[i];
+				}
+				else
+				{
+					continue;
+				}
+				const float offset = p0[i] - plane;
+				A += dir[i] * dir[i];
+				B += 2 * offset * dir[i];
+				C += offset * offset;
+			}
+			const float t = A > 0 ? glm::clamp(-B / (2 * A), t0, t1) : t0;
+			const float distance = std::max((A * t + B) * t + C, 0.0f);
+			if (distance < bestDistance)
+			{
+				bestDistance = distance;
+				bestT = t;
+			}
+		}
+		if (bestDistance > c.r * c.r)
+		{
+			return false;
+		}
+		*pc = c.seg.a + (c.seg.b - c.seg.a) * bestT;
+		*pb = ClosetPointOBB(obb, *pc);
+		return true;
+	}
+
+	/*
+	OBBOBBՓ˂Ă邩ׂ
+
+	@param a  LE{bNX1
+	@param b  LE{bNX2
+	@param pa apbɍł߂_̊i[
+	@param pb ba̒Sɍł߂_̊i[
+
+	@retval true  Փ˂Ă
+	@retval false Փ˂ĂȂ
+
+	sB₷a̖ʂ̖@Ab̖ʂ̖@Aӓm̊Oς̏ɒׁA
+	ǂꂩ1łĂ΁A̎_ŔI
+	*/
+	bool TestOBBOBB(const OrientedBoundingBox& a, const OrientedBoundingBox& b,
+		glm::vec3* pa, glm::vec3* pb)
+	{
+		// b̎a̍Wnŕ\]sƁA̐Βl
+		// ӂsȂƂɊOς0xNgɂȂČ딻肵Ȃ悤AΒlɂ͌덷𑫂Ă
+		float R[3][3], absR[3][3];
+		for (int i = 0; i < 3; ++i)
+		{
+			for (int j = 0; j < 3; ++j)
+			{
+				R[i][j] = glm::dot(a.axis[i], b.axis[j]);
+				absR[i][j] = std::abs(R[i][j]) + 1e-5f;
+			}
+		}
+		const glm::vec3 d = b.center - a.center;
+		const glm::vec3 t(glm::dot(d, a.axis[0]), glm::dot(d, a.axis[1]), glm::dot(d, a.axis[2]));
+
+		// a̖ʂ̖@
+		for (int i = 0; i < 3; ++i)
+		{
+			const float rb = b.e[0] * absR[i][0] + b.e[1] * absR[i][1] + b.e[2] * absR[i][2];
+			if (std::abs(t[i]) > a.e[i] + rb)
+			{
+				return false;
+			}
+		}
+
+		// b̖ʂ̖@
+		for (int j = 0; j < 3; ++j)
+		{
+			const float ra = a.e[0] * absR[0][j] + a.e[1] * absR[1][j] + a.e[2] * absR[2][j];
+			const float distance = t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j];
+			if (std::abs(distance) > ra + b.e[j])
+			{
+				return false;
+			}
+		}
+
+		// a̕ӂb̕ӂ̊O
+		for (int i = 0; i < 3; ++i)
+		{
+			const int i1 = (i + 1) % 3;
+			const int i2 = (i + 2) % 3;
+			for (int j = 0; j < 3; ++j)
+			{
+				const int j1 = (j + 1) % 3;
+				const int j2 = (j + 2) % 3;
+				const float ra = a.e[i1] * absR[i2][j] + a.e[i2] * absR[i1][j];
+				const float rb = b.e[j1] * absR[i][j2] + b.e[j2] * absR[i][j1];
+				const float distance = t[i2] * R[i1][j] - t[i1] * R[i2][j];
+				if (std::abs(distance) > ra + rb)
+				{
+					return false;
+				}
+			}
+		}
+
+		*pb = ClosetPointOBB(b, a.center);
+		*pa = ClosetPointOBB(a, *pb);
+		return true;
+	}
+
 	/*
 	VFCvmՓ˂Ă邩ׂ
 
@@ -173,6 +530,9 @@ namespace Collision
 
 	@retval true  Փ˂
 	@retval false Փ˂Ȃ
+
+	paa̒S()܂͒S̐̓_(JvZ)܂a̓_(OBB)A
+	pbb̓l̓_ŁApa-pbԂ̌Ԃ̖ڈɂȂ
 	*/
 	bool TestShapeShape(const Shape& a, const Shape& b, glm::vec3* pa, glm::vec3* pb)
 	{
@@ -214,6 +574,14 @@ namespace Collision
 					return true;
 				}
 			}
+			else if (b.type == Shape::Type::capsule)
+			{
+				return TestCapsuleCapsule(a.c, b.c, pa, pb);
+			}
+			else if (b.type == Shape::Type::obb)
+			{
+				return TestCapsuleOBB(a.c, b.obb, pa, pb);
+			}
 		}
 		else if (a.type == Shape::Type::obb)
 		{
@@ -225,8 +593,731 @@ namespace Collision
 					return true;
 				}
 			}
+			else if (b.type == Shape::Type::capsule)
+			{
+				return TestCapsuleOBB(b.c, a.obb, pb, pa);
+			}
+			else if (b.type == Shape::Type::obb)
+			{
+				return TestOBBOBB(a.obb, b.obb, pa, pb);
+			}
 		}
 		return false;
 	}
-	
+
+	/*
+	VFCv͂AABBvZ
+
+	@param shape AABBvZVFCv
+
+	@return shape͂AABB
+	        `󂪂Ȃꍇ͋AABB
+	*/
+	AABB CalcAABB(const Shape& shape)
+	{
+		AABB result;
+		switch (shape.type)
+		{
+		case Shape::Type::sphere:
+			result.min = shape.s.center - glm::vec3(shape.s.r);
+			result.max = shape.s.center + glm::vec3(shape.s.r);
+			break;
+
+		case Shape::Type::capsule:
+			result.min = glm::min(shape.c.seg.a, shape.c.seg.b) - glm::vec3(shape.c.r);
+			result.max = glm::max(shape.c.seg.a, shape.c.seg.b) + glm::vec3(shape.c.r);
+			break;
+
+		case Shape::Type::obb:
+		{
+			// e̔a[hWɓe𑫂킹
+			const OrientedBoundingBox& obb = shape.obb;
+			const glm::vec3 r = glm::abs(obb.axis[0]) * obb.e.x +
+				glm::abs(obb.axis[1]) * obb.e.y + glm::abs(obb.axis[2]) * obb.e.z;
+			result.min = obb.center - r;
+			result.max = obb.center + r;
+			break;
+		}
+
+		default:
+			result.min = glm::vec3(1);
+			result.max = glm::vec3(-1);
+			break;
+		}
+		return result;
+	}
+
+	/*
+	AABBmdȂĂ邩ׂ
+
+	@param a ΏۂAABB1
+	@param b ΏۂAABB2
+
+	@retval true  dȂĂ(AABB͏false)
+	@retval false dȂĂȂ
+	*/
+	bool TestAABBAABB(const AABB& a, const AABB& b)
+	{
+		return a.min.x <= b.max.x && b.min.x <= a.max.x &&
+			a.min.y <= b.max.y && b.min.y <= a.max.y &&
+			a.min.z <= b.max.z && b.min.z <= a.max.z &&
+			a.min.x <= a.max.x && b.min.x <= b.max.x;
+	}
+
+	/*
+	VFCvƓ_̍ŋߐړ_𒲂ׂ
+
+	@param shape VFCv
+	@param p     _
+
+	@return shape̕\ʂ܂͓pɍł߂_
+	        pshape̓ɂꍇp
+	*/
+	glm::vec3 ClosestPointShape(const Shape& shape, const glm::vec3& p)
+	{
+		switch (shape.type)
+		{
+		case Shape::Type::sphere:
+		{
+			const glm::vec3 v = p - shape.s.center;
+			const float d2 = glm::dot(v, v);
+			if (d2 <= shape.s.r * shape.s.r)
+			{
+				return p;
+			}
+			return shape.s.center + v * (shape.s.r / std::sqrt(d2));
+		}
+
+		case Shape::Type::capsule:
+		{
+			const glm::vec3 c = ClosestPointSegment(shape.c.seg, p);
+			const glm::vec3 v = p - c;
+			const float d2 = glm::dot(v, v);
+			if (d2 <= shape.c.r * shape.c.r)
+			{
+				return p;
+			}
+			return c + v * (shape.c.r / std::sqrt(d2));
+		}
+
+		case Shape::Type::obb:
+			return ClosetPointOBB(shape.obb, p);
+
+		default:
+			return p + glm::vec3(FLT_MAX);
+		}
+	}
+
+	/*
+	VFCv̕\ʂ̖@𒲂ׂ
+
+	@param shape VFCv
+	@param p     shape̕\ʏ̓_
+
+	@return pɂO̖@
+	        p̒SJvZ̎̏ɂČ܂Ȃꍇ0xNg
+	*/
+	glm::vec3 SurfaceNormalShape(const Shape& shape, const glm::vec3& p)
+	{
+		glm::vec3 v(0);
+		switch (shape.type)
+		{
+		case Shape::Type::sphere:
+			v = p - shape.s.center;
+			break;
+
+		case Shape::Type::capsule:
+			v = p - ClosestPointSegment(shape.c.seg, p);
+			break;
+
+		case Shape::Type::obb:
+		{
+			// aɑ΂鋗̊ł傫̖ʂɂ
+			const OrientedBoundingBox& obb = shape.obb;
+			const glm::vec3 d = p - obb.center;
+			float maxRatio = -1;
+			for (int i = 0; i < 3; ++i)
+			{
+				const float distance = glm::dot(d, obb.axis[i]);
+				const float ratio = std::abs(distance) / std::max(obb.e[i], FLT_EPSILON);
+				if (ratio > maxRatio)
+				{
+					maxRatio = ratio;
+					v = distance < 0 ? -obb.axis[i] : obb.axis[i];
+				}
+			}
+			break;
+		}
+
+		default:
+			break;
+		}
+		const float length = glm::length(v);
+		return length > FLT_EPSILON ? v / length : glm::vec3(0);
+	}
+
+	/*
+	AABBƓ_̋2𒲂ׂ
+
+	@param box AABB
+	@param p   _
+
+	@return boxp̋2(pbox̓ɂꍇ0)
+	*/
+	float DistanceSqAABB(const AABB& box, const glm::vec3& p)
+	{
+		const glm::vec3 d = glm::max(glm::max(box.min - p, p - box.max), glm::vec3(0));
+		return glm::dot(d, d);
+	}
+
+	/*
+	Č̋tvZ
+
+	@param dir Č
+
+	@return e̋t(IntersectRayAABB()ɓn)
+	        0ZAƕsȐ͕t̖ƂĈ
+	*/
+	glm::vec3 InverseDirection(const glm::vec3& dir)
+	{
+		glm::vec3 invDir;
+		for (int i = 0; i < 3; ++i)
+		{
+			invDir[i] = std::abs(dir[i]) > FLT_EPSILON ? 1.0f / dir[i] : (dir[i] < 0 ? -FLT_MAX : FLT_MAX);
+		}
+		return invDir;
+	}
+
+	/*
+	CAABBĂ邩ׂ
+
+	@param origin      C̎n_
+	@param invDir      Č̋t(1 / dir)
+	@param box         AABB
+	@param maxDistance C̒
+	@param t           _܂ł̋̊i[(n_box̓ɂꍇ0)
+
+	@retval true  Ă
+	@retval false ĂȂ
+	*/
+	bool IntersectRayAABB(const glm::vec3& origin, const glm::vec3& invDir,
+		const AABB& box, float maxDistance, float* t)
+	{
+		const glm::vec3 t0 = (box.min - origin) * invDir;
+		const glm::vec3 t1 = (box.max - origin) * invDir;
+		const glm::vec3 tNear = glm::min(t0, t1);
+		const glm::vec3 tFar = glm::max(t0, t1);
+		const float tMin = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+		const float tMax = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+		if (tMin > tMax)
+		{
+			return false;
+		}
+		*t = tMin;
+		return true;
+	}
+
+	/*
+	CƋĂ邩ׂ
+
+	@param origin      C̎n_
+	@param dir         Č
+	@param s           
+	@param maxDistance C̒
+	@param t           _܂ł̋̊i[(n_s̓ɂꍇ0)
+
+	@retval true  Ă
+	@retval false ĂȂ
+	*/
+	bool IntersectRaySphere(const glm::vec3& origin, const glm::vec3& dir,
+		const Sphere& s, float maxDistance, float* t)
+	{
+		const glm::vec3 m = origin - s.center;
+		const float b = glm::dot(m, dir);
+		const float c = glm::dot(m, m) - s.r * s.r;
+		if (c <= 0)
+		{
+			*t = 0;
+			return true;
+		}
+		if (b > 0)
+		{
+			return false; // OɂĉĂ
+		}
+		const float discr = b * b - c;
+		if (discr < 0)
+		{
+			return false;
+		}
+		const float result = -b - std::sqrt(discr);
+		if (result > maxDistance)
+		{
+			return false;
+		}
+		*t = result;
+		return true;
+	}
+
+	/*
+	CƃJvZĂ邩ׂ
+
+	@param origin      C̎n_
+	@param dir         Č
+	@param c           JvZ
+	@param maxDistance C̒
+	@param t           _܂ł̋̊i[(n_c̓ɂꍇ0)
+
+	@retval true  Ă
+	@retval false ĂȂ
+
+	~Ɨ[̋̂ꂼƔ肵Ał߂_I
+	*/
+	bool IntersectRayCapsule(const glm::vec3& origin, const glm::vec3& dir,
+		const Capsule& c, float maxDistance, float* t)
+	{
+		float result = FLT_MAX;
+
+		// ~
+		const glm::vec3 ba = c.seg.b - c.seg.a;
+		const glm::vec3 oa = origin - c.seg.a;
+		const float baba = glm::dot(ba, ba);
+		const float bard = glm::dot(ba, dir);
+		const float baoa = glm::dot(ba, oa);
+		const float A = baba - bard * bard;
+		if (A > FLT_EPSILON * baba)
+		{
+			const float B = baba * glm::dot(oa, dir) - baoa * bard;
+			const float C = baba * glm::dot(oa, oa) - baoa * baoa - c.r * c.r * baba;
+			const float h = B * B - A * C;
+			if (h >= 0)
+			{
+				// n_~̊O(C > 0)ɂāA_ɂꍇ͌Ȃ
+				const float root = (-B - std::sqrt(h)) / A;
+				if (C <= 0 || root >= 0)
+				{
+					const float tc = std::max(root, 0.0f);
+					const float y = baoa + tc * bard;
+					if (y >= 0 && y <= baba)
+					{
+						result = tc;
+					}
+				}
+			}
+		}
+
+		// [̋
+		float ts;
+		if (IntersectRaySphere(origin, dir, Sphere{ c.seg.a, c.r }, maxDistance, &ts))
+		{
+			result = std::min(result, ts);
+		}
+		if (IntersectRaySphere(origin, dir, Sphere{ c.seg.b, c.r }, maxDistance, &ts))
+		{
+			result = std::min(result, ts);
+		}
+		if (result > maxDistance)
+		{
+			return false;
+		}
+		*t = result;
+		return true;
+	}
+
+	/*
+	COBBĂ邩ׂ
+
+	@param origin      C̎n_
+	@param dir         Č
+	@param obb         LE{bNX
+	@param maxDistance C̒
+	@param t           _܂ł̋̊i[(n_obb̓ɂꍇ0)
+
+	@retval true  Ă
+	@retval false ĂȂ
+
+	COBB̍WnɕϊāAẽXuƂ̌Ԃ𒲂ׂ
+	*/
+	bool IntersectRayOBB(const glm::vec3& origin, const glm::vec3& dir,
+		const OrientedBoundingBox& obb, float maxDistance, float* t)
+	{
+		const glm::vec3 p = origin - obb.center;
+		float tMin = 0;
+		float tMax = maxDistance;
+		for (int i = 0; i < 3; ++i)
+		{
+			const float o = glm::dot(p, obb.axis[i]);
+			const float d = glm::dot(dir, obb.axis[i]);
+			if (std::abs(d) < FLT_EPSILON)
+			{
+				// XuƕsȏꍇAn_XůOȂȂ
+				if (o < -obb.e[i] || o > obb.e[i])
+				{
+					return false;
+				}
+				continue;
+			}
+			const float inv = 1.0f / d;
+			float t0 = (-obb.e[i] - o) * inv;
+			float t1 = (obb.e[i] - o) * inv;
+			if (t0 > t1)
+			{
+				std::swap(t0, t1);
+			}
+			tMin = std::max(tMin, t0);
+			tMax = std::min(tMax, t1);
+			if (tMin > tMax)
+			{
+				return false;
+			}
+		}
+		*t = tMin;
+		return true;
+	}
+
+	/*
+	CƃVFCvĂ邩ׂ
+
+	@param origin      C̎n_
+	@param dir         Č(KĂ邱)
+	@param shape       VFCv
+	@param maxDistance C̒
+	@param t           _܂ł̋̊i[(n_shape̓ɂꍇ0)
+
+	@retval true  Ă
+	@retval false ĂȂ
+	*/
+	bool IntersectRayShape(const glm::vec3& origin, const glm::vec3& dir,
+		const Shape& shape, float maxDistance, float* t)
+	{
+		switch (shape.type)
+		{
+		case Shape::Type::sphere:
+			return IntersectRaySphere(origin, dir, shape.s, maxDistance, t);
+		case Shape::Type::capsule:
+			return IntersectRayCapsule(origin, dir, shape.c, maxDistance, t);
+		case Shape::Type::obb:
+			return IntersectRayOBB(origin, dir, shape.obb, maxDistance, t);
+		default:
+			return false;
+		}
+	}
+
+	/*
+	ړ鋅ƋŏɐڐG鎞𒲂ׂ
+
+	@param s      ړ鋅(ړJn̈ʒu)
+	@param move   1̍XVł̈ړ
+	@param target Î~Ă鋅
+	@param t      ڐG̊i[(ړJn0AړI1)
+	              ړJn_ŏdȂĂꍇ0
+
+	@retval true  ړɐڐG
+	@retval false ڐGȂ
+
+	target̔as̔aL΁As̒SL΂CƂ̔ɂȂ
+	*/
+	bool SweepSphereSphere(const Sphere& s, const glm::vec3& move, const Sphere& target, float* t)
+	{
+		const float length = glm::length(move);
+		const Sphere expanded{ target.center, target.r + s.r };
+		if (length <= FLT_EPSILON)
+		{
+			if (TestSphereSphere(s, target))
+			{
+				*t = 0;
+				return true;
+			}
+			return false;
+		}
+		float distance;
+		if (!IntersectRaySphere(s.center, move / length, expanded, length, &distance))
+		{
+			return false;
+		}
+		*t = distance / length;
+		return true;
+	}
+
+	/*
+	ړ鋅ƃJvZŏɐڐG鎞𒲂ׂ
+
+	@param s    ړ鋅(ړJn̈ʒu)
+	@param move 1̍XVł̈ړ
+	@param c    Î~ĂJvZ
+	@param t    ڐG̊i[(ړJn0AړI1)
+	            ړJn_ŏdȂĂꍇ0
+
+	@retval true  ړɐڐG
+	@retval false ڐGȂ
+	*/
+	bool SweepSphereCapsule(const Sphere& s, const glm::vec3& move, const Capsule& c, float* t)
+	{
+		const float length = glm::length(move);
+		const Capsule expanded{ c.seg, c.r + s.r };
+		if (length <= FLT_EPSILON)
+		{
+			glm::vec3 p;
+			if (TestSphereCapsule(s, c, &p))
+			{
+				*t = 0;
+				return true;
+			}
+			return false;
+		}
+		float distance;
+		if (!IntersectRayCapsule(s.center, move / length, expanded, length, &distance))
+		{
+			return false;
+		}
+		*t = distance / length;
+		return true;
+	}
+
+	/*
+	ړ鋅OBBŏɐڐG鎞𒲂ׂ
+
+	@param s    ړ鋅(ړJn̈ʒu)
+	@param move 1̍XVł̈ړ
+	@param obb  Î~ĂLE{bNX
+	@param t    ڐG̊i[(ړJn0AړI1)
+	            ړJn_ŏdȂĂꍇ0
+
+	@retval true  ړɐڐG
+	@retval false ڐGȂ
+
+	OBB̔ac܂p̊ۂƁA̒SL΂CƂ̔s
+	OBB̍WnŊeʂ𔼌aOɏoƔ肵A_ӂⒸ_̕t߂ɂ
+	̕ӂƂJvZƔ肵
+	*/
+	bool SweepSphereOBB(const Sphere& s, const glm::vec3& move, const OrientedBoundingBox& obb, float* t)
+	{
+		const float length = glm::length(move);
+		if (length <= FLT_EPSILON)
+		{
+			glm::vec3 p;
+			if (TestSphereOBB(s, obb, &p))
+			{
+				*t = 0;
+				return true;
+			}
+			return false;
+		}
+
+		// COBB̍Wnɕϊ
+		glm::vec3 origin, dir;
+		for (int i = 0; i < 3; ++i)
+		{
+			origin[i] = glm::dot(s.center - obb.center, obb.axis[i]);
+			dir[i] = glm::dot(move, obb.axis[i]) / length;
+		}
+		const glm::vec3 invDir = InverseDirection(dir);
+
+		const AABB box{ -obb.e - glm::vec3(s.r), obb.e + glm::vec3(s.r) };
+		float distance;
+		if (!IntersectRayAABB(origin, invDir, box, length, &distance))
+		{
+			return false;
+		}
+
+		// _̔̊Oɂ鎲𒲂ׂ(2ȏȂӂ_̕t)
+		const glm::vec3 p = origin + dir * distance;
+		glm::vec3 corner;
+		bool isOutside[3];
+		int outsideCount = 0;
+		for (int i = 0; i < 3; ++i)
+		{
+			isOutside[i] = p[i] < -obb.e[i] || p[i] > obb.e[i];
+			corner[i] = p[i] < 0 ? -obb.e[i] : obb.e[i];
+			outsideCount += isOutside[i];
+		}
+		if (outsideCount <= 1)
+		{
+			*t = distance / length;
+			return true;
+		}
+
+		// 2Oɂ鎲̕̕ӂ𒲂ׂ(_̕t߂Ȃ3{Ƃׂ)
+		float result = FLT_MAX;
+		for (int i = 0; i < 3; ++i)
+		{
+			if (!isOutside[(i + 1) % 3] || !isOutside[(i + 2) % 3])
+			{
+				continue;
+			}
+			Capsule edge{ { corner, corner }, s.r };
+			edge.seg.a[i] = -obb.e[i];
+			edge.seg.b[i] = obb.e[i];
+			float distanceEdge;
+			if (IntersectRayCapsule(origin, dir, edge, length, &distanceEdge))
+			{
+				result = std::min(result, distanceEdge);
+			}
+		}
+		if (result > length)
+		{
+			return false;
+		}
+		*t = result / length;
+		return true;
+	}
+
+	/*
+	ړ鋅ƃVFCvŏɐڐG鎞𒲂ׂ
+
+	@param s     ړ鋅(ړJn̈ʒu)
+	@param move  1̍XVł̈ړ
+	@param shape Î~ĂVFCv
+	@param t     ڐG̊i[(ړJn0AړI1)
+	             ړJn_ŏdȂĂꍇ0
+
+	@retval true  ړɐڐG
+	@retval false ڐGȂ
+	*/
+	bool SweepSphereShape(const Sphere& s, const glm::vec3& move, const Shape& shape, float* t)
+	{
+		switch (shape.type)
+		{
+		case Shape::Type::sphere:
+			return SweepSphereSphere(s, move, shape.s, t);
+		case Shape::Type::capsule:
+			return SweepSphereCapsule(s, move, shape.c, t);
+		case Shape::Type::obb:
+			return SweepSphereOBB(s, move, shape.obb, t);
+		default:
+			return false;
+		}
+	}
+
+	/*
+	XC[vEAhEv[@ŁAdȂĂAABB̑gݍ킹񋓂
+
+	@param a     AABB̔z񂻂1
+	@param b     AABB̔z񂻂2
+	@param pairs dȂĂgݍ킹̊i[
+	             ãCfbNXAb̃CfbNX̏ɕׂĕԂ
+
+	̔z1̎̍ŏWŕבւAɎoȂ
+	葤̔zŋԂdȂĂvf𒲂ׂ
+	vZʂO((n + m)log(n + m) + dȂĂgݍ킹̐)ɂȂ
+	*/
+	void SweepAndPrune(const std::vector<AABB>& a, const std::vector<AABB>& b,
+		std::vector<Pair>& pairs)
+	{
+		pairs.clear();
+		if (a.empty() || b.empty())
+		{
+			return;
+		}
+		const int axis = ChooseSweepAxis(a, b);
+		BuildSweepList(a, axis, sweepA);
+		BuildSweepList(b, axis, sweepB);
+
+		size_t ia = 0;
+		size_t ib = 0;
+		while (ia < sweepA.size() && ib < sweepB.size())
+		{
+			// ŏWقoA葤ŋԂdȂvf𒲂ׂ
+			// (l̏ꍇaɎôŁAgݍ킹x邱Ƃ͂Ȃ)
+			if (sweepA[ia].min <= sweepB[ib].min)
+			{
+				const SweepEntry& ea = sweepA[ia++];
+				for (size_t k = ib; k < sweepB.size() && sweepB[k].min <= ea.max; ++k)
+				{
+					if (TestAABBAABB(a[ea.index], b[sweepB[k].index]))
+					{
+						pairs.push_back({ ea.index, sweepB[k].index });
+					}
+				}
+			}
+			else
+			{
+				const SweepEntry& eb = sweepB[ib++];
+				for (size_t k = ia; k < sweepA.size() && sweepA[k].min <= eb.max; ++k)
+				{
+					if (TestAABBAABB(a[sweepA[k].index], b[eb.index]))
+					{
+						pairs.push_back({ sweepA[k].index, eb.index });
+					}
+				}
+			}
+		}
+
+		// ƓԂŏՓˏs悤ɕבւ
+		std::sort(pairs.begin(), pairs.end(), [](const Pair& l, const Pair& r) {
+			return l.a < r.a || (l.a == r.a && l.b < r.b);
+		});
+	}
+
+	/*
+	SẴC[̑gݍ킹𔻒肷悤ɂ
+	*/
+	void LayerMatrix::Reset()
+	{
+		for (LayerMask& e : rows)
+		{
+			e = allLayers;
+		}
+	}
+
+	/*
+	C[̑gݍ킹𔻒肷邩ǂݒ肷
+
+	@param a         C[1
+	@param b         C[2
+	@param isEnabled 肷ȂtrueAȂȂfalse
+
+	abւgݍ킹ɂݒ肪f
+	*/
+	void LayerMatrix::Set(Layer a, Layer b, bool isEnabled)
+	{
+		const int ia = static_cast<int>(a);
+		const int ib = static_cast<int>(b);
+		if (isEnabled)
+		{
+			rows[ia] |= ToMask(b);
+			rows[ib] |= ToMask(a);
+		}
+		else
+		{
+			rows[ia] &= ~ToMask(b);
+			rows[ib] &= ~ToMask(a);
+		}
+	}
+
+	/*
+	C[̑gݍ킹𔻒肷邩ׂ
+
+	@param layerA 1ڂ̃AN^[̃C[̃rbg
+	@param layerB 2ڂ̃AN^[̃C[̃rbg
+
+	@retval true  layerÂꂩ̃C[AlayerB̂ꂩ̃C[Ƃ̔Ă
+	@retval false 肵Ȃ
+	*/
+	bool LayerMatrix::Test(LayerMask layerA, LayerMask layerB) const
+	{
+		for (int i = 0; layerA != 0; ++i, layerA >>= 1)
+		{
+			if ((layerA & 1) && (rows[i] & layerB))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/*
+	݂̃}XNɑ̃C[܂܂Ă邩ׂ
+
+	@param layerA 1ڂ̃AN^[̃C[̃rbg
+	@param maskA  1ڂ̃AN^[肷鑊̃C[̃rbg
+	@param layerB 2ڂ̃AN^[̃C[̃rbg
+	@param maskB  2ڂ̃AN^[肷鑊̃C[̃rbg
+
+	@retval true  肷
+	@retval false 肵Ȃ
+	*/
+	bool TestLayerMask(LayerMask layerA, LayerMask maskA, LayerMask layerB, LayerMask maskB)
+	{
+		return (layerA & maskB) && (layerB & maskA);
+	}
 }
\ No newline at end of file
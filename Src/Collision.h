@@ -5,6 +5,8 @@
 #define COLLISION_H_INCLUDED
 #include <GL/glew.h>
 #include <glm/glm.hpp>
+#include <vector>
+#include <stdint.h>
 
 namespace Collision
 {
@@ -65,6 +67,73 @@ namespace Collision
 		OrientedBoundingBox obb; // LE{bNX̌`f[^
 	};
 
+	/*
+	sE{bNXiAABBj
+
+	u[htF[YŏՓ˂̉\gݍ킹i荞ނ߂Ɏg
+	min > max̏ꍇ͋̃{bNXŁAƂdȂȂ
+	*/
+	struct AABB
+	{
+		glm::vec3 min = glm::vec3(0); // ŏW
+		glm::vec3 max = glm::vec3(0); // őW
+	};
+
+	/*
+	u[htF[YŌgݍ킹
+	*/
+	struct Pair
+	{
+		uint32_t a = 0; // 1ڂ̔z̃CfbNX
+		uint32_t b = 0; // 2ڂ̔z̃CfbNX
+	};
+
+	/*
+	Փ˔̃C[
+
+	AN^[͏郌C[̃rbgcollisionLayerɁA肵̃C[̃rbg
+	collisionMaskɎB݂̃}XNɑ̃C[܂܂ĂāA
+	LayerMatrixŃC[̑gݍ킹ĂꍇڍׂȔs
+	*/
+	enum class Layer
+	{
+		defaultLayer, // ɎŵȂAN^[
+		terrain,      // n`(Č̑ΏۂIԂƂɎg)
+		obstacle,     // ǂ؂Ȃǂ̏Q
+		player,       // vC[
+		enemy,        // G
+		playerAttack, // vC[̍U
+		enemyAttack,  // G̍U
+		light,        // Cg(Փ˔͍sȂ)
+	};
+	using LayerMask = uint32_t;
+	const LayerMask allLayers = 0xffffffff; // SẴC[
+	const int maxLayerCount = 32;           // g郌C[̐
+
+	/*
+	C[̃rbg擾
+	*/
+	inline LayerMask ToMask(Layer layer) { return 1u << static_cast<int>(layer); }
+
+	/*
+	C[m̑gݍ킹ƂɁAՓ˔sǂێ\B
+
+	Ԃł͑SĂ̑gݍ킹𔻒肷
+	*/
+	class LayerMatrix
+	{
+	public:
+		LayerMatrix() { Reset(); }
+		void Reset();
+		void Set(Layer a, Layer b, bool isEnabled);
+		bool Test(LayerMask layerA, LayerMask layerB) const;
+
+	private:
+		LayerMask rows[maxLayerCount]; // C[Ƃ́A肷鑊̃C[̃rbg
+	};
+
+	bool TestLayerMask(LayerMask layerA, LayerMask maskA, LayerMask layerB, LayerMask maskB);
+
 	// `쐬֐
 	Shape CreateSphere(const glm::vec3&, float);
 	Shape CreateCapsule(const glm::vec3&, const glm::vec3&, float);
@@ -74,9 +143,41 @@ namespace Collision
 	bool TestSphereSphere(const Sphere&, const Sphere&);
 	bool TestSphereCapsule(const Sphere& s, const Capsule& c, glm::vec3* p);
 	bool TestSphereOBB(const Sphere& s, const OrientedBoundingBox& obb, glm::vec3* p);
+	bool TestCapsuleCapsule(const Capsule& c0, const Capsule& c1, glm::vec3* p0, glm::vec3* p1);
+	bool TestCapsuleOBB(const Capsule& c, const OrientedBoundingBox& obb, glm::vec3* pc, glm::vec3* pb);
+	bool TestOBBOBB(const OrientedBoundingBox& a, const OrientedBoundingBox& b,
+		glm::vec3* pa, glm::vec3* pb);
 	bool TestShapeShape(const Shape&, const Shape&, glm::vec3* pa, glm::vec3* pb);
+	AABB CalcAABB(const Shape&);
+	bool TestAABBAABB(const AABB&, const AABB&);
+	void SweepAndPrune(const std::vector<AABB>& a, const std::vector<AABB>& b,
+		std::vector<Pair>& pairs);
 	glm::vec3 ClosestPointSegment(const Segment& seg, const glm::vec3& p);
+	float ClosestPointSegmentSegment(const Segment& s0, const Segment& s1,
+		glm::vec3* p0, glm::vec3* p1);
 	glm::vec3 ClosetPointOBB(const OrientedBoundingBox& obb, const glm::vec3& p);
+	glm::vec3 ClosestPointShape(const Shape& shape, const glm::vec3& p);
+	float DistanceSqAABB(const AABB& box, const glm::vec3& p);
+	glm::vec3 SurfaceNormalShape(const Shape& shape, const glm::vec3& p);
+
+	// C(dir͐KĂ邱)
+	glm::vec3 InverseDirection(const glm::vec3& dir);
+	bool IntersectRayAABB(const glm::vec3& origin, const glm::vec3& invDir,
+		const AABB& box, float maxDistance, float* t);
+	bool IntersectRaySphere(const glm::vec3& origin, const glm::vec3& dir,
+		const Sphere& s, float maxDistance, float* t);
+	bool IntersectRayCapsule(const glm::vec3& origin, const glm::vec3& dir,
+		const Capsule& c, float maxDistance, float* t);
+	bool IntersectRayOBB(const glm::vec3& origin, const glm::vec3& dir,
+		const OrientedBoundingBox& obb, float maxDistance, float* t);
+	bool IntersectRayShape(const glm::vec3& origin, const glm::vec3& dir,
+		const Shape& shape, float maxDistance, float* t);
+
+	// ړ鋅̏Փˎ(move1̍XVł̈ړʁAt0`1)
+	bool SweepSphereSphere(const Sphere& s, const glm::vec3& move, const Sphere& target, float* t);
+	bool SweepSphereCapsule(const Sphere& s, const glm::vec3& move, const Capsule& c, float* t);
+	bool SweepSphereOBB(const Sphere& s, const glm::vec3& move, const OrientedBoundingBox& obb, float* t);
+	bool SweepSphereShape(const Sphere& s, const glm::vec3& move, const Shape& shape, float* t);
 } // namespace Collision
 
 #endif // !COLLISION_H_INCLUDED
@@ -0,0 +1,427 @@
+/*
+@file CollisionBatch.cpp
+*/
+#include "CollisionBatch.h"
+#include <string.h>
+
+// gpSIMD߂߂(COLLISION_BATCH_SCALAR`SIMD߂gȂ)
+#if !defined(COLLISION_BATCH_SCALAR)
+#if defined(__AVX__)
+#define COLLISION_BATCH_AVX
+#include <immintrin.h>
+#elif defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || \
+	(defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define COLLISION_BATCH_SSE
+#include <xmmintrin.h>
+#endif
+#endif
+
+namespace /* unnamed */ {
+
+/*
+1vfvZ^
+
+SIMD^Ɠ֐pӂāA菈1̃ev[gŏ悤ɂ
+*/
+struct Float1
+{
+	static const int width = 1;
+	float v;
+
+	static Float1 Set(float f) { return { f }; }
+	static Float1 Load(const float* p) { return { *p }; }
+	void Store(float* p) const { *p = v; }
+};
+struct Mask1
+{
+	bool v;
+};
+inline Float1 operator+(Float1 a, Float1 b) { return { a.v + b.v }; }
+inline Float1 operator-(Float1 a, Float1 b) { return { a.v - b.v }; }
+inline Float1 operator*(Float1 a, Float1 b) { return { a.v * b.v }; }
+inline Float1 operator/(Float1 a, Float1 b) { return { a.v / b.v }; }
+inline Float1 Min(Float1 a, Float1 b) { return { b.v < a.v ? b.v : a.v }; }
+inline Float1 Max(Float1 a, Float1 b) { return { b.v > a.v ? b.v : a.v }; }
+inline Mask1 LessEqual(Float1 a, Float1 b) { return { a.v <= b.v }; }
+inline Mask1 GreaterEqual(Float1 a, Float1 b) { return { a.v >= b.v }; }
+inline Float1 Select(Mask1 m, Float1 a, Float1 b) { return m.v ? a : b; }
+inline uint32_t MoveMask(Mask1 m) { return m.v ? 1u : 0u; }
+
+#if defined(COLLISION_BATCH_SSE)
+/*
+4vfvZ^(SSE)
+*/
+struct Float4
+{
+	static const int width = 4;
+	__m128 v;
+
+	static Float4 Set(float f) { return { _mm_set1_ps(f) }; }
+	static Float4 Load(const float* p) { return { _mm_loadu_ps(p) }; }
+	void Store(float* p) const { _mm_storeu_ps(p, v); }
+};
+struct Mask4
+{
+	__m128 v;
+};
+inline Float4 operator+(Float4 a, Float4 b) { return { _mm_add_ps(a.v, b.v) }; }
+inline Float4 operator-(Float4 a, Float4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+inline Float4 operator*(Float4 a, Float4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+inline Float4 operator/(Float4 a, Float4 b) { return { _mm_div_ps(a.v, b.v) }; }
+inline Float4 Min(Float4 a, Float4 b) { return { _mm_min_ps(a.v, b.v) }; }
+inline Float4 Max(Float4 a, Float4 b) { return { _mm_max_ps(a.v, b.v) }; }
+inline Mask4 LessEqual(Float4 a, Float4 b) { return { _mm_cmple_ps(a.v, b.v) }; }
+inline Mask4 GreaterEqual(Float4 a, Float4 b) { return { _mm_cmpge_ps(a.v, b.v) }; }
+inline Float4 Select(Mask4 m, Float4 a, Float4 b)
+{
+	return { _mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v)) };
+}
+inline uint32_t MoveMask(Mask4 m) { return static_cast<uint32_t>(_mm_movemask_ps(m.v)); }
+using FloatN = Float4;
+#elif defined(COLLISION_BATCH_AVX)
+/*
+8vfvZ^(AVX)
+*/
+struct Float8
+{
+	static const int width = 8;
+	__m256 v;
+
+	static Float8 Set(float f) { return { _mm256_set1_ps(f) }; }
+	static Float8 Load(const float* p) { return { _mm256_loadu_ps(p) }; }
+	void Store(float* p) const { _mm256_storeu_ps(p, v); }
+};
+struct Mask8
+{
+	__m256 v;
+};
+inline Float8 operator+(Float8 a, Float8 b) { return { _mm256_add_ps(a.v, b.v) }; }
+inline Float8 operator-(Float8 a, Float8 b) { return { _mm256_sub_ps(a.v, b.v) }; }
+inline Float8 operator*(Float8 a, Float8 b) { return { _mm256_mul_ps(a.v, b.v) }; }
+inline Float8 operator/(Float8 a, Float8 b) { return { _mm256_div_ps(a.v, b.v) }; }
+inline Float8 Min(Float8 a, Float8 b) { return { _mm256_min_ps(a.v, b.v) }; }
+inline Float8 Max(Float8 a, Float8 b) { return { _mm256_max_ps(a.v, b.v) }; }
+inline Mask8 LessEqual(Float8 a, Float8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; }
+inline Mask8 GreaterEqual(Float8 a, Float8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ) }; }
+inline Float8 Select(Mask8 m, Float8 a, Float8 b) { return { _mm256_blendv_ps(b.v, a.v, m.v) }; }
+inline uint32_t MoveMask(Mask8 m) { return static_cast<uint32_t>(_mm256_movemask_ps(m.v)); }
+using FloatN = Float8;
+#else
+using FloatN = Float1;
+#endif
+
+/*
+SIMD^̊evfW̔zɏ
+*/
+template<typename F>
+void StorePoints(F x, F y, F z, glm::vec3* p)
+{
+	float bx[F::width], by[F::width], bz[F::width];
+	x.Store(bx);
+	y.Store(by);
+	z.Store(bz);
+	for (int i = 0; i < F::width; ++i)
+	{
+		p[i] = glm::vec3(bx[i], by[i], bz[i]);
+	}
+}
+
+/*
+茋ʂrbg}XNɏ
+
+@param hitMask rbg}XN
+@param i       擪̗vf̃CfbNX
+@param bits    F::width̔茋
+*/
+void WriteBits(uint32_t* hitMask, size_t i, uint32_t bits)
+{
+	hitMask[i / 32] |= bits << (i % 32);
+}
+
+/*
+rbg1̐𐔂
+*/
+size_t CountBits(uint32_t bits)
+{
+	size_t n = 0;
+	for (; bits; bits &= bits - 1)
+	{
+		++n;
+	}
+	return n;
+}
+
+/*
+Ƌ𔻒肷(TestSphereSphereƓvZ)
+*/
+template<typename F>
+uint32_t SphereSphereKernel(const Collision::Sphere& s, const Collision::SphereSoA& b,
+	size_t i, glm::vec3* p)
+{
+	const F bx = F::Load(&b.x[i]);
+	const F by = F::Load(&b.y[i]);
+	const F bz = F::Load(&b.z[i]);
+	const F mx = F::Set(s.center.x) - bx;
+	const F my = F::Set(s.center.y) - by;
+	const F mz = F::Set(s.center.z) - bz;
+	const F radiusSum = F::Set(s.r) + F::Load(&b.r[i]);
+	const F d2 = mx * mx + my * my + mz * mz;
+	StorePoints(bx, by, bz, p + i);
+	return MoveMask(LessEqual(d2, radiusSum * radiusSum));
+}
+
+/*
+ƃJvZ𔻒肷(TestSphereCapsuleƓvZ)
+*/
+template<typename F>
+uint32_t SphereCapsuleKernel(const Collision::Sphere& s, const Collision::CapsuleSoA& b,
+	size_t i, glm::vec3* p)
+{
+	const F sx = F::Set(s.center.x);
+	const F sy = F::Set(s.center.y);
+	const F sz = F::Set(s.center.z);
+	const F ax = F::Load(&b.ax[i]);
+	const F ay = F::Load(&b.ay[i]);
+	const F az = F::Load(&b.az[i]);
+	const F bx = F::Load(&b.bx[i]);
+	const F by = F::Load(&b.by[i]);
+	const F bz = F::Load(&b.bz[i]);
+
+	// ̍ŋߐړ_(ClosestPointSegmentƓA[ł͒[_̂̂I)
+	const F abx = bx - ax;
+	const F aby = by - ay;
+	const F abz = bz - az;
+	const F lenAQ = abx * (sx - ax) + aby * (sy - ay) + abz * (sz - az);
+	const F lenAB = abx * abx + aby * aby + abz * abz;
+	const F t = lenAQ / lenAB;
+	const auto isA = LessEqual(lenAQ, F::Set(0));
+	const auto isB = GreaterEqual(lenAQ, lenAB);
+	const F qx = Select(isA, ax, Select(isB, bx, ax + abx * t));
+	const F qy = Select(isA, ay, Select(isB, by, ay + aby * t));
+	const F qz = Select(isA, az, Select(isB, bz, az + abz * t));
+
+	const F dx = qx - sx;
+	const F dy = qy - sy;
+	const F dz = qz - sz;
+	const F radiusSum = F::Set(s.r) + F::Load(&b.r[i]);
+	StorePoints(qx, qy, qz, p + i);
+	return MoveMask(LessEqual(dx * dx + dy * dy + dz * dz, radiusSum * radiusSum));
+}
+
+/*
+OBB𔻒肷(TestSphereOBBƓvZ)
+*/
+template<typename F>
+uint32_t SphereOBBKernel(const Collision::Sphere& s, const Collision::OBBSoA& b,
+	size_t i, glm::vec3* p)
+{
+	const F sx = F::Set(s.center.x);
+	const F sy = F::Set(s.center.y);
+	const F sz = F::Set(s.center.z);
+	const F cx = F::Load(&b.cx[i]);
+	const F cy = F::Load(&b.cy[i]);
+	const F cz = F::Load(&b.cz[i]);
+	const F dx = sx - cx;
+	const F dy = sy - cy;
+	const F dz = sz - cz;
+	const float* const e[3] = { &b.ex[i], &b.ey[i], &b.ez[i] };
+
+	// eɓe𔼌a͈̔͂Ɏ߂āAŋߐړ_߂
+	F qx = cx;
+	F qy = cy;
+	F qz = cz;
+	for (int k = 0; k < 3; ++k)
+	{
+		const F ux = F::Load(&b.axis[k][0][i]);
+		const F uy = F::Load(&b.axis[k][1][i]);
+		const F uz = F::Load(&b.axis[k][2][i]);
+		const F ek = F::Load(e[k]);
+		F distance = dx * ux + dy * uy + dz * uz;
+		distance = Max(Min(distance, ek), F::Set(0) - ek);
+		qx = qx + distance * ux;
+		qy = qy + distance * uy;
+		qz = qz + distance * uz;
+	}
+	const F vx = qx - sx;
+	const F vy = qy - sy;
+	const F vz = qz - sz;
+	const F r = F::Set(s.r);
+	StorePoints(qx, qy, qz, p + i);
+	return MoveMask(LessEqual(vx * vx + vy * vy + vz * vz, r * r));
+}
+
+/*
+SIMD^ňꊇ肵A[1vf肷
+
+@param n       肷vf
+@param hitMask 茋ʂ̊i[
+@param kernelN SIMD^̔֐
+@param kernel1 1vf̔֐
+
+@return Փ˂Ăvf
+*/
+template<typename KN, typename K1>
+size_t RunBatch(size_t n, uint32_t* hitMask, KN kernelN, K1 kernel1)
+{
+	memset(hitMask, 0, sizeof(uint32_t) * ((n + 31) / 32));
+	size_t hitCount = 0;
+	size_t i = 0;
+	for (; i + FloatN::width <= n; i += FloatN::width)
+	{
+		const uint32_t bits = kernelN(i);
+		WriteBits(hitMask, i, bits);
+		hitCount += CountBits(bits);
+	}
+	for (; i < n; ++i)
+	{
+		const uint32_t bits = kernel1(i);
+		WriteBits(hitMask, i, bits);
+		hitCount += bits;
+	}
+	return hitCount;
+}
+
+} // unnamed namespace
+
+namespace Collision
+{
+	/*
+	zɂ
+	*/
+	void SphereSoA::Clear()
+	{
+		x.clear(); y.clear(); z.clear();
+		r.clear();
+	}
+
+	/*
+	ǉ
+	*/
+	void SphereSoA::Push(const Sphere& s)
+	{
+		x.push_back(s.center.x); y.push_back(s.center.y); z.push_back(s.center.z);
+		r.push_back(s.r);
+	}
+
+	/*
+	zɂ
+	*/
+	void CapsuleSoA::Clear()
+	{
+		ax.clear(); ay.clear(); az.clear();
+		bx.clear(); by.clear(); bz.clear();
+		r.clear();
+	}
+
+	/*
+	JvZǉ
+	*/
+	void CapsuleSoA::Push(const Capsule& c)
+	{
+		ax.push_back(c.seg.a.x); ay.push_back(c.seg.a.y); az.push_back(c.seg.a.z);
+		bx.push_back(c.seg.b.x); by.push_back(c.seg.b.y); bz.push_back(c.seg.b.z);
+		r.push_back(c.r);
+	}
+
+	/*
+	zɂ
+	*/
+	void OBBSoA::Clear()
+	{
+		cx.clear(); cy.clear(); cz.clear();
+		for (auto& a : axis)
+		{
+			for (auto& e : a)
+			{
+				e.clear();
+			}
+		}
+		ex.clear(); ey.clear(); ez.clear();
+	}
+
+	/*
+	LE{bNXǉ
+	*/
+	void OBBSoA::Push(const OrientedBoundingBox& obb)
+	{
+		cx.push_back(obb.center.x); cy.push_back(obb.center.y); cz.push_back(obb.center.z);
+		for (int i = 0; i < 3; ++i)
+		{
+			for (int j = 0; j < 3; ++j)
+			{
+				axis[i][j].push_back(obb.axis[i][j]);
+			}
+		}
+		ex.push_back(obb.e.x); ey.push_back(obb.e.y); ez.push_back(obb.e.z);
+	}
+
+	/*
+	ƕ̋Փ˂Ă邩ׂ
+
+	@param s       
+	@param b       Ώۂ̋̔z
+	@param hitMask 茋ʂ̊i[
+	@param p       Ώۂ̋̒SW̊i[
+
+	@return Փ˂Ăvf
+	*/
+	size_t TestSphereSphereBatch(const Sphere& s, const SphereSoA& b,
+		uint32_t* hitMask, glm::vec3* p)
+	{
+		return RunBatch(b.Size(), hitMask,
+			[&](size_t i) { return SphereSphereKernel<FloatN>(s, b, i, p); },
+			[&](size_t i) { return SphereSphereKernel<Float1>(s, b, i, p); });
+	}
+
+	/*
+	ƕ̃JvZՓ˂Ă邩ׂ
+
+	@param s       
+	@param b       Ώۂ̃JvZ̔z
+	@param hitMask 茋ʂ̊i[
+	@param p       JvZ̐̍ŋߐړ_̊i[
+
+	@return Փ˂Ăvf
+	*/
+	size_t TestSphereCapsuleBatch(const Sphere& s, const CapsuleSoA& b,
+		uint32_t* hitMask, glm::vec3* p)
+	{
+		return RunBatch(b.Size(), hitMask,
+			[&](size_t i) { return SphereCapsuleKernel<FloatN>(s, b, i, p); },
+			[&](size_t i) { return SphereCapsuleKernel<Float1>(s, b, i, p); });
+	}
+
+	/*
+	ƕ̗LE{bNXՓ˂Ă邩ׂ
+
+	@param s       
+	@param b       Ώۂ̗LE{bNX̔z
+	@param hitMask 茋ʂ̊i[
+	@param p       LE{bNX̍ŋߐړ_̊i[
+
+	@return Փ˂Ăvf
+	*/
+	size_t TestSphereOBBBatch(const Sphere& s, const OBBSoA& b,
+		uint32_t* hitMask, glm::vec3* p)
+	{
+		return RunBatch(b.Size(), hitMask,
+			[&](size_t i) { return SphereOBBKernel<FloatN>(s, b, i, p); },
+			[&](size_t i) { return SphereOBBKernel<Float1>(s, b, i, p); });
+	}
+
+	/*
+	ꊇɎg閽߃Zbg̖O擾
+
+	@return "AVX"A"SSE"A"Scalar"̂ꂩ
+	*/
+	const char* BatchInstructionSet()
+	{
+#if defined(COLLISION_BATCH_AVX)
+		return "AVX";
+#elif defined(COLLISION_BATCH_SSE)
+		return "SSE";
+#else
+		return "Scalar";
+#endif
+	}
+} // namespace Collision
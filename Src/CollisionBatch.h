@@ -0,0 +1,70 @@
+/*
+@file CollisionBatch.h
+*/
+#ifndef COLLISIONBATCH_H_INCLUDED
+#define COLLISIONBATCH_H_INCLUDED
+#include "Collision.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+1̋Ƒ̌`܂Ƃ߂Ĕ肷֐Q
+
+葊͗vfƂ̔z(SoA)ɋl߂ēn
+SIMD߂gꍇ4(SSE)܂8(AVX)ɔ肵A
+[ƁASIMD߂gȂł1肷
+茋ʂTestSphereSphere()ȂǂƓɂȂ
+
+ʂ̓rbg}XNŕԂBiԖڂ̗vfƏՓ˂ĂhitMask[i / 32](i % 32)rbgڂ1ɂȂ
+hitMaskɂ(vf + 31) / 32Apɂ͗vfԂ̗̈悪Kv
+*/
+namespace Collision
+{
+	// ̔z
+	struct SphereSoA
+	{
+		std::vector<float> x, y, z; // SW
+		std::vector<float> r;       // a
+
+		void Clear();
+		void Push(const Sphere&);
+		size_t Size() const { return r.size(); }
+	};
+
+	// JvZ̔z
+	struct CapsuleSoA
+	{
+		std::vector<float> ax, ay, az; // ̎n_
+		std::vector<float> bx, by, bz; // ̏I_
+		std::vector<float> r;          // a
+
+		void Clear();
+		void Push(const Capsule&);
+		size_t Size() const { return r.size(); }
+	};
+
+	// LE{bNX̔z
+	struct OBBSoA
+	{
+		std::vector<float> cx, cy, cz;       // SW
+		std::vector<float> axis[3][3];       // axis[][] ě
+		std::vector<float> ex, ey, ez;       // e̔a
+
+		void Clear();
+		void Push(const OrientedBoundingBox&);
+		size_t Size() const { return cx.size(); }
+	};
+
+	size_t TestSphereSphereBatch(const Sphere& s, const SphereSoA& b,
+		uint32_t* hitMask, glm::vec3* p);
+	size_t TestSphereCapsuleBatch(const Sphere& s, const CapsuleSoA& b,
+		uint32_t* hitMask, glm::vec3* p);
+	size_t TestSphereOBBBatch(const Sphere& s, const OBBSoA& b,
+		uint32_t* hitMask, glm::vec3* p);
+
+	const char* BatchInstructionSet();
+} // namespace Collision
+
+#endif // !COLLISIONBATCH_H_INCLUDED
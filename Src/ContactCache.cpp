@@ -0,0 +1,369 @@
+/*
+@file ContactCache.cpp
+*/
+#include "ContactCache.h"
+#include "Actor.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace /* unnamed */ {
+
+const float moveTolerance = 0.001f;    // ĂȂƂ݂ȂʒuƉ]̕ω
+const float velocityTolerance = 0.01f; // ~܂ĂƂ݂Ȃx
+const uint32_t framesToSleep = 30;     // ܂łɐÎ~ĂKvt[
+
+/*
+2̃xNg̍eׂ͈͓
+*/
+bool IsNear(const glm::vec3& a, const glm::vec3& b)
+{
+	const glm::vec3 d = glm::abs(a - b);
+	return d.x <= moveTolerance && d.y <= moveTolerance && d.z <= moveTolerance;
+}
+
+/*
+2̏Փˌ`̍eׂ͈͓
+*/
+bool IsNear(const Collision::Shape& a, const Collision::Shape& b)
+{
+	if (a.type != b.type)
+	{
+		return false;
+	}
+	switch (a.type)
+	{
+	case Collision::Shape::Type::sphere:
+		return IsNear(a.s.center, b.s.center) && std::abs(a.s.r - b.s.r) <= moveTolerance;
+	case Collision::Shape::Type::capsule:
+		return IsNear(a.c.seg.a, b.c.seg.a) && IsNear(a.c.seg.b, b.c.seg.b) &&
+			std::abs(a.c.r - b.c.r) <= moveTolerance;
+	case Collision::Shape::Type::obb:
+		return IsNear(a.obb.center, b.obb.center) && IsNear(a.obb.e, b.obb.e) &&
+			IsNear(a.obb.axis[0], b.obb.axis[0]) && IsNear(a.obb.axis[1], b.obb.axis[1]) &&
+			IsNear(a.obb.axis[2], b.obb.axis[2]);
+	default:
+		return true;
+	}
+}
+
+/*
+union-find̍T(oH𔼕ɏk߂Ȃ炽ǂ)
+*/
+uint32_t FindRoot(std::vector<uint32_t>& parent, uint32_t i)
+{
+	while (parent[i] != i)
+	{
+		parent[i] = parent[parent[i]];
+		i = parent[i];
+	}
+	return i;
+}
+
+} // unnamed namespace
+
+/*
+L[̃nbVlvZ
+*/
+size_t ContactCache::KeyHash::operator()(const Key& key) const
+{
+	size_t h = std::hash<const Actor*>()(key.a);
+	h ^= std::hash<const Actor*>()(key.b) + 0x9e3779b9 + (h << 6) + (h >> 2);
+	h ^= std::hash<uint32_t>()(key.tag) + 0x9e3779b9 + (h << 6) + (h >> 2);
+	return h;
+}
+
+/*
+t[̊Jn
+
+Õt[ŎgȂL^菜A
+Փ˂Ăgݍ킹ACh蒼āA点邩ǂ߂
+*/
+void ContactCache::BeginFrame()
+{
+	for (auto i = contacts.begin(); i != contacts.end();)
+	{
+		if (i->second.frame != frame)
+		{
+			i = contacts.erase(i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+	for (auto i = bodies.begin(); i != bodies.end();)
+	{
+		if (i->second.frame != frame)
+		{
+			i = bodies.erase(i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	// AN^[ɔԍUunion-findŃAChɂ܂Ƃ߂
+	thread_local std::vector<const Actor*> actors;
+	thread_local std::vector<uint32_t> parent;
+	actors.clear();
+	parent.clear();
+	for (auto& e : bodies)
+	{
+		e.second.island = static_cast<uint32_t>(actors.size());
+		parent.push_back(static_cast<uint32_t>(actors.size()));
+		actors.push_back(e.first);
+	}
+	for (const auto& e : contacts)
+	{
+		const Contact& c = e.second;
+		if (!c.isHit || c.isStaticB || e.first.tag != 0)
+		{
+			continue;
+		}
+		const auto a = bodies.find(e.first.a);
+		const auto b = bodies.find(e.first.b);
+		if (a == bodies.end() || b == bodies.end())
+		{
+			continue;
+		}
+		const uint32_t ra = FindRoot(parent, a->second.island);
+		const uint32_t rb = FindRoot(parent, b->second.island);
+		if (ra != rb)
+		{
+			parent[std::max(ra, rb)] = std::min(ra, rb);
+		}
+	}
+
+	// ̔ԍACh̔ԍɕtւ
+	thread_local std::vector<uint32_t> islandIndex;
+	islandIndex.assign(actors.size(), UINT32_MAX);
+	for (auto& e : islands)
+	{
+		e.clear();
+	}
+	uint32_t islandCount = 0;
+	for (size_t i = 0; i < actors.size(); ++i)
+	{
+		const uint32_t root = FindRoot(parent, static_cast<uint32_t>(i));
+		if (islandIndex[root] == UINT32_MAX)
+		{
+			islandIndex[root] = islandCount++;
+			if (islands.size() < islandCount)
+			{
+				islands.emplace_back();
+			}
+		}
+		Body& body = bodies[actors[i]];
+		body.island = islandIndex[root];
+		islands[body.island].push_back(actors[i]);
+	}
+	islands.resize(islandCount);
+
+	// S\ȎԐÎ~ĂACh𖰂点
+	for (const auto& island : islands)
+	{
+		bool isIdle = true;
+		for (const Actor* p : island)
+		{
+			if (bodies[p].idleFrames < framesToSleep)
+			{
+				isIdle = false;
+				break;
+			}
+		}
+		for (const Actor* p : island)
+		{
+			bodies[p].isSleeping = isIdle;
+		}
+	}
+
+	++frame;
+}
+
+/*
+SĂ̋L^
+*/
+void ContactCache::Clear()
+{
+	contacts.clear();
+	bodies.clear();
+	islands.clear();
+}
+
+/*
+gݍ킹̋L^擾
+
+@param a   AN^[1
+@param b   AN^[2
+@param tag gݍ킹ʂ邽߂̒l
+
+@return gݍ킹̋L^(Ȃ΍쐬)
+        QƂBeginFrame()Clear()ĂԂ܂ŗL
+*/
+ContactCache::Contact& ContactCache::Find(const Actor* a, const Actor* b, uint32_t tag)
+{
+	Contact& c = contacts[Key{ a, b, tag }];
+	c.frame = frame;
+	return c;
+}
+
+/*
+L^茋ʂg邩ׂ
+
+@param c gݍ킹̋L^
+@param a ݂ȁՓˌ`
+@param b ݂b̏Փˌ`
+
+@retval true  ǂ̌`O̔肩狖e͈͓ωĂȂ
+@retval false 肵Kv
+*/
+bool ContactCache::IsReusable(const Contact& c, const Collision::Shape& a, const Collision::Shape& b)
+{
+	return c.isValid && IsNear(c.shapeA, a) && IsNear(c.shapeB, b);
+}
+
+/*
+茋ʂL^
+
+@param c     gݍ킹̋L^
+@param a     ɎgȁՓˌ`
+@param b     Ɏgb̏Փˌ`
+@param isHit Փ˂Ătrue
+@param pa    ՓˍW(a)
+@param pb    ՓˍW(b)
+*/
+void ContactCache::Store(Contact& c, const Collision::Shape& a, const Collision::Shape& b,
+	bool isHit, const glm::vec3& pa, const glm::vec3& pb)
+{
+	c.shapeA = a;
+	c.shapeB = b;
+	c.isHit = isHit;
+	c.pa = pa;
+	c.pb = pb;
+	c.isValid = true;
+}
+
+/*
+L^gďՓ˔s
+
+@param a      AN^[1
+@param shapeA ɎgȁՓˌ`
+@param b      AN^[2
+@param shapeB Ɏgb̏Փˌ`
+@param pa     ՓˍW(a)̊i[
+@param pb     ՓˍW(b)̊i[
+@param tag    gݍ킹ʂ邽߂̒l
+
+@retval true  Փ˂Ă
+@retval false Փ˂ĂȂ
+
+ǂ̌`O񂩂瓮ĂȂ΁AǑʂԂ
+*/
+bool ContactCache::Test(const Actor* a, const Collision::Shape& shapeA,
+	const Actor* b, const Collision::Shape& shapeB,
+	glm::vec3* pa, glm::vec3* pb, uint32_t tag)
+{
+	Contact& c = Find(a, b, tag);
+	if (!IsReusable(c, shapeA, shapeB))
+	{
+		glm::vec3 qa(0), qb(0);
+		const bool isHit = Collision::TestShapeShape(shapeA, shapeB, &qa, &qb);
+		Store(c, shapeA, shapeB, isHit, qa, qb);
+	}
+	*pa = c.pa;
+	*pb = c.pb;
+	return c.isHit;
+}
+
+/*
+AN^[̐Î~ԂXV
+
+@param actor Փ˔ɎgAN^[
+
+1t[ɉxĂяoĂAŏ1񂾂
+ĂÎ~ԂZbgAĂ΃AChƋN
+*/
+void ContactCache::Touch(const Actor* actor)
+{
+	auto result = bodies.emplace(actor, Body());
+	Body& body = result.first->second;
+	if (body.frame == frame)
+	{
+		return;
+	}
+	body.frame = frame;
+	const bool isMoving = result.second ||
+		!IsNear(body.restPosition, actor->position) ||
+		!IsNear(body.restRotation, actor->rotation) ||
+		glm::dot(actor->velocity, actor->velocity) > velocityTolerance * velocityTolerance;
+	if (!isMoving)
+	{
+		++body.idleFrames;
+		return;
+	}
+	body.restPosition = actor->position;
+	body.restRotation = actor->rotation;
+	body.idleFrames = 0;
+	if (body.isSleeping)
+	{
+		Wake(actor);
+	}
+}
+
+/*
+AN^[Ă邩ׂ
+*/
+bool ContactCache::IsSleeping(const Actor* actor) const
+{
+	const auto i = bodies.find(actor);
+	return i != bodies.end() && i->second.isSleeping;
+}
+
+/*
+AN^[AChN
+
+@param actor NAN^[
+
+ACh̑S̐Î~ԂZbĝŁAȂƂframesToSleept[͖Ȃ
+*/
+void ContactCache::Wake(const Actor* actor)
+{
+	const auto i = bodies.find(actor);
+	if (i == bodies.end())
+	{
+		return;
+	}
+	if (i->second.island >= islands.size())
+	{
+		i->second.isSleeping = false;
+		i->second.idleFrames = 0;
+		return;
+	}
+	for (const Actor* p : islands[i->second.island])
+	{
+		const auto j = bodies.find(p);
+		if (j != bodies.end())
+		{
+			j->second.isSleeping = false;
+			j->second.idleFrames = 0;
+		}
+	}
+}
+
+/*
+ĂAN^[̐擾
+*/
+size_t ContactCache::SleepingCount() const
+{
+	size_t count = 0;
+	for (const auto& e : bodies)
+	{
+		if (e.second.isSleeping)
+		{
+			++count;
+		}
+	}
+	return count;
+}
@@ -0,0 +1,104 @@
+/*
+@file ContactCache.h
+*/
+#ifndef CONTACTCACHE_H_INCLUDED
+#define CONTACTCACHE_H_INCLUDED
+#include "Collision.h"
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+class Actor;
+
+/*
+t[܂ŏՓ˔̌ʂێNX
+
+AN^[̑gݍ킹ƂɁAȌڍהɎgՓˌ`ƌʂL^
+ǂ̌`قƂǓĂȂ΁AڍהȗđǑʂg
+
+ڐGĂAN^[̏W܂(ACh)SĈt[Î~Ă疰点A
+ĂAN^[m(܂͖ĂAN^[ƓȂXg̃AN^[)̑gݍ킹
+莩̂ȗ
+ĂAN^[ANĂAN^[ƐڐGƁAAChŜN
+
+L[̓AN^[̃AhXȂ̂ŁAjꂽAN^[̋L^͂ɂ͏Ȃ
+Õt[ŎgȂL^BeginFrame()ł܂Ƃ߂Ď菜
+BeginFrame()͖t[AՓ˔̑OɌĂяo
+CXbĥݎg
+*/
+class ContactCache
+{
+public:
+	// gݍ킹Ƃ̋L^
+	struct Contact
+	{
+		Collision::Shape shapeA;     // O񔻒肵ƂȁՓˌ`
+		Collision::Shape shapeB;     // O񔻒肵Ƃb̏Փˌ`
+		glm::vec3 pa = glm::vec3(0); // ȌՓˍW(a)
+		glm::vec3 pb = glm::vec3(0); // ȌՓˍW(b)
+		uint32_t frame = 0;          // ŌɎgꂽt[
+		bool isValid = false;        // 茋ʂL^ς݂Ȃtrue
+		bool isHit = false;          // O̔ŏՓ˂Ătrue
+		bool isStaticB = false;      // bȂXg̃AN^[Ȃtrue(AChɊ܂߂Ȃ)
+	};
+
+	ContactCache() = default;
+	~ContactCache() = default;
+	ContactCache(const ContactCache&) = delete;
+	ContactCache& operator=(const ContactCache&) = delete;
+
+	void BeginFrame();
+	void Clear();
+
+	Contact& Find(const Actor* a, const Actor* b, uint32_t tag = 0);
+	static bool IsReusable(const Contact& c, const Collision::Shape& a, const Collision::Shape& b);
+	static void Store(Contact& c, const Collision::Shape& a, const Collision::Shape& b,
+		bool isHit, const glm::vec3& pa, const glm::vec3& pb);
+	bool Test(const Actor* a, const Collision::Shape& shapeA,
+		const Actor* b, const Collision::Shape& shapeB,
+		glm::vec3* pa, glm::vec3* pb, uint32_t tag = 0);
+
+	void Touch(const Actor* actor);
+	bool IsSleeping(const Actor* actor) const;
+	void Wake(const Actor* actor);
+
+	size_t ContactCount() const { return contacts.size(); }
+	size_t SleepingCount() const;
+
+private:
+	// L^̃L[(gݍ킹ʂ̖ړIŔ肷ꍇtagŋʂ)
+	struct Key
+	{
+		const Actor* a;
+		const Actor* b;
+		uint32_t tag;
+		bool operator==(const Key& other) const
+		{
+			return a == other.a && b == other.b && tag == other.tag;
+		}
+	};
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const;
+	};
+
+	// AN^[Ƃ̐Î~
+	struct Body
+	{
+		glm::vec3 restPosition = glm::vec3(0); // Î~n߂Ƃ̈ʒu
+		glm::vec3 restRotation = glm::vec3(0); // Î~n߂Ƃ̉]
+		uint32_t idleFrames = 0;  // Î~Ăt[
+		uint32_t frame = 0;       // ŌTouch()t[
+		uint32_t island = UINT32_MAX; // ACh(islands̃CfbNXBȂUINT32_MAX)
+		bool isSleeping = false;  // Ătrue
+	};
+
+	std::unordered_map<Key, Contact, KeyHash> contacts;
+	std::unordered_map<const Actor*, Body> bodies;
+	std::vector<std::vector<const Actor*>> islands; // AChƂ̃AN^[
+	uint32_t frame = 1; // ݂̃t[ԍ
+};
+
+#endif // !CONTACTCACHE_H_INCLUDED
@@ -4,11 +4,9 @@
 #include "Enemy.h"
 #include "PlayerActor.h"
 #include "SkeletalMesh.h"
+#include "Profiler.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <math.h>
-#include "Astar.h"
-
-#define ARRAY_NUM(a) (sizeof(a)/sizeof(a[0]))
 
 /*
 RXgN^
@@ -18,6 +16,19 @@ EnemyActor::EnemyActor(const Terrain::HeightMap* hm, const Mesh::Buffer& buffer,
 	: SkeletalMeshActor(buffer.GetSkeletalMesh("oni_small"), "Enemy", 13, pos, rot), heightMap(hm)
 {
 	colLocal = Collision::CreateSphere(glm::vec3(0, 0.7f, 0), 0.8f);
+	SetCollisionLayer(Collision::Layer::enemy);
+	attackCollisionPool.Reserve(1);
+}
+
+/*
+fXgN^
+*/
+EnemyActor::~EnemyActor()
+{
+	if (pathService)
+	{
+		pathService->Cancel(pathTicket);
+	}
 }
 
 void EnemyActor::TargetActor(const ActorPtr& target)
@@ -28,7 +39,7 @@ void EnemyActor::TargetActor(const ActorPtr& target)
 
 void EnemyActor::ObstacleActor(const ActorList& obstacleis)
 {
-	obstacle = obstacleis;
+	obstacle = &obstacleis;
 	return;
 }
 
@@ -47,40 +58,67 @@ bool EnemyActor::NearPlayer()
 	return false;
 }
 
+/*
+vC[邩ׂ
+
+@param front      gp
+@param seenLength Ẻs()
+
+@retval true  (vC[̈ʒuseenPosɋL^)
+@retval false Ȃ
+
+ʂɐLт3{̐(E1)1ȓEƂ
+EɃvC[Ă΁Aڂ̍vC[ɌăC΂A
+Qn`ɎՂȂΌƂ݂Ȃ
+*/
 bool EnemyActor::RayChack(glm::vec3 front, int seenLength)
 {
-	float objectMinScale = 10.0f;
-	for (int i = 0; i < 3; i++)
+	if (!obstacle || !targetActor)
 	{
-		float RotationY = rotation.y;
-		float x = -1;
-		x += i;
-		bool wallFrag = false;
-		front = glm::rotate(glm::mat4(1), RotationY,
-			glm::vec3(0, 1, 0)) * glm::vec4(x, 0, 1, 1);
-		for (int j = 0; j < seenLength; j++)
+		return false;
+	}
+
+	// vC[̈ʒuǍƂWnɕϊ
+	const glm::vec3 v = targetActor->position - position;
+	const float s = std::sin(rotation.y);
+	const float c = std::cos(rotation.y);
+	const glm::vec2 local(c * v.x - s * v.z, s * v.x + c * v.z);
+
+	// 1ȓɂ邩ׂ
+	const float seenRadius = 1.0f;
+	const float dz = local.y - glm::clamp(local.y, 0.0f, static_cast<float>(seenLength - 1));
+	bool isInSight = false;
+	for (float x = -1; x <= 1; ++x)
+	{
+		const float dx = local.x - x;
+		if (dx * dx + dz * dz < seenRadius * seenRadius)
 		{
-			front = glm::rotate(glm::mat4(1), RotationY,
-				glm::vec3(0, 1, 0)) * glm::vec4(x, 0, j, 1);
-			front += position;
-			front.y = heightMap->Height(front);
-			for (auto& object : obstacle)
-			{
-				float targetDistance = glm::length(targetActor->position - front);
-				const glm::vec3 distance = ObjectChack(object, front);
-				if (glm::length(distance) <= 0.5f)
-				{
-					wallFrag = true;
-				}
-				else if (targetDistance < 1.0f && !wallFrag)
-				{
-					seenPos = targetActor->position;
-					return true;
-				}
-			}
+			isInSight = true;
+			break;
 		}
 	}
-	return false;
+	if (!isInSight)
+	{
+		return false;
+	}
+
+	// ڂ̍vC[܂ł̊ԂɁAQƒn`ՂĂȂׂ
+	const glm::vec3 eyeOffset(0, 1.0f, 0);
+	const glm::vec3 eye = position + eyeOffset;
+	const glm::vec3 ray = targetActor->position + eyeOffset - eye;
+	const float distance = glm::length(ray);
+	if (distance > FLT_EPSILON)
+	{
+		World::RaycastHit hit;
+		const Collision::LayerMask blockers = Collision::ToMask(Collision::Layer::obstacle) |
+			Collision::ToMask(Collision::Layer::terrain);
+		if (obstacle->GetWorld().Raycast(eye, ray / distance, distance, &hit, this, blockers))
+		{
+			return false;
+		}
+	}
+	seenPos = targetActor->position;
+	return true;
 }
 
 void EnemyActor::PlayerInfo()
@@ -178,8 +216,7 @@ bool EnemyActor::Wait(float deltaTime)
 		vigilanceMode = false;
 		discovery = true;
 		state = State::attack;
-		nodePoint = 0;
-		moveCount = 0;
+		ResetPath();
 		isAnimation = false;
 		task = Task::end;
 		return false;
@@ -225,13 +262,18 @@ bool EnemyActor::Attack(float delatTime)
 			static const float radian = 0.5f;
 			const glm::vec3 front = glm::rotate(glm::mat4(1), rotation.y,
 				glm::vec3(0, 1, 0)) * glm::vec4(0, 0, 1.0f, 1);
-			attackCollision = std::make_shared<Actor>("PlayerAttackCollision", 5,
+			// O͒ZœKɎ܂钷ɂāÃq[vmۂ
+			attackHandle = attackCollisionPool.Create("AttackCollision", 5,
 				position + front + glm::vec3(0, 1, 0), glm::vec3(0), glm::vec3(radian));
+			attackCollision = attackCollisionPool.GetPtr(attackHandle);
 			attackCollision->colLocal = Collision::CreateSphere(glm::vec3(0), radian);
+			attackCollision->SetCollisionLayer(Collision::Layer::enemyAttack,
+				Collision::ToMask(Collision::Layer::player));
 		}
 	}
 	else
 	{
+		attackCollisionPool.Destroy(attackHandle);
 		attackCollision.reset();
 	}
 
@@ -250,11 +292,74 @@ bool EnemyActor::Attack(float delatTime)
 	}
 }
 
+/*
+oHT˗ݒ肷
+
+@param service oHT˗
+
+G[WFgԍ͍쐬Ɍ܂̂ŁAG쐬XbhŌĂяo
+*/
+void EnemyActor::SetPathService(PathService* service)
+{
+	ResetPath();
+	pathService = service;
+	pathAgent = service ? service->RegisterAgent() : PathService::invalidAgent;
+}
+
+/*
+oĤĂāAʑ҂̌oHT
+*/
+void EnemyActor::ResetPath()
+{
+	if (pathService)
+	{
+		pathService->Cancel(pathTicket);
+	}
+	pathTicket = PathService::invalidTicket;
+	waypoints.clear();
+	waypointIndex = 0;
+	nodePoint = 0;
+	moveCount = 0;
+}
+
+/*
+oH̎̋ԂAHiq̍Wɂ
+
+@retval true  ̋Ԃi[
+@retval false ̋ԂȂA܂͋ԂqȂȂĂ
+*/
+bool EnemyActor::RefineNextSegment()
+{
+	if (!pathService || waypointIndex + 1 >= waypoints.size())
+	{
+		return false;
+	}
+	thread_local std::vector<glm::ivec2> segment;
+	if (!pathService->Refine(waypoints[waypointIndex], waypoints[waypointIndex + 1], segment))
+	{
+		return false;
+	}
+	++waypointIndex;
+
+	// Ԃ̎n_(̂iq)āAړ鏇ԂɊi[
+	nodePos.clear();
+	for (size_t i = segment.size() > 1 ? 1 : 0; i < segment.size(); ++i)
+	{
+		glm::vec3 p(segment[i].x, 0, segment[i].y);
+		p.y = heightMap->Height(p);
+		nodePos.push_back(p);
+	}
+	nodePoint = static_cast<int>(nodePos.size());
+	moveCount = 0;
+	return true;
+}
+
 /*
 ړ
 */
 bool EnemyActor::MoveTo(glm::vec3 target, float length)
 {
+	PROFILE_SCOPE("EnemyActor::MoveTo");
 	// Aj[V̕ύX
 	if (!isAnimation)
 	{
@@ -262,59 +367,11 @@ bool EnemyActor::MoveTo(glm::vec3 target, float length)
 		isAnimation = true;
 	}
 	
-	Astar astar;
 	// ^XN̏
 	if (task == Task::reserve)
 	{
-		int goalPos_x = target.x;
-		int goalPos_z = target.z;
-		if ((target.x - goalPos_x) >= 0.5f)
-		{
-			goalPos_x += 1;
-		}
-		if ((target.z - goalPos_z) >= 0.5f)
-		{
-			goalPos_z += 1;
-		}
-
 		patrolGoalPos.y = position.y;
-		costChack = false;
-		loop = 0;
-		nodePoint = 0;
-		moveCount = 0;
-		astar.open.index = 0;
-		astar.close.index = 0;
-		for (x = leftWall; x < ARRAY_NUM(map); x++)
-		{
-			for (z = backWall; z <= forwordWall; z++)
-			{
-				// m[h̃X^[gn_ݒ
-				if (x == goalPos_x && z == goalPos_z)
-				{
-					map[x][z] = glm::vec3(goalPos_x, position.y, goalPos_z);
-					map[x][z].y = heightMap->Height(map[x][z]);
-					astar.s.x = x;
-					astar.s.z = z;
-					// X^[gm[hI[vXgɒǉ
-					astar.open.node[astar.open.index++] = &astar.s;
-					// N[YXg͋ɂ
-					astar.close.node[astar.close.index++] = NULL;
-				}
-
-				int position_x = position.x;
-				int position_z = position.z;
-
-				// m[h̃S[n_ݒ
-				if (x == position_x && z == position_z)
-				{
-					map[x][z] = glm::vec3(x, 0, z);
-					map[x][z].y = heightMap->Height(map[x][z]);
-					goalPos = map[x][z]; // S[n_ƂĕϐɊi[
-					astar.e.x = x;
-					astar.e.z = z;
-				}
-			}
-		}
+		ResetPath();
 		task = Task::start;
 	}
 
@@ -336,135 +393,64 @@ bool EnemyActor::MoveTo(glm::vec3 target, float length)
 		vigilanceMode = false;
 		discovery = true;
 		state = State::attack;
-		nodePoint = 0;
-		moveCount = 0;
+		ResetPath();
 		isAnimation = false;
 		task = Task::end;
 		return false;
 	}
 
-	if (nodePoint == 0)
+	// ړIn͎ľܓÄʒu͐؂̂ĂŊiqɍ킹
+	// ړInςoHvAVoH͂܂ł͍̌oHH葱
+	const glm::ivec2 goal(static_cast<int>(target.x + 0.5f), static_cast<int>(target.z + 0.5f));
+	if (pathService && pathTicket == PathService::invalidTicket && (nodePoint == 0 || goal != pathGoal))
 	{
-		while (1)
+		const glm::ivec2 start(static_cast<int>(position.x), static_cast<int>(position.z));
+		pathTicket = pathService->Request(start, goal, pathAgent);
+		pathGoal = goal;
+	}
+	if (pathTicket != PathService::invalidTicket)
+	{
+		// G̍XV̓WuVXeŕɍŝŁA󂯎p̔z̓XbhƂɎ
+		thread_local std::vector<glm::ivec2> route;
+		const PathService::Result result = pathService->Poll(pathTicket, route);
+		if (result == PathService::Result::found)
 		{
-			Astar::NODE* n = NULL;
-			n = astar.GetMinCost(n);
-			// open烊XgȂȂ̂ŏI
-			if (n == NULL)
-			{
-				printf("no goal...\n");
-				return true;
-			}
-			map[n->x][n->z] = glm::vec3(n->x, position.y, n->z);
-			glm::vec3 v = map[n->x][n->z] - goalPos;
-			// vZɃS[n_ɒvZI
-			if (dot(v,v) <= 1)
-			{
-				if (n != NULL && n->parent == NULL)
-				{
-					nodePos[nodePoint] = glm::vec3(n->x, 0, n->z);
-					nodePos[nodePoint].y = heightMap->Height(nodePos[nodePoint]);
-					nodePoint++;
-				}
-
-				// X^[gn_̃m[hȂ܂Ŋem[h̍WzɊi[
-				while (n->parent != NULL)
-				{
-					if (n->cost >= n->parent->cost)
-					{
-						n = n->parent;
-						nodePos[nodePoint] = glm::vec3(n->x, 0, n->z);
-						nodePos[nodePoint].y = heightMap->Height(nodePos[nodePoint]);
-						nodePoint++;
-						if (nodePoint > 55)
-						{
-							printf("RXg傫邽ߍēxvZ\n");
-							// em[h̋ɂ
-							n->parent = NULL;
-							costChack = true;
-						}
-					}
-
-					// em[h̃RXg傫ꍇ̗O
-					else if (n->cost < n->parent->cost)
-					{
-						printf("RXgG[\n");
-						// em[h̋ɂ
-						n->parent = NULL;
-						costChack = true;
-					}
-				}
-				n = NULL;
-				astar.s = { 0, 0, 0 };
-				astar.e = { 0, 0, 0 };
-				break;
-			}
-
-			// ݂̃m[hN[YXgɊi[
-			astar.close.node[astar.close.index++] = n;
-
-			// ̃m[h
-			if (n->x > leftWall && MapCheck(n->x - 1, n->z))
-			{
-				astar.SearchNode(&astar.open, &astar.close, &astar.s, &astar.e, n,
-					astar.CreateNode(n->x - 1, n->z, n->cost + 1));
-			}
-
-			// Ẽm[h
-			if (n->x < rightWall && MapCheck(n->x + 1, n->z))
-			{
-				astar.SearchNode(&astar.open, &astar.close, &astar.s, &astar.e, n,
-					astar.CreateNode(n->x + 1, n->z, n->cost + 1));
-			}
-
-			// Õm[h
-			if (n->z < forwordWall && MapCheck(n->x, n->z + 1))
-			{
-				astar.SearchNode(&astar.open, &astar.close, &astar.s, &astar.e, n,
-					astar.CreateNode(n->x, n->z + 1, n->cost + 1));
-			}
-
-			// ̃m[h
-			if (n->z > backWall && MapCheck(n->x, n->z - 1))
-			{
-				astar.SearchNode(&astar.open, &astar.close, &astar.s, &astar.e, n,
-					astar.CreateNode(n->x, n->z - 1, n->cost + 1));
-			}
-			// Õm[h
-			if (n->x > leftWall && n->z < forwordWall && MapCheck(n->x - 1, n->z + 1))
+			// v󂯎Aŏ̋Ԃiq̌oHɂ
+			// X^[gƃS[iqȂÅiqɌ
+			pathTicket = PathService::invalidTicket;
+			waypoints.swap(route);
+			waypointIndex = 0;
+			if (waypoints.size() == 1)
 			{
-				astar.SearchNode(&astar.open, &astar.close, &astar.s, &astar.e, n,
-					astar.CreateNode(n->x - 1, n->z + 1, n->cost + 1));
+				waypoints.push_back(waypoints.front());
 			}
-
-			// EÕm[h
-			if (n->x < leftWall && n->z < forwordWall && MapCheck(n->x + 1, n->z + 1))
-			{
-				astar.SearchNode(&astar.open, &astar.close, &astar.s, &astar.e, n,
-					astar.CreateNode(n->x + 1, n->z + 1, n->cost + 1));
-			}
-
-			// ̃m[h
-			if (n->x > leftWall && n->z > backWall && MapCheck(n->x - 1, n->z - 1))
+			if (!RefineNextSegment())
 			{
-				astar.SearchNode(&astar.open, &astar.close, &astar.s, &astar.e, n,
-					astar.CreateNode(n->x - 1, n->z - 1, n->cost + 1));
-			}
-
-			// Ẽm[h
-			if (n->x < leftWall && n->z > backWall && MapCheck(n->x + 1, n->z - 1))
-			{
-				astar.SearchNode(&astar.open, &astar.close, &astar.s, &astar.e, n,
-					astar.CreateNode(n->x + 1, n->z - 1, n->cost + 1));
-			}
-
-			// S[ɂǂ蒅AiɃm[ȟvZsꍇ̗O
-			if (loop++ > 1000)
-			{
-				printf("loop error...\n");
-				return true;
+				ResetPath();
 			}
 		}
+		else if (result != PathService::Result::pending)
+		{
+			pathTicket = PathService::invalidTicket;
+		}
+	}
+	if (nodePoint == 0)
+	{
+		if (pathTicket == PathService::invalidTicket)
+		{
+			printf("no goal...\n");
+			return true;
+		}
+		// ŏ̌oH͂܂ł̏ő҂
+		velocity = glm::vec3(0);
+		return false;
+	}
+	// Ԃ̏I_ɒA̋Ԃiq̌oHɂ(qȂΒT)
+	if (moveCount >= nodePoint && waypointIndex + 1 < waypoints.size() && !RefineNextSegment())
+	{
+		ResetPath();
+		velocity = glm::vec3(0);
+		return false;
 	}
 	// em[hH悤ɂAI𓮂
 	if (moveCount < nodePoint)
@@ -491,18 +477,17 @@ bool EnemyActor::MoveTo(glm::vec3 target, float length)
 	// i[m[h̐̕i񂾂^XNI
 	if (moveCount >= nodePoint)
 	{
-		// ẽRXgꍇ̗OɈꍇA^XNIm[h̍ČvZs
-		if (costChack)
+		// VoHvȂA͂܂ł̏ő҂
+		if (pathTicket != PathService::invalidTicket)
 		{
 			velocity = glm::vec3(0);
-			position = nodePos[nodePoint - 1];
-			task = Task::reserve;
 			return false;
 		}
-		if (glm::length(target - nodePos[moveCount]) > length && state == State::approach)
+		// oH̏I_ڕW痣ꂷĂAI_T
+		if (glm::length(target - nodePos.back()) > length && state == State::approach)
 		{
 			velocity = glm::vec3(0);
-			position = nodePos[nodePoint - 1];
+			position = nodePos.back();
 			task = Task::reserve;
 			return false;
 		}
@@ -661,23 +646,12 @@ void EnemyActor::SetBoardingActor(ActorPtr p)
 
 @retrun true  QȂ
 @param false Q
+
+Q0.8ȓǂ́ANavGridƂɒׂĂ
 */
 bool EnemyActor::MapCheck(int x, int z)
 {
-	glm::vec3 map = glm::vec3(x , 0, z);
-	map.y = heightMap->Height(map);
-	for (auto& object : obstacle)
-	{
-		// IuWFNgƃm[h̋擾
-		const glm::vec3 distance = ObjectChack(object, map); 
-
-		// IuWFNgƎw肵W̋dȂĂ邩mF
-		if (glm::length(distance) <= 0.8f)
-		{
-			return false;
-		}
-	}
-	return true;
+	return !navGrid || navGrid->IsWalkable(x, z);
 }
 
 /*
@@ -711,176 +685,3 @@ const glm::vec3 EnemyActor::ObjectChack(ActorPtr o, glm::vec3 m)
 	}
 	return m - q;
 }
-
-/*
-i[\ȃAN^[mۂ
-
-@param reserveCount AN^[z̊mې
-*/
-void EnemyActorList::Reserve(size_t reserveCount)
-{
-	enemies.reserve(reserveCount);
-}
-
-/*
-AN^[ǉ
-
-@param actor ǉAN^[
-*/
-void EnemyActorList::Add(const EnemyActorPtr& actor)
-{
-	enemies.push_back(actor);
-}
-
-/*
-AN^[폜
-
-@param actor 폜AN^[
-*/
-bool EnemyActorList::Remove(const EnemyActorPtr& actor)
-{
-	//|C^vAN^T
-	//
-	for (auto itr = enemies.begin(); itr != enemies.end(); ++itr)
-	{
-		if (*itr == actor)
-		{
-			enemies.erase(itr);
-			return true;
-		}
-	}
-	return false;
-}
-
-/*
-w肳ꂽWɑΉiq̃CfbNX擾
-
-@param pos CfbNX̌ɂȂʒu
-
-@retun posɑΉiq̃CfbNX
-*/
-glm::ivec2 EnemyActorList::CalcMapIndex(const glm::vec3& pos) const
-{
-	const int x = std::max(0,
-		std::min(sepalationSizeX - 1, static_cast<int>(pos.x / mapGridSizeX)));
-	const int y = std::max(0,
-		std::min(sepalationSizeY - 1, static_cast<int>(pos.z / mapGridSizeY)));
-	return glm::ivec2(x, y);
-}
-
-/*
-AN^[̏ԂXV
-
-@param deltaTime O̍XV̌oߎ
-*/
-void EnemyActorList::Update(float deltaTime)
-{
-	//͈for
-	for (const EnemyActorPtr& e : enemies)
-	{
-		if (e && e->health > 0)
-		{
-			e->Update(deltaTime);
-		}
-	}
-
-	for (auto i = enemies.begin(); i != enemies.end();)
-	{
-		const EnemyActorPtr& e = *i;
-		if (!e || e->health <= 0)
-		{
-			// erase => vectorvf폜邽߂Ɏg
-			// sA̗vfwlԂĂ
-			i = enemies.erase(i);
-		}
-		else
-		{
-			++i;
-		}
-	}
-
-	// iqԂɃAN^[蓖Ă
-	for (int y = 0; y < sepalationSizeY; ++y)
-	{
-		for (int x = 0; x < sepalationSizeX; ++x)
-		{
-			grid[y][x].clear();
-		}
-	}
-	for (auto i = enemies.begin(); i != enemies.end(); ++i)
-	{
-		const glm::ivec2 mapIndex = CalcMapIndex((*i)->position);
-		grid[mapIndex.y][mapIndex.x].push_back(*i);
-	}
-}
-
-
-
-/*
-AN^[`f[^XV
-*/
-void EnemyActorList::UpdateDrawData(float deltaTime)
-{
-	for (const EnemyActorPtr& e : enemies)
-	{
-		if (e && e->health > 0) {
-			e->UpdateDrawData(deltaTime);
-		}
-	}
-}
-
-/*
-AN^[`悷
-*/
-void EnemyActorList::Draw()
-{
-	for (const EnemyActorPtr& e : enemies)
-	{
-		if (e && e->health > 0) {
-			e->Draw();
-		}
-	}
-}
-
-/*
-w肳ꂽW̋ߖTɂAN^[̃Xg擾
-
-@param pos         ̊_ƂȂW
-@param maxDistance ߖTƂ݂Ȃő勗()
-
-@return Actor::positionpos甼amaxDistanceȓɂAN^[̔z
-*/
-std::vector<EnemyActorPtr> EnemyActorList::FindNearbyActors(
-	const glm::vec3& pos, float maxDistance) const
-{
-	std::vector<std::pair<float, EnemyActorPtr>> buffer;
-	buffer.reserve(1000);
-
-	const glm::ivec2 mapIndex = CalcMapIndex(pos);
-	const glm::ivec2 min = glm::max(mapIndex - 1, 0);
-	const glm::ivec2 max = glm::min(
-		mapIndex + 1, glm::ivec2(sepalationSizeX - 1, sepalationSizeY - 1));
-	for (int y = min.y; y <= max.y; ++y)
-	{
-		for (int x = min.x; x <= max.x; ++x)
-		{
-			const std::vector<EnemyActorPtr>& list = grid[y][x];
-			for (auto actor : list)
-			{
-				const float distance = glm::distance(glm::vec3(actor->position), pos);
-				buffer.push_back(std::make_pair(distance, actor));
-			}
-		}
-	}
-
-	std::vector<EnemyActorPtr> result;
-	result.reserve(100);
-	for (const auto& e : buffer)
-	{
-		if (e.first <= maxDistance)
-		{
-			result.push_back(e.second);
-		}
-	}
-	return result;
-}
\ No newline at end of file
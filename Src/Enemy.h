@@ -6,11 +6,14 @@
 #include "GLFWEW.h"
 #include "SkeletalMeshActor.h"
 #include "Terrain.h"
+#include "NavGrid.h"
+#include "PathService.h"
 #include<memory>
 #include <random>
 #include <stdio.h>
 #include <tchar.h>
 #include <map>
+#include <vector>
 
 /*
 Gl~[AN^[
@@ -20,7 +23,7 @@ class EnemyActor : public SkeletalMeshActor
 public:
 	EnemyActor(const Terrain::HeightMap* hm, const Mesh::Buffer& buffer,
 		const glm::vec3& pos, const glm::vec3& rot = glm::vec3(0));
-	virtual ~EnemyActor() = default;
+	virtual ~EnemyActor();
 	virtual void Update(float) override;
 	virtual void OnHit(const ActorPtr&, const glm::vec3&);
 	void SetBoardingActor(ActorPtr);
@@ -30,6 +33,8 @@ public:
 	void TargetActor(const ActorPtr& target);
 	void ObjectActor(const StaticMeshActorPtr object);
 	void ObstacleActor(const ActorList& obstacleis);
+	void SetNavGrid(const NavGrid* grid) { navGrid = grid; }
+	void SetPathService(PathService* service);
 
 	bool Wait(float);
 	bool MoveTo(glm::vec3, float);
@@ -55,10 +60,21 @@ private:
 	ActorPtr boardingActor;    // ĂAN^[
 	float moveSpeed = 5.0f;    // ړx
 	ActorPtr attackCollision;  // U
+	ActorHandle attackHandle;  // Ũnh
+	ActorPool<Actor> attackCollisionPool{ 1 }; // Ug񂷂߂̃v[
 	
 
 	
-	ActorList obstacle;
+	const ActorList* obstacle = nullptr; // Q̃Xg(Rs[ɎQƂ)
+	const NavGrid* navGrid = nullptr;    // oHTp̊iq(SĂ̓GŋL)
+	PathService* pathService = nullptr;  // oHT˗(SĂ̓GŋL)
+	PathService::AgentId pathAgent = PathService::invalidAgent;  // oHT˗Ƃ̃G[WFgԍ
+	PathService::Ticket pathTicket = PathService::invalidTicket; // ʑ҂̌oHT̃`Pbg
+	glm::ivec2 pathGoal = glm::ivec2(0); // ŌɗvoH̃S[n_̊iq
+	std::vector<glm::ivec2> waypoints;   // 󂯎oH̗v
+	size_t waypointIndex = 0;            // HĂԂ̎n_̗v̔ԍ
+	void ResetPath();
+	bool RefineNextSegment();
 	ActorPtr objects;
 
 	glm::vec3 forward;
@@ -105,20 +121,14 @@ protected:
 	float attackTimer = 0;     // U
 
 public:
-	glm::vec3 map[200][200];
-	glm::vec3 goalPos;
 	glm::vec3 startPos;
-	glm::vec3 nodePos[200];
+	std::vector<glm::vec3> nodePos; // oH̊iq̍W(ړ鏇)
 	glm::vec3 o[100];
 	int nodePoint = 0;
 	int moveCount = 0;
 	int maxCount = 0;
 	int obstacleLength;
-	int x = 0;
-	int z = 0;
-	int loop = 0;
 	float heightMap_y;
-	bool costChack = false;
 	int roundPoint = 0;
 	glm::vec3 front;
 	float forgetTimer = 0;
@@ -154,41 +164,7 @@ public:
 };
 using EnemyActorPtr = std::shared_ptr<EnemyActor>;
 
-class EnemyActorList
-{
-public:
-	using iterator = std::vector<EnemyActorPtr>::iterator;
-	using const_iterator = std::vector<EnemyActorPtr>::const_iterator;
-
-	EnemyActorList() = default;
-	~EnemyActorList() = default;
-
-	void Reserve(size_t);
-	void Add(const EnemyActorPtr&);
-	bool Remove(const EnemyActorPtr&);
-	void Update(float);
-	void UpdateDrawData(float);
-	void Draw();
-	bool Empty() const { return enemies.empty(); }
-
-	// Ce[^[擾֐
-	iterator begin() { return enemies.begin(); }
-	iterator end() { return enemies.end(); }
-	const_iterator begin() const { return enemies.begin(); }
-	const_iterator end() const { return enemies.end(); }
-
-	std::vector<EnemyActorPtr> FindNearbyActors(const glm::vec3& pos, float maxDistance) const;
-
-private:
-	std::vector<EnemyActorPtr> enemies;
-
-	static const int mapGridSizeX = 10;
-	static const int mapGridSizeY = 10;
-	static const int sepalationSizeX = 20;
-	static const int sepalationSizeY = 20;
-	std::vector<EnemyActorPtr> grid[sepalationSizeY][sepalationSizeX];
-	glm::ivec2 CalcMapIndex(const glm::vec3& pos) const;
-};
+using EnemyActorList = TypedActorList<EnemyActor>;
 
 #endif // !ENEMY_H_INCLUDED
 
@@ -4,6 +4,7 @@
 
 #include "GLFWEW.h"
 #include <iostream>
+#include <math.h>
 
 //GLFWGLEWbv邽߂̖O
 namespace GLFWEW
@@ -126,7 +127,7 @@ namespace GLFWEW
 	*/
 	bool Window::ShouldClose() const
 	{
-		return glfwWindowShouldClose(window) != 0;
+		return isReplayFinished || glfwWindowShouldClose(window) != 0;
 	}
 
 	/*
@@ -158,11 +159,19 @@ namespace GLFWEW
 
 	bool Window::IsKeyPressed(int key) const
 	{
+		if (IsReplaying())
+		{
+			return frameInput.IsKeyPressed(key);
+		}
 		return glfwGetKey(window, key) == GLFW_PRESS;
 	}
 
 	bool Window::IsMousePressed(int mouse) const
 	{
+		if (IsReplaying())
+		{
+			return frameInput.IsMousePressed(mouse);
+		}
 		return glfwGetMouseButton(window, mouse) == GLFW_PRESS;
 	}
 
@@ -180,44 +189,165 @@ namespace GLFWEW
 		glfwSetTime(0.0);
 		previousTime = 0.0;
 		deltaTime = 0.0;
+		accumulator = 0.0;
+		stepCount = 0;
 	}
 
 	/*
 	^C}[XV
+
+	Q[pbh̏ԂNextStep()ōXV
 	*/
 	void Window::UpdateTimer()
 	{
-		//oߎԂv
-		const double currentTime = glfwGetTime();
-		deltaTime = currentTime - previousTime;
-		previousTime = currentTime;
-
-		//oߎԂȂ肷Ȃ悤ɒ
-		const float upperLimit = 0.25f; //oߎԂƂċe
-		if (deltaTime > upperLimit)
+		if (IsReplaying())
 		{
-			deltaTime = 0.1f;
+			//oߎԂƓ͂L^ǂݍ
+			if (!player.Read(frameInput))
+			{
+				player.Close();
+				isReplayFinished = true;
+				frameInput.deltaTime = 0;
+			}
+			deltaTime = frameInput.deltaTime;
+			replayTime += deltaTime;
 		}
-		UpdateGamePad();
+		else
+		{
+			//oߎԂv
+			const double currentTime = glfwGetTime();
+			deltaTime = currentTime - previousTime;
+			previousTime = currentTime;
+
+			//oߎԂȂ肷Ȃ悤ɒ
+			const float upperLimit = 0.25f; //oߎԂƂċe
+			if (deltaTime > upperLimit)
+			{
+				deltaTime = 0.1f;
+			}
+
+			SampleInput();
+			if (recorder.IsOpen())
+			{
+				recorder.Write(frameInput);
+			}
+		}
+
+		if (IsFixedTimeStep())
+		{
+			accumulator += deltaTime;
+		}
+		stepCount = 0;
 	}
 
 	/*
-	oߎԂ擾
+	V~[V̌oߎԂ擾
 
-	@retrun O2UpdateTimer()Ăяo̊ԂɌo߂
+	@retrun Œ莞ԃXebvȂ1Xebv̊Ԋu
+	        ώԃXebvȂ璼O2UpdateTimer()Ăяo̊ԂɌo߂
 	*/
 	double Window::DeltaTime() const
 	{
+		if (IsFixedTimeStep())
+		{
+			return fixedDeltaTime;
+		}
 		return deltaTime;
 	}
 
+	/*
+	`̌oߎԂ擾
+
+	@retrun O2UpdateTimer()Ăяo̊ԂɌo߂
+	*/
+	double Window::FrameDeltaTime() const
+	{
+		return deltaTime;
+	}
+
+	/*
+	Œ莞ԃXebvݒ肷
+
+	@param tickRate 1b̃V~[V(0ȉȂώԃXebvɖ߂)
+	@param maxSteps 1t[ŎsXebv̏
+
+	dĒǂȂƂ́A𒴂̃Xebv̂Ă
+	Q[̐isx点
+	*/
+	void Window::SetFixedTimeStep(double tickRate, int maxSteps)
+	{
+		fixedDeltaTime = tickRate > 0 ? 1.0 / tickRate : 0.0;
+		maxStepsPerFrame = maxSteps > 0 ? maxSteps : 1;
+		accumulator = 0.0;
+	}
+
+	/*
+	̃V~[VXebvɐi
+
+	@retval true  Xebvs
+	@retval false ̃t[ŎsXebv͎cĂȂ
+
+	UpdateTimer()̌AfalseԂ܂ŌJԂĂяoāA
+	trueԂ邽тDeltaTime()V~[Vi߂邱
+	ώԃXebv̏ꍇ1t[1񂾂trueԂ
+	*/
+	bool Window::NextStep()
+	{
+		if (!IsFixedTimeStep())
+		{
+			if (stepCount > 0)
+			{
+				return false;
+			}
+		}
+		else
+		{
+			if (accumulator < fixedDeltaTime)
+			{
+				return false;
+			}
+			if (stepCount >= maxStepsPerFrame)
+			{
+				// ǂȂ͎̂ĂāA[̃t[Ɏz
+				accumulator = fmod(accumulator, fixedDeltaTime);
+				return false;
+			}
+			accumulator -= fixedDeltaTime;
+		}
+		++stepCount;
+
+		// ͂̓XebvƂɎ擾āAbuttonDown1XebvLɂȂ悤ɂ
+		UpdateGamePad();
+		return true;
+	}
+
+	/*
+	`p̕ԌW擾
+
+	@return ÕXebv̊Jn_0AI_1Ƃݎ̈ʒu
+	        ώԃXebvȂ1
+	*/
+	float Window::InterpolationAlpha() const
+	{
+		if (!IsFixedTimeStep())
+		{
+			return 1.0f;
+		}
+		return static_cast<float>(accumulator / fixedDeltaTime);
+	}
+
 	/*
 	oߎԂ擾
 
 	@return GLFWĂ̌oߎ(b)
+	        Đ͍ĐJnĂ̌oߎ(b)
 	*/
 	double Window::Time() const
 	{
+		if (IsReplaying())
+		{
+			return replayTime;
+		}
 		return glfwGetTime();
 	}
 
@@ -269,11 +399,13 @@ namespace GLFWEW
 	};
 
 	/*
-	Q[pbh̏ԂXV
+	Q[pbhƃL[{[h̓͂GamePad̃{^ɕϊ
+
+	@return GamePad::buttonsɐݒ肷l
 	*/
-	void Window::UpdateGamePad()
+	uint16_t Window::ReadGamePadButtons() const
 	{
-		const uint32_t prevButtos = gamepad.buttons; //buttonDown𐶐邽߂ɁAXVO̓
+		uint32_t padButtons = frameInput.buttons; //Õt[̓
 
 		//AiO͂ƃ{^͂擾
 		int axesCount, buttonCount;
@@ -289,27 +421,27 @@ namespace GLFWEW
 			//LȃQ[pbhڑĂꍇ
 
 			//L[̓͏ԂāAXeBbN̓͂Œu
-			gamepad.buttons &= ~(GamePad::DPAD_UP | GamePad::DPAD_DOWN |
+			padButtons &= ~(GamePad::DPAD_UP | GamePad::DPAD_DOWN |
 				GamePad::DPAD_LEFT | GamePad::DPAD_RIGHT);
 			static const float digitalThreshod = 0.3f; // fW^͂Ƃ݂Ȃl
 			if (axes[GAMEPAD_AXES_LEFT_Y] >= digitalThreshod)
 			{
-				gamepad.buttons |= GamePad::DPAD_UP;
+				padButtons |= GamePad::DPAD_UP;
 			}
 			else if (axes[GAMEPAD_AXES_LEFT_Y] <= -digitalThreshod)
 			{
-				gamepad.buttons |= GamePad::DPAD_DOWN;
+				padButtons |= GamePad::DPAD_DOWN;
 			}
 			if(axes[GAMEPAD_AXES_LEFT_X] >= digitalThreshod)
 			{
-				gamepad.buttons |= GamePad::DPAD_LEFT;
+				padButtons |= GamePad::DPAD_LEFT;
 			}
 			else if (axes[GAMEPAD_AXES_LEFT_X] <= -digitalThreshod)
 			{
-				gamepad.buttons |= GamePad::DPAD_RIGHT;
+				padButtons |= GamePad::DPAD_RIGHT;
 			}
 
-			//zCfbNXGamePadL[̑Ή\
+			//zCfbNXGamePadL[̑Ή\B
 			static const struct
 			{
 				int dataIndex;
@@ -334,17 +466,17 @@ namespace GLFWEW
 			{
 				if (buttons[e.dataIndex] == GLFW_PRESS)
 				{
-					gamepad.buttons |= e.gamepadBit;
+					padButtons |= e.gamepadBit;
 				}
 				else if (buttons[e.dataIndex] == GLFW_RELEASE)
 				{
-					gamepad.buttons &= ~e.gamepadBit;
+					padButtons &= ~e.gamepadBit;
 				}
 			}
 		}
 		else
 		{
-			//zCfbNXGamePadL[̑Ή\
+			//zCfbNXGamePadL[̑Ή\B
 			static const struct
 			{
 				int keyCode;
@@ -370,19 +502,112 @@ namespace GLFWEW
 				const int key = glfwGetKey(window, e.keyCode);
 				if (key == GLFW_PRESS)
 				{
-					gamepad.buttons |= e.gamepadBit;
+					padButtons |= e.gamepadBit;
 				}
 				else if (key == GLFW_RELEASE)
 				{
-					gamepad.buttons &= ~e.gamepadBit;
+					padButtons &= ~e.gamepadBit;
 				}
 			}
 		}
 
+		return static_cast<uint16_t>(padButtons);
+	}
+
+	/*
+	Q[pbh̏ԂXV
+
+	̃t[̓(frameInput)GamePadɔf
+	*/
+	void Window::UpdateGamePad()
+	{
+		const uint32_t prevButtos = gamepad.buttons; //buttonDown𐶐邽߂ɁAXVO̓
+		gamepad.buttons = frameInput.buttons;
+
 		//O̍XVŉĂȂāA񉟂ĂL[̏buttonDownɊi[
 		gamepad.buttonDown = gamepad.buttons & ~prevButtos;
 	}
 
+	/*
+	̃t[̓͏Ԃ擾
+
+	L[A}EX{^AJ[\ʒu͋L^擾
+	(L^ĐĂȂ΁AIsKeyPressed()Ȃǂ͒GLFWɖ₢킹)
+	*/
+	void Window::SampleInput()
+	{
+		frameInput.deltaTime = deltaTime;
+		frameInput.buttons = ReadGamePadButtons();
+		if (recorder.IsOpen())
+		{
+			for (int key = FrameInput::firstKey; key <= FrameInput::lastKey; ++key)
+			{
+				frameInput.SetKey(key, glfwGetKey(window, key) == GLFW_PRESS);
+			}
+			frameInput.mouseButtons = 0;
+			for (int i = 0; i < 8; ++i)
+			{
+				if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_1 + i) == GLFW_PRESS)
+				{
+					frameInput.mouseButtons |= static_cast<uint8_t>(1 << i);
+				}
+			}
+			glfwGetCursorPos(window, &frameInput.cursorX, &frameInput.cursorY);
+		}
+	}
+
+	/*
+	͂̋L^Jn
+
+	@param filename L^̃t@C
+
+	@retval true  L^Jn
+	@retval false t@CJȂA܂͍Đ
+
+	L^Jn̊et[̌oߎԂƓ͂t@Cɏo
+	*/
+	bool Window::StartRecording(const char* filename)
+	{
+		if (IsReplaying())
+		{
+			return false;
+		}
+		return recorder.Open(filename);
+	}
+
+	/*
+	͂̋L^I
+	*/
+	void Window::StopRecording()
+	{
+		recorder.Close();
+	}
+
+	/*
+	L^͂̍ĐJn
+
+	@param filename Đt@C
+
+	@retval true  ĐJn
+	@retval false t@CJȂA܂͋L^
+
+	Đ͌oߎԂƓ͂t@Cǂݍ݁Aۂ̎v͑u͎gȂ
+	ĐIShouldClose()trueԂ
+	*/
+	bool Window::StartReplay(const char* filename)
+	{
+		if (IsRecording() || !player.Open(filename))
+		{
+			return false;
+		}
+		isReplayFinished = false;
+		replayTime = 0;
+		accumulator = 0;
+		frameInput = FrameInput();
+		return true;
+	}
+
+
 	void Window::CenterCursor() const
 	{
 		glfwSetCursorPos(window, width / 2, height / 2);
@@ -392,7 +617,15 @@ namespace GLFWEW
 	{
 		glm::vec3 mousePos = glm::vec3(0);
 		double x, z;
-		glfwGetCursorPos(window, &x, &z);
+		if (IsReplaying())
+		{
+			x = frameInput.cursorX;
+			z = frameInput.cursorY;
+		}
+		else
+		{
+			glfwGetCursorPos(window, &x, &z);
+		}
 		{
 			mousePos.x = x * 0.05f;
 			mousePos.z = z * 0.25f;
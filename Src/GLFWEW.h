@@ -7,6 +7,7 @@
 #include "GamePad.h"
 #include <GLFW\glfw3.h>
 #include <glm\vec3.hpp>
+#include "InputRecord.h"
 
 namespace GLFWEW
 {
@@ -26,12 +27,24 @@ namespace GLFWEW
 		Window(const Window&) = delete;  //Rs[RXgN^
 		Window& operator = (const Window&) = delete;  //Rs[Zq
 		void UpdateGamePad();
+		uint16_t ReadGamePadButtons() const;
+		void SampleInput();
 
 		bool isGLFWInitialized = false;
 		bool isInitialized = false;
 		GLFWwindow* window = nullptr;
 		double previousTime = 0;
 		double deltaTime = 0;
+		double fixedDeltaTime = 0;  // Œ莞ԃXebv̊Ԋu(0ȂώԃXebv)
+		double accumulator = 0;     // ܂V~[VĂȂoߎ
+		int maxStepsPerFrame = 5;   // 1t[ŎsXebv̏
+		int stepCount = 0;          // ̃t[ŎsXebv
+		FrameInput frameInput;      // ̃t[̓
+		InputRecorder recorder;     // ͂̋L^
+		InputPlayer player;         // ͂̍Đ
+		bool isReplayFinished = false; // ĐItrue
+		double replayTime = 0;      // ĐJnĂ̌oߎ
+		bool isDeterministic = false; // trueȂ珈ԂŌʂς鏈sȂ
 		int width = 0;
 		int height = 0;
 		GamePad gamepad;
@@ -49,8 +62,25 @@ namespace GLFWEW
 		void InitTimer();
 		void UpdateTimer();
 		double DeltaTime() const;
+		double FrameDeltaTime() const;
 		double Time() const;
 
+		void SetFixedTimeStep(double tickRate, int maxSteps = 5);
+		bool IsFixedTimeStep() const { return fixedDeltaTime > 0; }
+		bool NextStep();
+		float InterpolationAlpha() const;
+
+		// ͂̋L^ƍĐ
+		bool StartRecording(const char* filename);
+		void StopRecording();
+		bool IsRecording() const { return recorder.IsOpen(); }
+		bool StartReplay(const char* filename);
+		bool IsReplaying() const { return player.IsOpen(); }
+
+		// ԂŌʂς鏈(Ԃőł؂TȂ)֎~BL^EĐ͏ɋ֎~
+		void SetDeterministic(bool b) { isDeterministic = b; }
+		bool IsDeterministic() const { return isDeterministic || IsRecording() || IsReplaying(); }
+
 		//ʃTCY̏擾Ă
 		int Width() const { return width; }
 		int Height() const { return height; }
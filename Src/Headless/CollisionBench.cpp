@@ -0,0 +1,930 @@
+/*
+@file CollisionBench.cpp
+
+EBhEGPUg킸ɏՓ˔ƋԌ̏ԂvvO
+
+ōV[(AJvZAMainGameScenê悤ȖHɕׂOBB̕)gāA
+`̑gݍ킹Ƃ̏ڍהAXgmDetectCollisionAߖTAČv
+--verifyw肵ꍇ́Av̑ɌoHTJPSJPS+̌ʂA*ƔׂČ؂
+
+R}hC:
+  --spheres      ̃AN^[(ȗ1000)
+  --capsules     JvZ̃AN^[(ȗ200)
+  --maze         H1ӂ̋搔B18l(ȗ12)
+  --seed         ̎(ȗ0)
+  --time ~b    1ڂ̍Œv(ȗ200)
+  --workers      WuVXẽ[J[Xbh(ȗ0=CXbh)
+  --format `    json(1s1ڂJSON)܂csv(ȗjson)
+  --filter   Oɂ̕܂ލڂv
+  --verify       v̑ɁAJPSJPS+A*Ɠ̌oHԂAōiq
+                   w肵񐔂؂BvȂΏIR[h1Ԃ
+
+o͂l:
+  name          ږ
+  ops           v̉
+  ns_per_op     1삠̎(imb)
+  pairs_per_sec 1bɏgݍ킹̐
+                SĂ̑gݍ킹𑍓肵ꍇ̐Ő(ڍה11gA
+                DetectCollision̓Xg̗vf̐ρAߖTƃC͑ΏۃXg̗vf)
+  hits_per_op   1삠̏Փː⌟ʂ̐(ʂςĂȂ̊mFp)
+
+R~bgƂɓŎsAns_per_opׂ邱Ƃŏx̗򉻂
+*/
+#include "../Actor.h"
+#include "../Collision.h"
+#include "../CollisionBatch.h"
+#include "../World.h"
+#include "../JobSystem.h"
+#include "../NavGrid.h"
+#include "../Astar.h"
+#include "../JumpPointMap.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace /* unnamed */ {
+
+const float mazeCellSize = 8;         // H1̑傫(2)
+const float wallLength = 4;           // 1̒(MainGameScene::CreateStoneWallƓ)
+const size_t narrowPairCount = 4096;  // ڍהɎggݍ킹̐
+const float queryRadius = 5;          // ߖT̔a
+const float rayLength = 50;           // C̒
+const size_t queryCount = 1024;       // ߖTƃC̎n_̐
+
+/*
+v̐ݒ
+*/
+struct Options
+{
+	size_t sphereCount = 1000;
+	size_t capsuleCount = 200;
+	int mazeSize = 12;
+	unsigned int seed = 0;
+	double minTimeMs = 200;
+	size_t workerCount = 0;
+	bool isCsv = false;
+	const char* filter = nullptr;
+	int verifyCount = 0;
+};
+
+/*
+vʂo͂NX
+*/
+class Reporter
+{
+public:
+	explicit Reporter(const Options& o) : options(o) {}
+
+	/*
+	ڂv邩ׂ
+	*/
+	bool IsEnabled(const char* name) const
+	{
+		return !options.filter || strstr(name, options.filter);
+	}
+
+	/*
+	ڂvČʂo͂
+
+	@param name  ږ
+	@param pairs 1삠̑gݍ킹̐
+	@param func  1ĂԂƂɉ񕪂̑sƁÅԂ̏ՓːԂ֐
+	             size_t func(size_t* hits)̌`ŌĂяo
+
+	ŒvԂ𒴂܂funcJԂĂяo
+	*/
+	template<typename F>
+	void Run(const char* name, double pairs, const F& func)
+	{
+		if (!IsEnabled(name))
+		{
+			return;
+		}
+		size_t hits = 0;
+		func(&hits); // LbV߂邽߂1񂵂
+
+		using Clock = std::chrono::steady_clock;
+		size_t ops = 0;
+		hits = 0;
+		double elapsedNs = 0;
+		const Clock::time_point begin = Clock::now();
+		do
+		{
+			ops += func(&hits);
+			elapsedNs = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+		} while (elapsedNs < options.minTimeMs * 1000000.0);
+
+		const double nsPerOp = elapsedNs / static_cast<double>(ops);
+		const double pairsPerSec = pairs * 1000000000.0 / nsPerOp;
+		const double hitsPerOp = static_cast<double>(hits) / static_cast<double>(ops);
+		if (options.isCsv)
+		{
+			if (!hasHeader)
+			{
+				printf("name,ops,ns_per_op,pairs_per_sec,hits_per_op\n");
+				hasHeader = true;
+			}
+			printf("%s,%zu,%.3f,%.1f,%.4f\n", name, ops, nsPerOp, pairsPerSec, hitsPerOp);
+		}
+		else
+		{
+			printf("{\"name\":\"%s\",\"ops\":%zu,\"ns_per_op\":%.3f,"
+				"\"pairs_per_sec\":%.1f,\"hits_per_op\":%.4f}\n",
+				name, ops, nsPerOp, pairsPerSec, hitsPerOp);
+		}
+		fflush(stdout);
+	}
+
+private:
+	const Options& options;
+	bool hasHeader = false;
+};
+
+/*
+vp̃V[
+*/
+struct Scene
+{
+	explicit Scene(float extent) :
+		world(10.0f, glm::vec2(-mazeCellSize), glm::vec2(extent + mazeCellSize)),
+		spheres(world), capsules(world), walls(world), extent(extent)
+	{
+	}
+
+	World world;
+	ActorList spheres;  // AN^[()
+	ActorList capsules; // AN^[(JvZ)
+	ActorList walls;    // ȂAN^[(OBB̕)
+	float extent;       // V[1ӂ̒
+};
+
+/*
+ǂǉ
+
+@param walls ǉ̃Xg
+@param pos   ǂ̒SW
+@param axis  0ȂXA1ȂZɐLт
+*/
+void AddWall(ActorList& walls, const glm::vec3& pos, int axis)
+{
+	const glm::vec3 e = axis == 0 ? glm::vec3(2, 2, 0.5f) : glm::vec3(0.5f, 2, 2);
+	ActorPtr p = std::make_shared<Actor>("StoneWall", 100, pos);
+	p->colLocal = Collision::CreateOBB(glm::vec3(0, 0, 0),
+		glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(0, 0, -1), e);
+	p->SetCollisionLayer(Collision::Layer::obstacle);
+	walls.Add(p);
+}
+
+/*
+̋ڂɕǂׂ
+
+@param walls ǉ̃Xg
+@param x     XW
+@param z     ZW
+@param axis  0Ȃ̖k(X̐ɐLт)A1Ȃ̐(Z̐ɐLт)
+*/
+void AddCellEdge(ActorList& walls, int x, int z, int axis)
+{
+	const glm::vec3 origin(x * mazeCellSize, 0, z * mazeCellSize);
+	for (float d = wallLength * 0.5f; d < mazeCellSize; d += wallLength)
+	{
+		AddWall(walls, origin + (axis == 0 ? glm::vec3(d, 0, 0) : glm::vec3(0, 0, d)), axis);
+	}
+}
+
+/*
+Hɕǂzu
+
+@param walls ǉ̃Xg
+@param size  H1ӂ̋搔
+@param rand  
+
+[DTŒʘH@Ac̋ڂƊOɕǂu
+*/
+void BuildMaze(ActorList& walls, int size, std::mt19937& rand)
+{
+	// e̖kƐɕǂ邩(O̓쑤Ɠ͍Ōɒǉ)
+	std::vector<uint8_t> northWall(size * size, 1);
+	std::vector<uint8_t> westWall(size * size, 1);
+	std::vector<uint8_t> visited(size * size, 0);
+	std::vector<int> stack;
+	stack.push_back(0);
+	visited[0] = 1;
+	while (!stack.empty())
+	{
+		const int cell = stack.back();
+		const int x = cell % size;
+		const int z = cell / size;
+		int next[4];
+		int nextCount = 0;
+		if (x > 0 && !visited[cell - 1]) { next[nextCount++] = cell - 1; }
+		if (x + 1 < size && !visited[cell + 1]) { next[nextCount++] = cell + 1; }
+		if (z > 0 && !visited[cell - size]) { next[nextCount++] = cell - size; }
+		if (z + 1 < size && !visited[cell + size]) { next[nextCount++] = cell + size; }
+		if (nextCount == 0)
+		{
+			stack.pop_back();
+			continue;
+		}
+		const int n = next[std::uniform_int_distribution<int>(0, nextCount - 1)(rand)];
+		if (n == cell - 1) { westWall[cell] = 0; }
+		else if (n == cell + 1) { westWall[n] = 0; }
+		else if (n == cell - size) { northWall[cell] = 0; }
+		else { northWall[n] = 0; }
+		visited[n] = 1;
+		stack.push_back(n);
+	}
+
+	for (int z = 0; z < size; ++z)
+	{
+		for (int x = 0; x < size; ++x)
+		{
+			if (northWall[x + z * size])
+			{
+				AddCellEdge(walls, x, z, 0);
+			}
+			if (westWall[x + z * size])
+			{
+				AddCellEdge(walls, x, z, 1);
+			}
+		}
+		AddCellEdge(walls, size, z, 1);
+	}
+	for (int x = 0; x < size; ++x)
+	{
+		AddCellEdge(walls, x, size, 0);
+	}
+}
+
+/*
+V[̃_ȍW
+*/
+glm::vec3 RandomPosition(std::mt19937& rand, float extent, float y)
+{
+	// ̕]̓RpCɂĈႤ̂ŁAgԂŒ肷
+	std::uniform_real_distribution<float> d(0, extent);
+	const float x = d(rand);
+	const float z = d(rand);
+	return glm::vec3(x, y, z);
+}
+
+/*
+_Ȑ̒PʃxNg
+*/
+glm::vec3 RandomDirection(std::mt19937& rand)
+{
+	const float a = std::uniform_real_distribution<float>(0, 6.2831853f)(rand);
+	return glm::vec3(std::cos(a), 0, std::sin(a));
+}
+
+/*
+vp̃V[
+
+@param options v̐ݒ
+@param rand    
+
+@return 쐬V[
+*/
+std::unique_ptr<Scene> CreateScene(const Options& options, std::mt19937& rand)
+{
+	const float extent = options.mazeSize * mazeCellSize;
+	std::unique_ptr<Scene> scene(new Scene(extent));
+
+	scene->walls.Reserve(options.mazeSize * options.mazeSize * 4 + options.mazeSize * 4);
+	BuildMaze(scene->walls, options.mazeSize, rand);
+	scene->walls.SetStatic(true);
+
+	std::uniform_real_distribution<float> radius(0.5f, 1.5f);
+	scene->spheres.Reserve(options.sphereCount);
+	for (size_t i = 0; i < options.sphereCount; ++i)
+	{
+		ActorPtr p = std::make_shared<Actor>("Sphere", 1, RandomPosition(rand, extent, 1));
+		p->colLocal = Collision::CreateSphere(glm::vec3(0), radius(rand));
+		scene->spheres.Add(p);
+	}
+
+	scene->capsules.Reserve(options.capsuleCount);
+	for (size_t i = 0; i < options.capsuleCount; ++i)
+	{
+		ActorPtr p = std::make_shared<Actor>("Capsule", 1, RandomPosition(rand, extent, 0));
+		p->colLocal = Collision::CreateCapsule(glm::vec3(0, 0.5f, 0), glm::vec3(0, 1.5f, 0), 0.5f);
+		scene->capsules.Add(p);
+	}
+
+	// x0Ȃ̂ŁAʒuςɏՓˌ`󂾂[hWnɕϊ
+	scene->walls.Update(0);
+	scene->spheres.Update(0);
+	scene->capsules.Update(0);
+	return scene;
+}
+
+/*
+ڍהɎg`
+
+@param type `̎
+@param pos  `̒SW
+@param rand 
+*/
+Collision::Shape RandomShape(Collision::Shape::Type type, const glm::vec3& pos, std::mt19937& rand)
+{
+	std::uniform_real_distribution<float> size(0.5f, 1.5f);
+	switch (type)
+	{
+	case Collision::Shape::Type::sphere:
+		return Collision::CreateSphere(pos, size(rand));
+	case Collision::Shape::Type::capsule:
+	{
+		const glm::vec3 d = RandomDirection(rand) * size(rand);
+		const float r = size(rand) * 0.5f;
+		return Collision::CreateCapsule(pos - d, pos + d, r);
+	}
+	default:
+	{
+		const glm::vec3 x = RandomDirection(rand);
+		glm::vec3 e;
+		for (int i = 0; i < 3; ++i)
+		{
+			e[i] = size(rand);
+		}
+		return Collision::CreateOBB(pos, x, glm::vec3(0, 1, 0), glm::cross(x, glm::vec3(0, 1, 0)), e);
+	}
+	}
+}
+
+/*
+`̑gݍ킹Ƃɏڍהv
+*/
+void BenchNarrowphase(Reporter& reporter, std::mt19937& rand)
+{
+	using Type = Collision::Shape::Type;
+	static const struct
+	{
+		const char* name;
+		Type a;
+		Type b;
+	} combinations[] = {
+		{ "narrow/sphere-sphere", Type::sphere, Type::sphere },
+		{ "narrow/sphere-capsule", Type::sphere, Type::capsule },
+		{ "narrow/sphere-obb", Type::sphere, Type::obb },
+		{ "narrow/capsule-capsule", Type::capsule, Type::capsule },
+		{ "narrow/capsule-obb", Type::capsule, Type::obb },
+		{ "narrow/obb-obb", Type::obb, Type::obb },
+	};
+
+	// xՓ˂悤ɁASm̋0`4ɂ΂
+	std::uniform_real_distribution<float> distance(0, 4);
+	std::vector<Collision::Shape> a(narrowPairCount);
+	std::vector<Collision::Shape> b(narrowPairCount);
+	for (const auto& e : combinations)
+	{
+		for (size_t i = 0; i < narrowPairCount; ++i)
+		{
+			const glm::vec3 pos = RandomPosition(rand, 100, 0);
+			a[i] = RandomShape(e.a, pos, rand);
+			const glm::vec3 dir = RandomDirection(rand);
+			b[i] = RandomShape(e.b, pos + dir * distance(rand), rand);
+		}
+		reporter.Run(e.name, 1, [&a, &b](size_t* hits) {
+			for (size_t i = 0; i < narrowPairCount; ++i)
+			{
+				glm::vec3 pa, pb;
+				*hits += Collision::TestShapeShape(a[i], b[i], &pa, &pb);
+			}
+			return narrowPairCount;
+		});
+	}
+
+	// 1̋Ƒ̌`܂Ƃ߂Ĕ肷֐
+	std::vector<Collision::Sphere> s(narrowPairCount);
+	Collision::SphereSoA spheres;
+	Collision::CapsuleSoA capsules;
+	Collision::OBBSoA obbs;
+	for (size_t i = 0; i < narrowPairCount; ++i)
+	{
+		const glm::vec3 pos = RandomPosition(rand, 20, 0);
+		s[i] = RandomShape(Type::sphere, pos, rand).s;
+		spheres.Push(RandomShape(Type::sphere, pos, rand).s);
+		capsules.Push(RandomShape(Type::capsule, pos, rand).c);
+		obbs.Push(RandomShape(Type::obb, pos, rand).obb);
+	}
+	std::vector<uint32_t> hitMask((narrowPairCount + 31) / 32);
+	std::vector<glm::vec3> p(narrowPairCount);
+	const size_t batchQueries = 16; // 1̌ĂяoŔ肷鋅̐
+	reporter.Run("batch/sphere-sphere", 1, [&](size_t* hits) {
+		for (size_t i = 0; i < batchQueries; ++i)
+		{
+			*hits += Collision::TestSphereSphereBatch(s[i], spheres, hitMask.data(), p.data());
+		}
+		return batchQueries * narrowPairCount;
+	});
+	reporter.Run("batch/sphere-capsule", 1, [&](size_t* hits) {
+		for (size_t i = 0; i < batchQueries; ++i)
+		{
+			*hits += Collision::TestSphereCapsuleBatch(s[i], capsules, hitMask.data(), p.data());
+		}
+		return batchQueries * narrowPairCount;
+	});
+	reporter.Run("batch/sphere-obb", 1, [&](size_t* hits) {
+		for (size_t i = 0; i < batchQueries; ++i)
+		{
+			*hits += Collision::TestSphereOBBBatch(s[i], obbs, hitMask.data(), p.data());
+		}
+		return batchQueries * narrowPairCount;
+	});
+}
+
+/*
+XgmDetectCollisionv
+
+cold͖ڐGLbVđSĂ̑gݍ킹𔻒肵
+warm͖t[i߂邾Ȃ̂ŁAǑʂ̍ėpƖAN^[̏ȗ
+*/
+void BenchDetectCollision(Reporter& reporter, Scene& scene)
+{
+	ContactCache& cache = scene.world.Contacts();
+	const auto bench = [&reporter, &cache](const char* name, ActorList& a, ActorList& b, bool isWarm) {
+		if (!reporter.IsEnabled(name))
+		{
+			return;
+		}
+		cache.Clear();
+		reporter.Run(name, static_cast<double>(a.Size()) * static_cast<double>(b.Size()),
+			[&a, &b, &cache, isWarm](size_t* hits) {
+			if (isWarm)
+			{
+				cache.BeginFrame();
+			}
+			else
+			{
+				cache.Clear();
+			}
+			DetectCollision(a, b, [hits](const ActorPtr&, const ActorPtr&, const glm::vec3&) {
+				++*hits;
+			});
+			return static_cast<size_t>(1);
+		});
+	};
+	bench("detect/spheres-walls/cold", scene.spheres, scene.walls, false);
+	bench("detect/spheres-walls/warm", scene.spheres, scene.walls, true);
+	bench("detect/spheres-capsules/cold", scene.spheres, scene.capsules, false);
+	bench("detect/spheres-capsules/warm", scene.spheres, scene.capsules, true);
+	bench("detect/capsules-walls/cold", scene.capsules, scene.walls, false);
+	bench("detect/capsules-walls/warm", scene.capsules, scene.walls, true);
+	cache.Clear();
+}
+
+/*
+ߖTv
+*/
+void BenchQuery(Reporter& reporter, Scene& scene, std::mt19937& rand)
+{
+	std::vector<glm::vec3> points(queryCount);
+	for (glm::vec3& e : points)
+	{
+		e = RandomPosition(rand, scene.extent, 1);
+	}
+	reporter.Run("query/list-nearby", static_cast<double>(scene.spheres.Size()),
+		[&scene, &points](size_t* hits) {
+		for (const glm::vec3& e : points)
+		{
+			*hits += scene.spheres.FindNearbyActors(e, queryRadius).size();
+		}
+		return points.size();
+	});
+	const double total = static_cast<double>(
+		scene.spheres.Size() + scene.capsules.Size() + scene.walls.Size());
+	reporter.Run("query/world-nearby", total, [&scene, &points](size_t* hits) {
+		for (const glm::vec3& e : points)
+		{
+			*hits += scene.world.FindNearbyActors(e, queryRadius).size();
+		}
+		return points.size();
+	});
+}
+
+/*
+Čv
+*/
+void BenchRaycast(Reporter& reporter, Scene& scene, std::mt19937& rand)
+{
+	std::vector<glm::vec3> origins(queryCount);
+	std::vector<glm::vec3> dirs(queryCount);
+	for (size_t i = 0; i < queryCount; ++i)
+	{
+		origins[i] = RandomPosition(rand, scene.extent, 1);
+		dirs[i] = RandomDirection(rand);
+	}
+	const double total = static_cast<double>(
+		scene.spheres.Size() + scene.capsules.Size() + scene.walls.Size());
+	reporter.Run("raycast/world-closest", total, [&](size_t* hits) {
+		for (size_t i = 0; i < queryCount; ++i)
+		{
+			World::RaycastHit hit;
+			*hits += scene.world.Raycast(origins[i], dirs[i], rayLength, &hit);
+		}
+		return queryCount;
+	});
+	std::vector<World::RaycastHit> all;
+	reporter.Run("raycast/world-all", total, [&](size_t* hits) {
+		for (size_t i = 0; i < queryCount; ++i)
+		{
+			all.clear();
+			*hits += scene.world.RaycastAll(origins[i], dirs[i], rayLength, all);
+		}
+		return queryCount;
+	});
+	reporter.Run("raycast/walls-closest", static_cast<double>(scene.walls.Size()), [&](size_t* hits) {
+		for (size_t i = 0; i < queryCount; ++i)
+		{
+			size_t index;
+			float t;
+			*hits += scene.walls.Raycast(origins[i], dirs[i], rayLength, &index, &t);
+		}
+		return queryCount;
+	});
+}
+
+/*
+oHׁAoH̒vZ
+
+@param path     ToH
+@param start    X^[gn_̊iq
+@param goal     S[n_̊iq
+@param walkable iqʂ邩ׂ֐(T͈͂̊O͒ʂȂƂ邱)
+@param length   oH̒̊i[(c̈ړ1A΂߂̈ړ́2)
+
+@retval true  X^[gS[܂ŗׂ荇iqǂAʂȂiqʂ炸A
+              ΂߂̈ړŕǂ̊p蔲Ȃ
+@retval false oHȂ
+*/
+bool MeasurePath(const std::vector<glm::ivec2>& path, const glm::ivec2& start, const glm::ivec2& goal,
+	const Astar::WalkableFunc& walkable, float* length)
+{
+	*length = 0;
+	if (path.empty() || path.front() != start || path.back() != goal)
+	{
+		return false;
+	}
+	for (size_t i = 1; i < path.size(); ++i)
+	{
+		const glm::ivec2 d = path[i] - path[i - 1];
+		if (std::abs(d.x) > 1 || std::abs(d.y) > 1 || (d.x == 0 && d.y == 0))
+		{
+			return false;
+		}
+		if (!walkable(path[i].x, path[i].y))
+		{
+			return false;
+		}
+		if (d.x != 0 && d.y != 0)
+		{
+			if (!walkable(path[i - 1].x + d.x, path[i - 1].y) || !walkable(path[i - 1].x, path[i - 1].y + d.y))
+			{
+				return false;
+			}
+			*length += 1.41421356f;
+		}
+		else
+		{
+			*length += 1;
+		}
+	}
+	return true;
+}
+
+/*
+JPSJPS+̌ʂA*̌ʂƔׂ
+
+@param method   ׂT̖O(s̕\p)
+@param isFound  ׂTŌoHǂ
+@param path     ׂŤoH
+@param isFoundA A*ŌoHǂ
+@param pathA    A*̌oH
+@param start    X^[gn_̊iq
+@param goal     S[n_̊iq
+@param walkable iqʂ邩ׂ֐(T͈͂̊O͒ʂȂƂ邱)
+
+@retval true  ǂȂA܂͂ǂoHŒ
+@retval false ʂvȂ
+*/
+bool IsSameResult(const char* method, bool isFound, const std::vector<glm::ivec2>& path,
+	bool isFoundA, const std::vector<glm::ivec2>& pathA,
+	const glm::ivec2& start, const glm::ivec2& goal, const Astar::WalkableFunc& walkable)
+{
+	if (isFound != isFoundA)
+	{
+		fprintf(stderr, "%s: (%d, %d)->(%d, %d) found=%d, astar found=%d\n",
+			method, start.x, start.y, goal.x, goal.y, isFound, isFoundA);
+		return false;
+	}
+	if (!isFound)
+	{
+		return true;
+	}
+	float length = 0;
+	float lengthA = 0;
+	const bool isValid = MeasurePath(path, start, goal, walkable, &length);
+	const bool isValidA = MeasurePath(pathA, start, goal, walkable, &lengthA);
+	if (!isValid || !isValidA || std::abs(length - lengthA) > lengthA * 1e-5f + 1e-4f)
+	{
+		fprintf(stderr, "%s: (%d, %d)->(%d, %d) valid=%d length=%f, astar valid=%d length=%f\n",
+			method, start.x, start.y, goal.x, goal.y, isValid, length, isValidA, lengthA);
+		return false;
+	}
+	return true;
+}
+
+/*
+œhiqŁAJPSA*̌ʂׂ
+
+@param count ׂ
+@param rand  
+
+@return ʂvȂ
+
+iq̑傫Aǂ̖xAT͈͂_ɕς
+T͈͂͊iq͂ݏoꍇƁAX^[gS[͈͊Oǂ̒ɂȂꍇ܂
+*/
+size_t VerifyJumpPoint(int count, std::mt19937& rand)
+{
+	size_t failures = 0;
+	Astar astar;
+	Astar jps;
+	astar.SetJumpPointEnabled(false);
+	std::vector<uint8_t> blocked;
+	std::vector<glm::ivec2> pathA;
+	std::vector<glm::ivec2> path;
+	for (int n = 0; n < count; ++n)
+	{
+		const glm::ivec2 size(5 + rand() % 40, 5 + rand() % 40);
+		const unsigned int density = rand() % 500;
+		blocked.resize(size.x * size.y);
+		for (uint8_t& e : blocked)
+		{
+			e = rand() % 1000 < density;
+		}
+		const glm::ivec2 areaMin(static_cast<int>(rand() % 3) - 1, static_cast<int>(rand() % 3) - 1);
+		const glm::ivec2 areaMax(size.x - 1 - static_cast<int>(rand() % 3), size.y - 1 - static_cast<int>(rand() % 3));
+		const glm::ivec2 start(rand() % size.x, rand() % size.y);
+		const glm::ivec2 goal(rand() % size.x, rand() % size.y);
+		const auto isWalkable = [&blocked, size](int x, int z)
+		{
+			return x >= 0 && z >= 0 && x < size.x && z < size.y && !blocked[z * size.x + x];
+		};
+		// Astar̓X^[gƃS[ʂiqƂĈAT͈͂̊Oɂ͏oȂ
+		const auto isWalkableInArea = [&](int x, int z)
+		{
+			const glm::ivec2 cell(x, z);
+			if (cell == start || cell == goal)
+			{
+				return true;
+			}
+			return isWalkable(x, z) && x >= areaMin.x && z >= areaMin.y && x <= areaMax.x && z <= areaMax.y;
+		};
+
+		astar.SetArea(areaMin, areaMax);
+		jps.SetArea(areaMin, areaMax);
+		const bool isFoundA = astar.FindPath(start, goal, isWalkable, pathA);
+		const bool isFound = jps.FindPath(start, goal, isWalkable, path);
+		if (jps.GetMethod() != Astar::Method::jps)
+		{
+			fprintf(stderr, "jps: method is not jps\n");
+			++failures;
+		}
+		else if (!IsSameResult("jps", isFound, path, isFoundA, pathA, start, goal, isWalkableInArea))
+		{
+			++failures;
+		}
+	}
+	return failures;
+}
+
+/*
+NavGridŁAJPSJPS+̌ʂA*̌ʂƔׂ
+
+@param count    ׂ
+@param rand     
+@param grid     Tiq
+@param map      JPS+̃Wv
+@param isStale  trueȂgrid`ƂŁAmap͌Â(JPS+̑JPSg͂)
+@param astar    TɎgAstar(A*AJPSAJPS+̏BƗ̈g񂷂ߌĂяoŎ)
+
+@return ʂvȂ
+
+T͈͂́AiqŜƁAiq̈ꕔ(iq͂ݏoꍇ܂)݂Ɏg
+iq̈ꕔTꍇAJPS+͕\̃WvT͈͂̒[Ő؂l߂
+*/
+size_t VerifyJumpPointMap(int count, std::mt19937& rand, const NavGrid& grid, const JumpPointMap& map,
+	bool isStale, Astar (&astar)[3])
+{
+	static const char* const names[] = { "astar", "jps", "jps+" };
+	size_t failures = 0;
+	std::vector<glm::ivec2> paths[3];
+	bool isFound[3];
+	astar[0].SetJumpPointEnabled(false);
+	astar[2].SetJumpPointMap(&map);
+	const glm::ivec2 gridMin = grid.AreaMin();
+	const glm::ivec2 gridSize = grid.AreaMax() - gridMin + 1;
+	for (int n = 0; n < count; ++n)
+	{
+		glm::ivec2 areaMin = grid.AreaMin();
+		glm::ivec2 areaMax = grid.AreaMax();
+		if (n % 2)
+		{
+			areaMin = gridMin + glm::ivec2(rand() % gridSize.x, rand() % gridSize.y) - 40;
+			areaMax = areaMin + glm::ivec2(20 + rand() % 80, 20 + rand() % 80);
+		}
+		const glm::ivec2 areaSize = areaMax - areaMin + 1;
+		const glm::ivec2 start = glm::clamp(areaMin + glm::ivec2(rand() % areaSize.x, rand() % areaSize.y),
+			grid.AreaMin(), grid.AreaMax());
+		const glm::ivec2 goal = glm::clamp(areaMin + glm::ivec2(rand() % areaSize.x, rand() % areaSize.y),
+			grid.AreaMin(), grid.AreaMax());
+		const auto isWalkableInArea = [&](int x, int z)
+		{
+			const glm::ivec2 cell(x, z);
+			if (cell == start || cell == goal)
+			{
+				return true;
+			}
+			return grid.IsWalkable(x, z) && x >= areaMin.x && z >= areaMin.y && x <= areaMax.x && z <= areaMax.y;
+		};
+
+		for (int i = 0; i < 3; ++i)
+		{
+			astar[i].SetArea(areaMin, areaMax);
+			isFound[i] = astar[i].FindPath(start, goal, grid, paths[i]);
+		}
+
+		// \ÂꍇƁAX^[gS[ʂȂꍇJPS+̑JPSg
+		const bool canUseMap = !isStale &&
+			grid.IsWalkable(start.x, start.y) && grid.IsWalkable(goal.x, goal.y);
+		const Astar::Method expected[] = { Astar::Method::astar, Astar::Method::jps,
+			canUseMap ? Astar::Method::jpsPlus : Astar::Method::jps };
+		for (int i = 0; i < 3; ++i)
+		{
+			if (astar[i].GetMethod() != expected[i])
+			{
+				fprintf(stderr, "%s: unexpected method %d\n", names[i], static_cast<int>(astar[i].GetMethod()));
+				++failures;
+			}
+		}
+		for (int i = 1; i < 3; ++i)
+		{
+			if (!IsSameResult(names[i], isFound[i], paths[i], isFound[0], paths[0], start, goal, isWalkableInArea))
+			{
+				++failures;
+			}
+		}
+	}
+	return failures;
+}
+
+/*
+JPSJPS+A*Ɠ̌oHԂ؂
+
+@param options ؂̐ݒ
+@param rand    
+
+@return ʂvȂ
+
+QׂNavGridł́A\쐬ƁAQǉĊiq`A
+\蒼3̏ԂŔׂ
+*/
+size_t VerifyPathfinding(const Options& options, std::mt19937& rand)
+{
+	const int gridSize = 256;
+	size_t failures = VerifyJumpPoint(options.verifyCount, rand);
+	fprintf(stdout, "verify jps grid: %d cases, %zu failures\n", options.verifyCount, failures);
+
+	// ǂƒׂ
+	World world(16, glm::vec2(0), glm::vec2(gridSize));
+	ActorList obstacles(world);
+	for (int i = 0; i < gridSize * gridSize / 60; ++i)
+	{
+		ActorPtr p = std::make_shared<Actor>("Obstacle", 100,
+			glm::vec3(rand() % gridSize, 0, rand() % gridSize), glm::vec3(0, glm::radians(90.0f * (rand() % 4)), 0));
+		if (rand() % 2)
+		{
+			p->colLocal = Collision::CreateOBB(glm::vec3(0),
+				glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(0, 0, -1),
+				glm::vec3(1 + rand() % 8, 2, 0.5f));
+		}
+		else
+		{
+			p->colLocal = Collision::CreateSphere(glm::vec3(0), 0.3f + (rand() % 10) * 0.1f);
+		}
+		obstacles.Add(p);
+	}
+	obstacles.SetStatic(true);
+	obstacles.Update(0);
+
+	NavGrid grid;
+	grid.Build(glm::ivec2(0), glm::ivec2(gridSize - 1), nullptr, &obstacles);
+	JumpPointMap map;
+	map.Build(grid);
+	Astar astar[3];
+	size_t mapFailures = VerifyJumpPointMap(options.verifyCount, rand, grid, map, false, astar);
+
+	// Qǉƕ\ÂȂAJPSŒT͂
+	ActorPtr p = std::make_shared<Actor>("Obstacle", 100,
+		glm::vec3(rand() % gridSize, 0, rand() % gridSize), glm::vec3(0));
+	p->colLocal = Collision::CreateSphere(glm::vec3(0), 4);
+	obstacles.Add(p);
+	obstacles.Update(0);
+	grid.Refresh(p->colWorld);
+	if (map.IsValid(grid))
+	{
+		fprintf(stderr, "jps+: map is still valid after NavGrid::Refresh()\n");
+		++mapFailures;
+	}
+	mapFailures += VerifyJumpPointMap(options.verifyCount, rand, grid, map, true, astar);
+
+	// \蒼΁A܂JPS+ŒT͂
+	map.Build(grid);
+	mapFailures += VerifyJumpPointMap(options.verifyCount, rand, grid, map, false, astar);
+	fprintf(stdout, "verify jps+ navgrid: %d cases, %zu failures\n", options.verifyCount * 3, mapFailures);
+
+	return failures + mapFailures;
+}
+
+} // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	for (int i = 1; i + 1 < argc; ++i)
+	{
+		if (strcmp(argv[i], "--spheres") == 0)
+		{
+			options.sphereCount = static_cast<size_t>(atoi(argv[++i]));
+		}
+		else if (strcmp(argv[i], "--capsules") == 0)
+		{
+			options.capsuleCount = static_cast<size_t>(atoi(argv[++i]));
+		}
+		else if (strcmp(argv[i], "--maze") == 0)
+		{
+			options.mazeSize = std::max(1, atoi(argv[++i]));
+		}
+		else if (strcmp(argv[i], "--seed") == 0)
+		{
+			options.seed = static_cast<unsigned int>(atoi(argv[++i]));
+		}
+		else if (strcmp(argv[i], "--time") == 0)
+		{
+			options.minTimeMs = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--workers") == 0)
+		{
+			options.workerCount = static_cast<size_t>(atoi(argv[++i]));
+		}
+		else if (strcmp(argv[i], "--format") == 0)
+		{
+			options.isCsv = strcmp(argv[++i], "csv") == 0;
+		}
+		else if (strcmp(argv[i], "--filter") == 0)
+		{
+			options.filter = argv[++i];
+		}
+		else if (strcmp(argv[i], "--verify") == 0)
+		{
+			options.verifyCount = std::max(1, atoi(argv[++i]));
+		}
+	}
+
+	// [J[0JobSystemg킸CXbhŏ
+	JobSystem& jobSystem = JobSystem::Instance();
+	if (options.workerCount > 0)
+	{
+		jobSystem.Initialize(options.workerCount);
+	}
+
+	std::mt19937 rand(options.seed);
+	if (options.verifyCount > 0)
+	{
+		const size_t failures = VerifyPathfinding(options, rand);
+		jobSystem.Finalize();
+		return failures > 0 ? 1 : 0;
+	}
+
+	Reporter reporter(options);
+	BenchNarrowphase(reporter, rand);
+	{
+		std::unique_ptr<Scene> scene = CreateScene(options, rand);
+		fprintf(stderr, "spheres: %zu  capsules: %zu  walls: %zu  simd: %s\n",
+			scene->spheres.Size(), scene->capsules.Size(), scene->walls.Size(),
+			Collision::BatchInstructionSet());
+		BenchDetectCollision(reporter, *scene);
+		BenchQuery(reporter, *scene, rand);
+		BenchRaycast(reporter, *scene, rand);
+	}
+
+	jobSystem.Finalize();
+	return 0;
+}
@@ -0,0 +1,66 @@
+/*
+@file Headless/GLFW/glfw3.h
+
+wbhXłŖ{glfw3.h̑ɓǂݍ܂wb_[
+
+̃vWFNggĂ^A萔A֐錾
+֐̎̂Headless/GLStub.cppɂAEBhE͑ugȂ
+glfwSetTime()Őݒ肵l̂܂ܕԂ
+*/
+#ifndef HEADLESS_GLFW3_H_INCLUDED
+#define HEADLESS_GLFW3_H_INCLUDED
+
+#define GLFW_RELEASE 0
+#define GLFW_PRESS 1
+
+#define GLFW_KEY_SPACE 32
+#define GLFW_KEY_A 65
+#define GLFW_KEY_D 68
+#define GLFW_KEY_I 73
+#define GLFW_KEY_J 74
+#define GLFW_KEY_K 75
+#define GLFW_KEY_L 76
+#define GLFW_KEY_O 79
+#define GLFW_KEY_S 83
+#define GLFW_KEY_U 85
+#define GLFW_KEY_W 87
+#define GLFW_KEY_ESCAPE 256
+#define GLFW_KEY_ENTER 257
+#define GLFW_KEY_LAST 348
+
+#define GLFW_MOUSE_BUTTON_1 0
+#define GLFW_MOUSE_BUTTON_LEFT GLFW_MOUSE_BUTTON_1
+#define GLFW_MOUSE_BUTTON_LAST 7
+
+#define GLFW_JOYSTICK_1 0
+
+#define GLFW_CURSOR 0x00033001
+#define GLFW_CURSOR_DISABLED 0x00034003
+
+typedef struct GLFWwindow GLFWwindow;
+typedef struct GLFWmonitor GLFWmonitor;
+typedef void(*GLFWerrorfun)(int, const char*);
+
+int glfwInit();
+void glfwTerminate();
+GLFWerrorfun glfwSetErrorCallback(GLFWerrorfun callback);
+
+GLFWwindow* glfwCreateWindow(int width, int height, const char* title,
+	GLFWmonitor* monitor, GLFWwindow* share);
+void glfwMakeContextCurrent(GLFWwindow* window);
+int glfwWindowShouldClose(GLFWwindow* window);
+void glfwPollEvents();
+void glfwSwapBuffers(GLFWwindow* window);
+
+void glfwSetInputMode(GLFWwindow* window, int mode, int value);
+int glfwGetKey(GLFWwindow* window, int key);
+int glfwGetMouseButton(GLFWwindow* window, int button);
+void glfwGetCursorPos(GLFWwindow* window, double* xpos, double* ypos);
+void glfwSetCursorPos(GLFWwindow* window, double xpos, double ypos);
+const float* glfwGetJoystickAxes(int jid, int* count);
+const unsigned char* glfwGetJoystickButtons(int jid, int* count);
+
+double glfwGetTime();
+void glfwSetTime(double time);
+
+#endif // !HEADLESS_GLFW3_H_INCLUDED
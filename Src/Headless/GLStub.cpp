@@ -0,0 +1,287 @@
+/*
+@file GLStub.cpp
+
+wbhXłŎgOpenGL/GLEW/GLFW̑pi
+
+IuWFNg̍쐬͘AԂ̖OԂŁAGPUɂ͉Ȃ
+VF[_[̃RpC⃊N͏ɐƂɂ
+eNX`̑傫͋L^ĂAglGetTexLevelParameteriv()ŕԂ
+L[̏ԂHeadless::SetKey()Őݒ肷
+*/
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include "HeadlessInput.h"
+#include <unordered_map>
+
+namespace /* unnamed */ {
+
+GLuint nextName = 1;          // ɍ쐬IuWFNg̖O
+GLuint boundTexture = 0;      // ŌɃoChꂽeNX`
+double currentTime = 0;       // glfwGetTime()Ԃ
+GLFWerrorfun errorCallback = nullptr;
+bool keyState[GLFW_KEY_LAST + 1] = {}; // glfwGetKey()ԂL[̏
+
+// eNX`̑傫
+struct TextureSize
+{
+	GLint width = 0;
+	GLint height = 0;
+};
+std::unordered_map<GLuint, TextureSize> textureSizes;
+
+// EBhȆɕԂ_~[
+struct DummyWindow
+{
+	int width = 0;
+	int height = 0;
+} dummyWindow;
+
+/*
+IuWFNg̖O쐬
+
+@param n     쐬鐔
+@param names O̊i[
+*/
+void GenNames(GLsizei n, GLuint* names)
+{
+	for (GLsizei i = 0; i < n; ++i)
+	{
+		names[i] = nextName++;
+	}
+}
+
+} // unnamed namespace
+
+namespace Headless
+{
+	/*
+	L[̏Ԃݒ肷
+
+	@param key     L[ER[h(GLFW_KEY_AȂ)
+	@param pressed Ătrue
+	*/
+	void SetKey(int key, bool pressed)
+	{
+		if (key >= 0 && key <= GLFW_KEY_LAST)
+		{
+			keyState[key] = pressed;
+		}
+	}
+
+	/*
+	ׂẴL[𗣂
+	*/
+	void ReleaseAllKeys()
+	{
+		for (bool& e : keyState)
+		{
+			e = false;
+		}
+	}
+} // namespace Headless
+
+GLenum glewInit() { return GLEW_OK; }
+
+void glEnable(GLenum) {}
+void glDisable(GLenum) {}
+void glBlendFunc(GLenum, GLenum) {}
+void glClearColor(GLfloat, GLfloat, GLfloat, GLfloat) {}
+void glClear(GLbitfield) {}
+void glPixelStorei(GLenum, GLint) {}
+
+GLenum glGetError() { return GL_NO_ERROR; }
+
+const GLubyte* glGetString(GLenum name)
+{
+	static const GLubyte renderer[] = "Headless";
+	static const GLubyte version[] = "4.5 (Headless)";
+	return name == GL_VERSION ? version : renderer;
+}
+
+void glGetIntegerv(GLenum pname, GLint* data)
+{
+	switch (pname)
+	{
+	case GL_MAX_VERTEX_ATTRIBS: *data = 16; break;
+	case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT: *data = 256; break;
+	default: *data = 0; break;
+	}
+}
+
+void glGenBuffers(GLsizei n, GLuint* buffers) { GenNames(n, buffers); }
+void glDeleteBuffers(GLsizei, const GLuint*) {}
+void glBindBuffer(GLenum, GLuint) {}
+void glBindBufferBase(GLenum, GLuint, GLuint) {}
+void glBindBufferRange(GLenum, GLuint, GLuint, GLintptr, GLsizeiptr) {}
+void glBufferData(GLenum, GLsizeiptr, const void*, GLenum) {}
+void glBufferSubData(GLenum, GLintptr, GLsizeiptr, const void*) {}
+
+void glGenVertexArrays(GLsizei n, GLuint* arrays) { GenNames(n, arrays); }
+void glDeleteVertexArrays(GLsizei, const GLuint*) {}
+void glBindVertexArray(GLuint) {}
+void glEnableVertexAttribArray(GLuint) {}
+void glDisableVertexAttribArray(GLuint) {}
+void glVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) {}
+
+void glDrawElements(GLenum, GLsizei, GLenum, const void*) {}
+void glDrawElementsBaseVertex(GLenum, GLsizei, GLenum, const void*, GLint) {}
+
+void glGenTextures(GLsizei n, GLuint* textures) { GenNames(n, textures); }
+
+void glDeleteTextures(GLsizei n, const GLuint* textures)
+{
+	for (GLsizei i = 0; i < n; ++i)
+	{
+		textureSizes.erase(textures[i]);
+	}
+}
+
+void glActiveTexture(GLenum) {}
+void glBindTexture(GLenum, GLuint texture) { boundTexture = texture; }
+
+void glTexImage2D(GLenum, GLint level, GLint, GLsizei width, GLsizei height,
+	GLint, GLenum, GLenum, const void*)
+{
+	if (level == 0)
+	{
+		textureSizes[boundTexture] = { width, height };
+	}
+}
+
+void glCompressedTexImage2D(GLenum, GLint level, GLenum, GLsizei width,
+	GLsizei height, GLint, GLsizei, const void*)
+{
+	if (level == 0)
+	{
+		textureSizes[boundTexture] = { width, height };
+	}
+}
+
+void glTexParameteri(GLenum, GLenum, GLint) {}
+void glTexParameteriv(GLenum, GLenum, const GLint*) {}
+
+void glGetTexLevelParameteriv(GLenum, GLint, GLenum pname, GLint* params)
+{
+	const TextureSize& size = textureSizes[boundTexture];
+	switch (pname)
+	{
+	case GL_TEXTURE_WIDTH: *params = size.width; break;
+	case GL_TEXTURE_HEIGHT: *params = size.height; break;
+	default: *params = 0; break;
+	}
+}
+
+void glTexBuffer(GLenum, GLenum, GLuint) {}
+
+void glGenFramebuffers(GLsizei n, GLuint* framebuffers) { GenNames(n, framebuffers); }
+void glDeleteFramebuffers(GLsizei, const GLuint*) {}
+void glBindFramebuffer(GLenum, GLuint) {}
+void glFramebufferTexture2D(GLenum, GLenum, GLenum, GLuint, GLint) {}
+
+GLuint glCreateShader(GLenum) { return nextName++; }
+void glDeleteShader(GLuint) {}
+void glShaderSource(GLuint, GLsizei, const GLchar* const*, const GLint*) {}
+void glCompileShader(GLuint) {}
+
+void glGetShaderiv(GLuint, GLenum pname, GLint* params)
+{
+	*params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+void glGetShaderInfoLog(GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+{
+	if (length)
+	{
+		*length = 0;
+	}
+	if (infoLog && bufSize > 0)
+	{
+		infoLog[0] = '\0';
+	}
+}
+
+GLuint glCreateProgram() { return nextName++; }
+void glDeleteProgram(GLuint) {}
+void glAttachShader(GLuint, GLuint) {}
+void glLinkProgram(GLuint) {}
+
+void glGetProgramiv(GLuint, GLenum pname, GLint* params)
+{
+	*params = pname == GL_LINK_STATUS ? GL_TRUE : 0;
+}
+
+void glGetProgramInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+{
+	glGetShaderInfoLog(shader, bufSize, length, infoLog);
+}
+
+void glUseProgram(GLuint) {}
+
+GLint glGetUniformLocation(GLuint, const GLchar*) { return 0; }
+GLuint glGetUniformBlockIndex(GLuint, const GLchar*) { return 0; }
+void glUniformBlockBinding(GLuint, GLuint, GLuint) {}
+void glUniform1i(GLint, GLint) {}
+void glUniform1f(GLint, GLfloat) {}
+void glUniform4f(GLint, GLfloat, GLfloat, GLfloat, GLfloat) {}
+void glUniform1iv(GLint, GLsizei, const GLint*) {}
+void glUniform3fv(GLint, GLsizei, const GLfloat*) {}
+void glUniform4fv(GLint, GLsizei, const GLfloat*) {}
+void glUniformMatrix4fv(GLint, GLsizei, GLboolean, const GLfloat*) {}
+
+int glfwInit() { return GL_TRUE; }
+void glfwTerminate() {}
+
+GLFWerrorfun glfwSetErrorCallback(GLFWerrorfun callback)
+{
+	const GLFWerrorfun prev = errorCallback;
+	errorCallback = callback;
+	return prev;
+}
+
+GLFWwindow* glfwCreateWindow(int width, int height, const char*, GLFWmonitor*, GLFWwindow*)
+{
+	dummyWindow.width = width;
+	dummyWindow.height = height;
+	return reinterpret_cast<GLFWwindow*>(&dummyWindow);
+}
+
+void glfwMakeContextCurrent(GLFWwindow*) {}
+int glfwWindowShouldClose(GLFWwindow*) { return 0; }
+void glfwPollEvents() {}
+void glfwSwapBuffers(GLFWwindow*) {}
+
+void glfwSetInputMode(GLFWwindow*, int, int) {}
+
+int glfwGetKey(GLFWwindow*, int key)
+{
+	if (key < 0 || key > GLFW_KEY_LAST)
+	{
+		return GLFW_RELEASE;
+	}
+	return keyState[key] ? GLFW_PRESS : GLFW_RELEASE;
+}
+
+int glfwGetMouseButton(GLFWwindow*, int) { return GLFW_RELEASE; }
+
+void glfwGetCursorPos(GLFWwindow*, double* xpos, double* ypos)
+{
+	*xpos = 0;
+	*ypos = 0;
+}
+
+void glfwSetCursorPos(GLFWwindow*, double, double) {}
+
+const float* glfwGetJoystickAxes(int, int* count)
+{
+	*count = 0;
+	return nullptr;
+}
+
+const unsigned char* glfwGetJoystickButtons(int, int* count)
+{
+	*count = 0;
+	return nullptr;
+}
+
+double glfwGetTime() { return currentTime; }
+void glfwSetTime(double time) { currentTime = time; }
@@ -0,0 +1,16 @@
+/*
+@file HeadlessInput.h
+*/
+#ifndef HEADLESSINPUT_H_INCLUDED
+#define HEADLESSINPUT_H_INCLUDED
+
+/*
+wbhXłglfwGetKey()ԂL[̏Ԃݒ肷֐
+*/
+namespace Headless
+{
+	void SetKey(int key, bool pressed);
+	void ReleaseAllKeys();
+} // namespace Headless
+
+#endif // !HEADLESSINPUT_H_INCLUDED
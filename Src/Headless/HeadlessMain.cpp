@@ -0,0 +1,309 @@
+/*
+@file HeadlessMain.cpp
+
+EBhEGPUg킸MainGameScenesAԂvvO
+
+R}hC:
+  --frames       st[(ȗ600)
+  --fps          1b̃t[(ȗ60)
+  --tick         1b̃V~[V(ȗ60)
+  --workers      WuVXẽ[J[Xbh(ȗ͘_RA-1)
+  --replay t@C  Q[{̂--recordĐ
+  --script t@C  eLXgt@Cs
+  --profile t@C ԂvAChromẽg[X`Ńt@Cɏo͂
+                       IɍŌ̃t[̓\
+  --spike ~b       --profilew莞A̎Ԃ𒴂t[̓\
+
+XNvg1sɁut[ L[...vÃt[L[
+L[W A S D J K U I O L ENTER̂ꂩBL[ȗƉȂ
+  ) 120 W       2bԑOi
+      30 W J      OiȂU
+      60          1bԉȂ
+*/
+#include "HeadlessInput.h"
+#include "../GLFWEW.h"
+#include "../Scene.h"
+#include "../MainGameScene.h"
+#include "../SkeletalMesh.h"
+#include "../JobSystem.h"
+#include "../Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace /* unnamed */ {
+
+// XNvg1s
+struct ScriptLine
+{
+	int frames = 0;        // L[t[
+	std::vector<int> keys; // L[
+};
+
+/*
+XNvgǂݍ
+
+@param filename t@C
+@param script   ǂݍ񂾃XNvg̊i[
+
+@retval true  ǂݍݐ
+@retval false ǂݍݎs
+*/
+bool LoadScript(const char* filename, std::vector<ScriptLine>& script)
+{
+	std::ifstream ifs(filename);
+	if (!ifs)
+	{
+		std::cerr << "[G[]" << __func__ << ": " << filename << "J܂\n";
+		return false;
+	}
+
+	static const struct
+	{
+		const char* name;
+		int key;
+	} keyNames[] = {
+		{ "W", GLFW_KEY_W }, { "A", GLFW_KEY_A }, { "S", GLFW_KEY_S }, { "D", GLFW_KEY_D },
+		{ "J", GLFW_KEY_J }, { "K", GLFW_KEY_K }, { "U", GLFW_KEY_U }, { "I", GLFW_KEY_I },
+		{ "O", GLFW_KEY_O }, { "L", GLFW_KEY_L }, { "ENTER", GLFW_KEY_ENTER },
+	};
+
+	std::string line;
+	for (int lineNo = 1; std::getline(ifs, line); ++lineNo)
+	{
+		std::istringstream iss(line);
+		ScriptLine e;
+		if (!(iss >> e.frames))
+		{
+			continue; // s
+		}
+		std::string name;
+		while (iss >> name)
+		{
+			const auto itr = std::find_if(std::begin(keyNames), std::end(keyNames),
+				[&name](const auto& k) { return name == k.name; });
+			if (itr == std::end(keyNames))
+			{
+				std::cerr << "[G[]" << __func__ << ": " << filename << "(" << lineNo <<
+					"): " << name << "͎gȂL[ł\n";
+				return false;
+			}
+			e.keys.push_back(itr->key);
+		}
+		script.push_back(e);
+	}
+	return true;
+}
+
+/*
+鏈̌v
+*/
+class PhaseTimer
+{
+public:
+	explicit PhaseTimer(const char* name) : name(name) {}
+
+	void Add(double ms) { samples.push_back(ms); }
+
+	/*
+	vʂo͂
+	*/
+	void Print() const
+	{
+		if (samples.empty())
+		{
+			return;
+		}
+		std::vector<double> sorted = samples;
+		std::sort(sorted.begin(), sorted.end());
+		double total = 0;
+		for (double e : sorted)
+		{
+			total += e;
+		}
+		const size_t p95 = std::min(sorted.size() - 1, sorted.size() * 95 / 100);
+		printf("%-12s %12.3f %10.4f %10.4f %10.4f %10.4f\n", name, total,
+			total / sorted.size(), sorted.front(), sorted[p95], sorted.back());
+	}
+
+private:
+	const char* name;
+	std::vector<double> samples; // t[Ƃ̏(~b)
+};
+
+/*
+oߎԂ~bŎ擾
+*/
+double ElapsedMs(std::chrono::steady_clock::time_point begin,
+	std::chrono::steady_clock::time_point end)
+{
+	return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+} // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+	int frameCount = 600;
+	double fps = 60;
+	double tickRate = 60;
+	size_t workerCount = 0;
+	const char* replayFile = nullptr;
+	const char* scriptFile = nullptr;
+	const char* profileFile = nullptr;
+	double spikeThreshold = 0;
+	for (int i = 1; i + 1 < argc; ++i)
+	{
+		if (strcmp(argv[i], "--frames") == 0)
+		{
+			frameCount = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--fps") == 0)
+		{
+			fps = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--tick") == 0)
+		{
+			tickRate = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--workers") == 0)
+		{
+			workerCount = static_cast<size_t>(atoi(argv[++i]));
+		}
+		else if (strcmp(argv[i], "--replay") == 0)
+		{
+			replayFile = argv[++i];
+		}
+		else if (strcmp(argv[i], "--script") == 0)
+		{
+			scriptFile = argv[++i];
+		}
+		else if (strcmp(argv[i], "--profile") == 0)
+		{
+			profileFile = argv[++i];
+		}
+		else if (strcmp(argv[i], "--spike") == 0)
+		{
+			spikeThreshold = atof(argv[++i]);
+		}
+	}
+	if (fps <= 0)
+	{
+		fps = 60;
+	}
+
+	std::vector<ScriptLine> script;
+	if (scriptFile && !LoadScript(scriptFile, script))
+	{
+		return 1;
+	}
+
+	GLFWEW::Window& window = GLFWEW::Window::Instance();
+	window.Init(1920, 1080, "Headless");
+	window.SetFixedTimeStep(tickRate, 5);
+	window.SetDeterministic(true);
+	if (replayFile && !window.StartReplay(replayFile))
+	{
+		return 1;
+	}
+
+	Profiler& profiler = Profiler::Instance();
+	if (profileFile)
+	{
+		profiler.SetEnabled(true);
+		profiler.SetThreadName("Main");
+		profiler.SetSpikeThreshold(spikeThreshold);
+	}
+
+	Mesh::SkeletalAnimation::Initialize();
+	JobSystem& jobSystem = JobSystem::Instance();
+	jobSystem.Initialize(workerCount);
+
+	SceneStack& sceneStack = SceneStack::Instance();
+	sceneStack.Push(std::make_shared<MainGameScene>());
+
+	PhaseTimer simulation("simulation");
+	PhaseTimer drawData("drawdata");
+	PhaseTimer render("render");
+	PhaseTimer frame("frame");
+	int steps = 0;
+	int frames = 0;
+	size_t scriptLine = 0;
+	int scriptFrame = 0;
+
+	for (; frames < frameCount && !window.ShouldClose(); ++frames)
+	{
+		// XNvg̃L[͂ݒ肷
+		if (scriptLine < script.size())
+		{
+			Headless::ReleaseAllKeys();
+			for (int key : script[scriptLine].keys)
+			{
+				Headless::SetKey(key, true);
+			}
+			if (++scriptFrame >= script[scriptLine].frames)
+			{
+				++scriptLine;
+				scriptFrame = 0;
+			}
+		}
+		else if (!script.empty())
+		{
+			Headless::ReleaseAllKeys();
+		}
+
+		// v1t[i߂(Đ͋L^ꂽoߎԂg)
+		glfwSetTime((frames + 1) / fps);
+		profiler.BeginFrame();
+		window.UpdateTimer();
+
+		const auto t0 = std::chrono::steady_clock::now();
+		while (window.NextStep())
+		{
+			PROFILE_SCOPE("Simulation");
+			sceneStack.Update(static_cast<float>(window.DeltaTime()));
+			++steps;
+		}
+		const auto t1 = std::chrono::steady_clock::now();
+		Mesh::SkeletalAnimation::ResetUniformData();
+		sceneStack.UpdateDrawData(static_cast<float>(window.FrameDeltaTime()),
+			window.InterpolationAlpha());
+		Mesh::SkeletalAnimation::UploadUniformData();
+		const auto t2 = std::chrono::steady_clock::now();
+		sceneStack.Render();
+		const auto t3 = std::chrono::steady_clock::now();
+		profiler.EndFrame();
+
+		simulation.Add(ElapsedMs(t0, t1));
+		drawData.Add(ElapsedMs(t1, t2));
+		render.Add(ElapsedMs(t2, t3));
+		frame.Add(ElapsedMs(t0, t3));
+	}
+
+	printf("frames: %d  steps: %d  workers: %d\n", frames, steps,
+		static_cast<int>(jobSystem.WorkerCount()));
+	printf("%-12s %12s %10s %10s %10s %10s\n",
+		"phase", "total(ms)", "avg(ms)", "min(ms)", "p95(ms)", "max(ms)");
+	simulation.Print();
+	drawData.Print();
+	render.Print();
+	frame.Print();
+
+	if (profileFile)
+	{
+		profiler.SetEnabled(false);
+		profiler.PrintFrameSummary();
+		profiler.WriteChromeTrace(profileFile);
+	}
+
+	Mesh::SkeletalAnimation::Finalize();
+	jobSystem.Finalize();
+	return 0;
+}
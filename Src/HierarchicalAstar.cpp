@@ -0,0 +1,814 @@
+/*
+@file HierarchicalAstar.cpp
+*/
+#include "HierarchicalAstar.h"
+#include "Astar.h"
+#include "NavGrid.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <functional>
+#include <float.h>
+#include <stdlib.h>
+
+namespace /* unnamed */ {
+
+const float diagonalCost = 1.41421356f; // ΂߂ɈړRXg
+
+// ̕苷ʂ蓹͒ɓ1ALʂ蓹͗[ɓ2u
+const int maxSingleEntranceWidth = 6;
+
+// X^[gn_ƃS[n_̃m[hԍ(̓́uԍ * 256 + ԍv)
+const uint32_t startId = 0xfffffffe;
+const uint32_t goalId = 0xffffffff;
+
+/*
+ׂ̊iqւ̈ړ(AstarƓ)
+
+0`3͏cA4`7͎΂߁B΂߂̈ړɂaAb̏cʂKv
+*/
+const struct
+{
+	int dx;
+	int dz;
+	int a;
+	int b;
+} neighbors[8] = {
+	{ -1, 0, -1, -1 }, { 1, 0, -1, -1 }, { 0, -1, -1, -1 }, { 0, 1, -1, -1 },
+	{ -1, -1, 0, 2 }, { 1, -1, 1, 2 }, { -1, 1, 0, 3 }, { 1, 1, 1, 3 },
+};
+
+/*
+2̊iq̊Ԃ̐RXgvZ(Astar::Heuristic()ƓIN^C)
+*/
+inline float Octile(const glm::ivec2& a, const glm::ivec2& b)
+{
+	const int dx = abs(a.x - b.x);
+	const int dz = abs(a.y - b.y);
+	return static_cast<float>(dx + dz) + (diagonalCost - 2.0f) * static_cast<float>(std::min(dx, dz));
+}
+
+/*
+I[vXgabɎoׂ֐IuWFNg
+
+fȂg傫(S[ɋ߂)قɂ
+*/
+struct IsLater
+{
+	template<typename T>
+	bool operator()(const T& a, const T& b) const
+	{
+		return a.f > b.f || (a.f == b.f && a.g < b.g);
+	}
+};
+
+/*
+̃m[hԍ
+*/
+uint32_t ToNodeId(int cluster, int entrance)
+{
+	return (static_cast<uint32_t>(cluster) << 8) | static_cast<uint32_t>(entrance);
+}
+
+} // unnamed namespace
+
+const int HierarchicalAstar::clusterSize;
+
+/*
+쐬
+
+@param grid iqƂ̈ړRXg(̃IuWFNg蒷邱)
+*/
+void HierarchicalAstar::Build(const NavGrid* grid)
+{
+	PROFILE_SCOPE("HierarchicalAstar::Build");
+	this->grid = grid;
+	clusters.clear();
+	verticalBorders.clear();
+	horizontalBorders.clear();
+	generation = 0;
+	if (!grid)
+	{
+		areaSize = clusterCount = glm::ivec2(0);
+		return;
+	}
+
+	areaMin = grid->AreaMin();
+	areaSize = grid->AreaMax() - areaMin + 1;
+	clusterCount = (areaSize + clusterSize - 1) / clusterSize;
+	clusters.resize(static_cast<size_t>(clusterCount.x) * clusterCount.y);
+	for (int z = 0; z < clusterCount.y; ++z)
+	{
+		for (int x = 0; x < clusterCount.x; ++x)
+		{
+			Cluster& c = clusters[z * clusterCount.x + x];
+			c.cellMin = areaMin + glm::ivec2(x, z) * clusterSize;
+			c.cellMax = glm::min(c.cellMin + clusterSize - 1, grid->AreaMax());
+		}
+	}
+
+	verticalBorders.resize(static_cast<size_t>(std::max(clusterCount.x - 1, 0)) * clusterCount.y);
+	horizontalBorders.resize(static_cast<size_t>(clusterCount.x) * std::max(clusterCount.y - 1, 0));
+	for (int z = 0; z < clusterCount.y; ++z)
+	{
+		for (int x = 0; x < clusterCount.x; ++x)
+		{
+			UpdateBorder(glm::ivec2(x, z), glm::ivec2(x + 1, z));
+			UpdateBorder(glm::ivec2(x, z), glm::ivec2(x, z + 1));
+		}
+	}
+	for (int i = 0; i < static_cast<int>(clusters.size()); ++i)
+	{
+		BuildCluster(i);
+	}
+}
+
+/*
+Q̌`󂪏dȂvZ
+
+@param shape ǉE폜EړQ̏Փˌ`
+
+NavGrid::Refresh()Ŋiq`ƂŌĂяo
+*/
+void HierarchicalAstar::Refresh(const Collision::Shape& shape)
+{
+	glm::ivec2 cellMin, cellMax;
+	if (NavGrid::CellRange(shape, cellMin, cellMax))
+	{
+		Refresh(cellMin, cellMax);
+	}
+}
+
+/*
+w͈͂ɏdȂvZ
+
+@param cellMin `iq͈̔͂̍ŏW
+@param cellMax `iq͈̔͂̍őW(̍W͈͂Ɋ܂)
+
+͈͂ɏdȂ̋E̓ߒAςE̔Α̋vZ
+*/
+void HierarchicalAstar::Refresh(const glm::ivec2& cellMin, const glm::ivec2& cellMax)
+{
+	PROFILE_SCOPE("HierarchicalAstar::Refresh");
+	if (!grid || clusters.empty())
+	{
+		return;
+	}
+	const glm::ivec2 first = glm::max(cellMin, areaMin);
+	const glm::ivec2 last = glm::min(cellMax, areaMin + areaSize - 1);
+	if (first.x > last.x || first.y > last.y)
+	{
+		return;
+	}
+
+	const glm::ivec2 c0 = ClusterOf(first);
+	const glm::ivec2 c1 = ClusterOf(last);
+	std::vector<int> dirty;
+	for (int z = c0.y; z <= c1.y; ++z)
+	{
+		for (int x = c0.x; x <= c1.x; ++x)
+		{
+			dirty.push_back(z * clusterCount.x + x);
+			const glm::ivec2 c(x, z);
+			const glm::ivec2 sides[4] = { c - glm::ivec2(1, 0), c + glm::ivec2(1, 0), c - glm::ivec2(0, 1), c + glm::ivec2(0, 1) };
+			for (int i = 0; i < 4; ++i)
+			{
+				const glm::ivec2& other = sides[i];
+				if (other.x < 0 || other.y < 0 || other.x >= clusterCount.x || other.y >= clusterCount.y)
+				{
+					continue;
+				}
+				const bool isChanged = (i % 2 == 0) ? UpdateBorder(other, c) : UpdateBorder(c, other);
+				if (isChanged)
+				{
+					dirty.push_back(other.y * clusterCount.x + other.x);
+				}
+			}
+		}
+	}
+	std::sort(dirty.begin(), dirty.end());
+	dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+	for (const int i : dirty)
+	{
+		BuildCluster(i);
+	}
+}
+
+/*
+̓ǂāAoH̗vT
+
+@param start     X^[gn_̊iq
+@param goal      S[n_̊iq
+@param waypoints oH̗v̊i[(X^[gAʉ߂AS[̊iqɊi[)
+
+@retval true  oH
+@retval false X^[gS[iq͈̔͊OA܂͌oH݂Ȃ
+
+ׂ荇v̊Ԃ̌oHRefine()ŋ߂
+*/
+bool HierarchicalAstar::FindAbstractPath(const glm::ivec2& start, const glm::ivec2& goal,
+	std::vector<glm::ivec2>& waypoints)
+{
+	PROFILE_SCOPE("HierarchicalAstar::FindAbstractPath");
+	waypoints.clear();
+	expandedCount = 0;
+	if (!grid || !IsInGrid(start) || !IsInGrid(goal))
+	{
+		return false;
+	}
+
+	// Tԍi߂āAO܂ł̃m[hSĖgpɂ
+	if (++generation == 0)
+	{
+		for (Cluster& c : clusters)
+		{
+			for (Entrance& e : c.entrances)
+			{
+				e.search.generation = 0;
+			}
+		}
+		generation = 1;
+	}
+
+	// X^[g玩̋̓܂ŁA̋̓S[܂ł̃RXg߂Ă
+	const int startCluster = ClusterIndex(start);
+	const int goalCluster = ClusterIndex(goal);
+	const Cluster& sc = clusters[startCluster];
+	const Cluster& gc = clusters[goalCluster];
+	CalcDistances(sc, start, false, startCosts);
+	CalcDistances(gc, goal, true, goalCosts);
+	const int startWidth = sc.cellMax.x - sc.cellMin.x + 1;
+	const int goalWidth = gc.cellMax.x - gc.cellMin.x + 1;
+
+	open.clear();
+	GetSearchNode(goalId);
+	SearchNode& s = GetSearchNode(startId);
+	s.g = 0;
+	s.parent = startId;
+	open.push_back({ Octile(start, goal), 0.0f, startId });
+
+	while (!open.empty())
+	{
+		std::pop_heap(open.begin(), open.end(), IsLater());
+		const uint32_t id = open.back().id;
+		open.pop_back();
+		SearchNode& n = GetSearchNode(id);
+		if (n.isClosed)
+		{
+			continue;
+		}
+		n.isClosed = true;
+		++expandedCount;
+		const float g = n.g;
+
+		// S[ɒAeǂėvׂ
+		if (id == goalId)
+		{
+			waypoints.push_back(goal);
+			for (uint32_t i = n.parent; i != startId; i = GetSearchNode(i).parent)
+			{
+				const glm::ivec2& cell = clusters[i >> 8].entrances[i & 0xff].cell;
+				if (cell != waypoints.back())
+				{
+					waypoints.push_back(cell);
+				}
+			}
+			if (start != waypoints.back())
+			{
+				waypoints.push_back(start);
+			}
+			std::reverse(waypoints.begin(), waypoints.end());
+			return true;
+		}
+
+		// X^[ǵA̋̓(Ȃ)S[ɐi߂
+		if (id == startId)
+		{
+			for (int j = 0; j < static_cast<int>(sc.entrances.size()); ++j)
+			{
+				const glm::ivec2& cell = sc.entrances[j].cell;
+				const float cost = startCosts[(cell.y - sc.cellMin.y) * startWidth + (cell.x - sc.cellMin.x)];
+				if (cost < FLT_MAX)
+				{
+					Relax(ToNodeId(startCluster, j), id, cost, cell, goal);
+				}
+			}
+			if (startCluster == goalCluster)
+			{
+				const float cost = startCosts[(goal.y - sc.cellMin.y) * startWidth + (goal.x - sc.cellMin.x)];
+				if (cost < FLT_MAX)
+				{
+					Relax(goalId, id, cost, goal, goal);
+				}
+			}
+			continue;
+		}
+
+		// ́A̓ƁAĚ̓ɐi߂
+		const int k = static_cast<int>(id >> 8);
+		const int i = static_cast<int>(id & 0xff);
+		const Cluster& c = clusters[k];
+		const Entrance& e = c.entrances[i];
+		const glm::ivec2 cell = e.cell;
+		const int count = static_cast<int>(c.entrances.size());
+		for (int j = 0; j < count; ++j)
+		{
+			const float d = c.distances[i * count + j];
+			if (j != i && d < FLT_MAX)
+			{
+				Relax(ToNodeId(k, j), id, g + d, c.entrances[j].cell, goal);
+			}
+		}
+		for (int j = 0; j < e.linkCount; ++j)
+		{
+			Relax(e.links[j], id, g + e.linkCosts[j], e.linkCells[j], goal);
+		}
+		if (k == goalCluster)
+		{
+			const float d = goalCosts[(cell.y - gc.cellMin.y) * goalWidth + (cell.x - gc.cellMin.x)];
+			if (d < FLT_MAX)
+			{
+				Relax(goalId, id, g + d, goal, goal);
+			}
+		}
+	}
+	return false;
+}
+
+/*
+oH̗v̊Ԃ́Aiq̌oHT
+
+@param from  Ԃ̎n_(FindAbstractPath()Ԃv)
+@param to    Ԃ̏I_(from̗̎v)
+@param astar TɎgIuWFNg(XbhƂɗpӂ邱)
+@param path  oH̊i[(fromto܂ł̊iqɊi[)
+
+@retval true  oH
+@retval false oH݂Ȃ(v߂ƂŊiqꂽꍇȂ)
+
+fromto܂ދ̒T
+*/
+bool HierarchicalAstar::Refine(const glm::ivec2& from, const glm::ivec2& to,
+	Astar& astar, std::vector<glm::ivec2>& path) const
+{
+	path.clear();
+	if (!grid)
+	{
+		return false;
+	}
+
+	// ׂ̊iqȂTȂ(΂߂͏cׂ̗ʂꍇ)
+	const glm::ivec2 d = to - from;
+	if (abs(d.x) <= 1 && abs(d.y) <= 1)
+	{
+		if (d.x == 0 || d.y == 0 ||
+			(grid->IsWalkable(from.x + d.x, from.y) && grid->IsWalkable(from.x, from.y + d.y)))
+		{
+			path.push_back(from);
+			if (from != to)
+			{
+				path.push_back(to);
+			}
+			return true;
+		}
+	}
+
+	const int a = ClusterIndex(from);
+	const int b = ClusterIndex(to);
+	if (a < 0 || b < 0)
+	{
+		return false;
+	}
+	astar.SetArea(glm::min(clusters[a].cellMin, clusters[b].cellMin),
+		glm::max(clusters[a].cellMax, clusters[b].cellMax));
+	return astar.FindPath(from, to, *grid, path);
+}
+
+/*
+oHT
+
+@param start X^[gn_̊iq
+@param goal  S[n_̊iq
+@param astar v̊Ԃ̒TɎgIuWFNg
+@param path  oH̊i[(X^[gS[܂ł̊iqɊi[)
+
+@retval true  oH
+@retval false oH݂Ȃ
+
+FindAbstractPath()ŋ߂v̊ԂASRefine()Ŋiq̌oHɂ
+*/
+bool HierarchicalAstar::FindPath(const glm::ivec2& start, const glm::ivec2& goal,
+	Astar& astar, std::vector<glm::ivec2>& path)
+{
+	path.clear();
+	std::vector<glm::ivec2> waypoints;
+	if (!FindAbstractPath(start, goal, waypoints))
+	{
+		return false;
+	}
+	path.push_back(start);
+	std::vector<glm::ivec2> segment;
+	for (size_t i = 1; i < waypoints.size(); ++i)
+	{
+		if (!Refine(waypoints[i - 1], waypoints[i], astar, segment))
+		{
+			path.clear();
+			return false;
+		}
+		path.insert(path.end(), segment.begin() + 1, segment.end());
+	}
+	return true;
+}
+
+/*
+iq܂ދ̍W擾
+*/
+glm::ivec2 HierarchicalAstar::ClusterOf(const glm::ivec2& cell) const
+{
+	return (cell - areaMin) / clusterSize;
+}
+
+/*
+̑擾
+*/
+size_t HierarchicalAstar::NodeCount() const
+{
+	size_t count = 0;
+	for (const Cluster& c : clusters)
+	{
+		count += c.entrances.size();
+	}
+	return count;
+}
+
+/*
+iq܂ދ̔ԍ擾
+
+@return ̔ԍBiq͈͊OȂ-1
+*/
+int HierarchicalAstar::ClusterIndex(const glm::ivec2& cell) const
+{
+	if (!IsInGrid(cell))
+	{
+		return -1;
+	}
+	const glm::ivec2 c = ClusterOf(cell);
+	return c.y * clusterCount.x + c.x;
+}
+
+/*
+iqׂ͈͓
+*/
+bool HierarchicalAstar::IsInGrid(const glm::ivec2& cell) const
+{
+	const glm::ivec2 local = cell - areaMin;
+	return local.x >= 0 && local.y >= 0 && local.x < areaSize.x && local.y < areaSize.y;
+}
+
+/*
+2̋̋E̓߂
+
+@param a       悻1̍W
+@param b       悻2̍W(ảEׂ)
+@param offsets ́AE̐擪̋̊i[
+*/
+void HierarchicalAstar::FindBorderEntrances(const glm::ivec2& a, const glm::ivec2& b,
+	std::vector<int>& offsets) const
+{
+	offsets.clear();
+	const Cluster& ca = clusters[a.y * clusterCount.x + a.x];
+	const bool isVertical = b.x != a.x;
+	const int length = isVertical ? ca.cellMax.y - ca.cellMin.y + 1 : ca.cellMax.x - ca.cellMin.x + 1;
+
+	// E̗Ƃʂiq͈͂Aʂ蓹Ƃēu
+	int runStart = -1;
+	for (int i = 0; i <= length; ++i)
+	{
+		bool isOpen = false;
+		if (i < length)
+		{
+			const glm::ivec2 p = isVertical ?
+				glm::ivec2(ca.cellMax.x, ca.cellMin.y + i) : glm::ivec2(ca.cellMin.x + i, ca.cellMax.y);
+			const glm::ivec2 q = isVertical ? p + glm::ivec2(1, 0) : p + glm::ivec2(0, 1);
+			isOpen = grid->IsWalkable(p.x, p.y) && grid->IsWalkable(q.x, q.y);
+		}
+		if (isOpen && runStart < 0)
+		{
+			runStart = i;
+		}
+		else if (!isOpen && runStart >= 0)
+		{
+			const int width = i - runStart;
+			if (width < maxSingleEntranceWidth)
+			{
+				offsets.push_back(runStart + width / 2);
+			}
+			else
+			{
+				offsets.push_back(runStart);
+				offsets.push_back(i - 1);
+			}
+			runStart = -1;
+		}
+	}
+}
+
+/*
+2̋̋E̓ߒ
+
+@param a 悻1̍W
+@param b 悻2̍W(ảEׂ)
+
+@retval true  ς
+@retval false ͕ςȂA܂b͈͊O
+*/
+bool HierarchicalAstar::UpdateBorder(const glm::ivec2& a, const glm::ivec2& b)
+{
+	std::vector<int>* border = nullptr;
+	if (b.x != a.x)
+	{
+		if (b.x >= clusterCount.x)
+		{
+			return false;
+		}
+		border = &verticalBorders[a.y * (clusterCount.x - 1) + a.x];
+	}
+	else
+	{
+		if (b.y >= clusterCount.y)
+		{
+			return false;
+		}
+		border = &horizontalBorders[a.y * clusterCount.x + a.x];
+	}
+	thread_local std::vector<int> offsets;
+	FindBorderEntrances(a, b, offsets);
+	if (offsets == *border)
+	{
+		return false;
+	}
+	*border = offsets;
+	return true;
+}
+
+/*
+̓W߂āAǂ̍ŏRXgvZ
+
+@param index ̔ԍ
+*/
+void HierarchicalAstar::BuildCluster(int index)
+{
+	Cluster& c = clusters[index];
+	const glm::ivec2 pos(index % clusterCount.x, index / clusterCount.x);
+
+	// 4ӂ̋E̓W߂(̊p̊iq2̋Eŏd邱Ƃ)
+	thread_local std::vector<glm::ivec2> cells;
+	cells.clear();
+	if (pos.x > 0)
+	{
+		for (const int e : verticalBorders[pos.y * (clusterCount.x - 1) + pos.x - 1])
+		{
+			cells.emplace_back(c.cellMin.x, c.cellMin.y + e);
+		}
+	}
+	if (pos.x < clusterCount.x - 1)
+	{
+		for (const int e : verticalBorders[pos.y * (clusterCount.x - 1) + pos.x])
+		{
+			cells.emplace_back(c.cellMax.x, c.cellMin.y + e);
+		}
+	}
+	if (pos.y > 0)
+	{
+		for (const int e : horizontalBorders[(pos.y - 1) * clusterCount.x + pos.x])
+		{
+			cells.emplace_back(c.cellMin.x + e, c.cellMin.y);
+		}
+	}
+	if (pos.y < clusterCount.y - 1)
+	{
+		for (const int e : horizontalBorders[pos.y * clusterCount.x + pos.x])
+		{
+			cells.emplace_back(c.cellMin.x + e, c.cellMax.y);
+		}
+	}
+	std::sort(cells.begin(), cells.end(), [](const glm::ivec2& a, const glm::ivec2& b) {
+		return a.y < b.y || (a.y == b.y && a.x < b.x);
+	});
+	cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+	c.entrances.resize(cells.size());
+	for (size_t i = 0; i < cells.size(); ++i)
+	{
+		c.entrances[i] = Entrance();
+		c.entrances[i].cell = cells[i];
+	}
+
+	// Ƃɋ̒TāAق̓܂ł̍ŏRXgL^
+	const int count = static_cast<int>(c.entrances.size());
+	const int width = c.cellMax.x - c.cellMin.x + 1;
+	c.distances.assign(static_cast<size_t>(count) * count, FLT_MAX);
+	thread_local std::vector<float> costs;
+	for (int i = 0; i < count; ++i)
+	{
+		CalcDistances(c, c.entrances[i].cell, false, costs);
+		for (int j = 0; j < count; ++j)
+		{
+			const glm::ivec2& e = c.entrances[j].cell;
+			c.distances[i * count + j] = costs[(e.y - c.cellMin.y) * width + (e.x - c.cellMin.x)];
+		}
+	}
+
+	// Ɨׂ̋́AĚ̓Ƃ̂Ȃ蒼
+	LinkCluster(index);
+	const glm::ivec2 sides[4] = { pos - glm::ivec2(1, 0), pos + glm::ivec2(1, 0), pos - glm::ivec2(0, 1), pos + glm::ivec2(0, 1) };
+	for (const glm::ivec2& e : sides)
+	{
+		if (e.x >= 0 && e.y >= 0 && e.x < clusterCount.x && e.y < clusterCount.y)
+		{
+			LinkCluster(e.y * clusterCount.x + e.x);
+		}
+	}
+}
+
+/*
+̓ƁAĚŗׂ荇Ȃ
+
+@param index ̔ԍ
+*/
+void HierarchicalAstar::LinkCluster(int index)
+{
+	for (Entrance& e : clusters[index].entrances)
+	{
+		e.linkCount = 0;
+		for (int dir = 0; dir < 4; ++dir)
+		{
+			const glm::ivec2 next(e.cell.x + neighbors[dir].dx, e.cell.y + neighbors[dir].dz);
+			const int k = ClusterIndex(next);
+			if (k < 0 || k == index)
+			{
+				continue;
+			}
+			const uint8_t cost = grid->Cost(next.x, next.y);
+			const int j = FindEntrance(k, next);
+			if (cost == NavGrid::blockedCost || j < 0 || e.linkCount >= 2)
+			{
+				continue;
+			}
+			e.links[e.linkCount] = ToNodeId(k, j);
+			e.linkCells[e.linkCount] = next;
+			e.linkCosts[e.linkCount] = cost;
+			++e.linkCount;
+		}
+	}
+}
+
+/*
+̒ʂāAiqƋ̊eiq̊ԂړŏRXgvZ
+
+@param c          
+@param source     ̊iq
+@param isBackward falseȂ̊iqeiqցAtrueȂeiq̊iqւ̃RXg߂
+@param result     ̊iqƂ̍ŏRXg̊i[(ǂ蒅ȂiqFLT_MAX)
+
+ړ̃[ƃRXgAstarƓB̊iq͒ʂȂRXgłʂ̂ƂĈ
+*/
+void HierarchicalAstar::CalcDistances(const Cluster& c, const glm::ivec2& source,
+	bool isBackward, std::vector<float>& result) const
+{
+	const glm::ivec2 size = c.cellMax - c.cellMin + 1;
+	const int cellCount = size.x * size.y;
+	result.assign(cellCount, FLT_MAX);
+	const glm::ivec2 local = source - c.cellMin;
+	if (local.x < 0 || local.y < 0 || local.x >= size.x || local.y >= size.y)
+	{
+		return;
+	}
+
+	// ̊iq̃RXgʂĂ(̊iq͒ʂȂRXgłnƂĈ)
+	thread_local std::vector<uint8_t> cellCosts;
+	cellCosts.resize(cellCount);
+	for (int z = 0; z < size.y; ++z)
+	{
+		for (int x = 0; x < size.x; ++x)
+		{
+			cellCosts[z * size.x + x] = grid->Cost(c.cellMin.x + x, c.cellMin.y + z);
+		}
+	}
+	const int sourceIndex = local.y * size.x + local.x;
+	if (cellCosts[sourceIndex] == NavGrid::blockedCost)
+	{
+		cellCosts[sourceIndex] = NavGrid::flatCost;
+	}
+
+	// ͏̂ŁA_CNXg@őSĂ̊iq̃RXg߂
+	thread_local std::vector<std::pair<float, int>> heap;
+	heap.clear();
+	result[sourceIndex] = 0;
+	heap.emplace_back(0.0f, sourceIndex);
+	const auto greater = std::greater<std::pair<float, int>>();
+	while (!heap.empty())
+	{
+		std::pop_heap(heap.begin(), heap.end(), greater);
+		const std::pair<float, int> top = heap.back();
+		heap.pop_back();
+		if (top.first > result[top.second])
+		{
+			continue;
+		}
+
+		const int x = top.second % size.x;
+		const int z = top.second / size.x;
+		const uint8_t cellCost = cellCosts[top.second];
+		bool isPassable[4] = {};
+		for (int i = 0; i < 8; ++i)
+		{
+			const int nx = x + neighbors[i].dx;
+			const int nz = z + neighbors[i].dz;
+			if (nx < 0 || nz < 0 || nx >= size.x || nz >= size.y)
+			{
+				continue;
+			}
+			if (i >= 4 && !(isPassable[neighbors[i].a] && isPassable[neighbors[i].b]))
+			{
+				continue;
+			}
+			const int nextIndex = nz * size.x + nx;
+			const uint8_t nextCost = cellCosts[nextIndex];
+			if (nextCost == NavGrid::blockedCost)
+			{
+				continue;
+			}
+			if (i < 4)
+			{
+				isPassable[i] = true;
+			}
+
+			// ړRXg͈ړ̊iq̃RXgŌ܂Btɋ߂ꍇ́ÅiqړɂȂ
+			const float step = (i < 4 ? 1.0f : diagonalCost) * (isBackward ? cellCost : nextCost);
+			const float d = top.first + step;
+			if (d < result[nextIndex])
+			{
+				result[nextIndex] = d;
+				heap.emplace_back(d, nextIndex);
+				std::push_heap(heap.begin(), heap.end(), greater);
+			}
+		}
+	}
+}
+
+/*
+̓̔ԍ擾
+
+@return ̔ԍBiqłȂ-1
+*/
+int HierarchicalAstar::FindEntrance(int cluster, const glm::ivec2& cell) const
+{
+	const std::vector<Entrance>& entrances = clusters[cluster].entrances;
+	for (int i = 0; i < static_cast<int>(entrances.size()); ++i)
+	{
+		if (entrances[i].cell == cell)
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+T̃m[h̏擾
+
+@return m[h̏B̒Tŏ߂Ď擾ꍇ͏
+*/
+HierarchicalAstar::SearchNode& HierarchicalAstar::GetSearchNode(uint32_t id)
+{
+	SearchNode& node = id == startId ? startNode :
+		id == goalId ? goalNode : clusters[id >> 8].entrances[id & 0xff].search;
+	if (node.generation != generation)
+	{
+		node.generation = generation;
+		node.g = FLT_MAX;
+		node.isClosed = false;
+	}
+	return node;
+}
+
+/*
+oHAm[h̃RXgƐeXVăI[vXgɒǉ
+
+@param id     m[hԍ
+@param parent em[h̔ԍ
+@param g      eoRꍇ̃X^[g̃RXg
+@param cell   m[h̊iq
+@param goal   S[n_̊iq
+*/
+void HierarchicalAstar::Relax(uint32_t id, uint32_t parent, float g, const glm::ivec2& cell, const glm::ivec2& goal)
+{
+	SearchNode& m = GetSearchNode(id);
+	if (m.isClosed || g >= m.g)
+	{
+		return;
+	}
+	m.g = g;
+	m.parent = parent;
+	open.push_back({ g + Octile(cell, goal), g, id });
+	std::push_heap(open.begin(), open.end(), IsLater());
+}
@@ -0,0 +1,126 @@
+/*
+@file HierarchicalAstar.h
+*/
+#ifndef HIERARCHICALASTAR_H_INCLUDED
+#define HIERARCHICALASTAR_H_INCLUDED
+#include "Collision.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <stdint.h>
+
+class Astar;
+class NavGrid;
+
+/*
+iqɕāAPʂő܂ȌoHTNX(HPA*)
+
+NavGridclusterSizel̋ɕAׂ荇̋EŗƂʂiquvƂ
+Build()œ߁A悲Ƃɓǂ̍ŏRXgvZĂ
+FindAbstractPath()́Am[hƂOtA*ŒTAoH̗v(̊iq)Ԃ
+v̊Ԃ̊iq̌oH́ARefine()ł̋̒A*ŒTċ߂
+ړȂKvɂȂԂ߂΂悢̂ŁAoHłT͂ɏI
+
+ԂoH́A̋Eł؂Ȃ̂ŁAŒZoH菭Ȃ邱Ƃ
+
+Q𓮂Ƃ́ANavGrid`ƂRefresh()Ăяo
+`͈͂ɏdȂƁAςׂ̋悾vZ
+
+FindAbstractPath()ABuild()ARefresh()1̃XbhĂяo
+Refine()́ABuild()Refresh()̎słȂ΁ÃXbh瓯ɌĂяoĂ悢
+*/
+class HierarchicalAstar
+{
+public:
+	static const int clusterSize = 16; // ̑傫(iq̐)
+
+	HierarchicalAstar() = default;
+	~HierarchicalAstar() = default;
+	HierarchicalAstar(const HierarchicalAstar&) = delete;
+	HierarchicalAstar& operator=(const HierarchicalAstar&) = delete;
+
+	void Build(const NavGrid* grid);
+	void Refresh(const Collision::Shape& shape);
+	void Refresh(const glm::ivec2& cellMin, const glm::ivec2& cellMax);
+
+	bool FindAbstractPath(const glm::ivec2& start, const glm::ivec2& goal, std::vector<glm::ivec2>& waypoints);
+	bool Refine(const glm::ivec2& from, const glm::ivec2& to, Astar& astar, std::vector<glm::ivec2>& path) const;
+	bool FindPath(const glm::ivec2& start, const glm::ivec2& goal, Astar& astar, std::vector<glm::ivec2>& path);
+
+	glm::ivec2 ClusterOf(const glm::ivec2& cell) const;
+	size_t NodeCount() const;
+
+	// O̒TŃN[YXgɈڂm[h̐
+	size_t ExpandedCount() const { return expandedCount; }
+
+private:
+	// T̃m[h̏
+	struct SearchNode
+	{
+		float g = 0;             // X^[g̍ŏRXg
+		uint32_t parent = 0;     // em[h̔ԍ
+		uint32_t generation = 0; // ŌɎgT̔ԍ
+		bool isClosed = false;   // N[YXgɂtrue
+	};
+
+	// I[vXg̗vf
+	struct OpenEntry
+	{
+		float f;     // g + S[܂ł̐RXg
+		float g;     // X^[g̃RXg
+		uint32_t id; // m[hԍ
+	};
+
+	// ̓
+	// Tɑēǂރf[^1ɂ܂Ƃ߂Ă
+	struct Entrance
+	{
+		glm::ivec2 cell = glm::ivec2(0); // ̊iq
+		int linkCount = 0;               // Ěŗׂ荇̐(̊pȂő2)
+		uint32_t links[2] = {};          // Ěŗׂ荇̃m[hԍ
+		glm::ivec2 linkCells[2];         // links̊iq
+		float linkCosts[2] = {};         // linksֈړRXg
+		SearchNode search;               // T̏
+	};
+
+	// 
+	struct Cluster
+	{
+		glm::ivec2 cellMin = glm::ivec2(0);  // ̍ŏW
+		glm::ivec2 cellMax = glm::ivec2(0);  // ̍őW(̍W͈͂Ɋ܂)
+		std::vector<Entrance> entrances;    // 
+		std::vector<float> distances;       // ijւ̍ŏRXg(i * ̐ + j)
+	};
+
+	int ClusterIndex(const glm::ivec2& cell) const;
+	bool IsInGrid(const glm::ivec2& cell) const;
+	void FindBorderEntrances(const glm::ivec2& a, const glm::ivec2& b, std::vector<int>& offsets) const;
+	bool UpdateBorder(const glm::ivec2& a, const glm::ivec2& b);
+	void BuildCluster(int index);
+	void LinkCluster(int index);
+	void CalcDistances(const Cluster& c, const glm::ivec2& source, bool isBackward, std::vector<float>& result) const;
+	int FindEntrance(int cluster, const glm::ivec2& cell) const;
+	SearchNode& GetSearchNode(uint32_t id);
+	void Relax(uint32_t id, uint32_t parent, float g, const glm::ivec2& cell, const glm::ivec2& goal);
+
+	const NavGrid* grid = nullptr;
+	glm::ivec2 areaMin = glm::ivec2(0);       // iq͈̔͂̍ŏW
+	glm::ivec2 areaSize = glm::ivec2(0);      // iq͈̔͂̑傫
+	glm::ivec2 clusterCount = glm::ivec2(0);  // XZ̋̐
+	std::vector<Cluster> clusters;
+
+	// ̋E̓(E̐擪̋)
+	// verticalBorders͋(x, z)(x + 1, z)̋EAhorizontalBorders(x, z)(x, z + 1)̋E
+	std::vector<std::vector<int>> verticalBorders;
+	std::vector<std::vector<int>> horizontalBorders;
+
+	// T̍Ɨ̈
+	uint32_t generation = 0;          // ݂̒T̔ԍ
+	SearchNode startNode;             // X^[gn_̃m[h
+	SearchNode goalNode;              // S[n_̃m[h
+	std::vector<float> startCosts;    // X^[g̋̊iqƂ́AX^[g̍ŏRXg
+	std::vector<float> goalCosts;     // S[̋̊iqƂ́AS[܂ł̍ŏRXg
+	std::vector<OpenEntry> open;      // I[vXg̓񕪃q[v(m[hd邱Ƃ)
+	size_t expandedCount = 0;         // O̒TŃN[YXgɈڂm[h̐
+};
+
+#endif // !HIERARCHICALASTAR_H_INCLUDED
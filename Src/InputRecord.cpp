@@ -0,0 +1,264 @@
+/*
+@file InputRecord.cpp
+*/
+#include "InputRecord.h"
+#include <iostream>
+#include <string.h>
+
+namespace GLFWEW
+{
+	namespace /* unnamed */
+	{
+		/*
+		t@C`
+
+		wb_[: "IREC"(4oCg) + o[W(uint32_t)
+		t[: tO(uint8_t) + deltaTime(double) + buttons(uint16_t)
+		          + tOĂ鍀(J[\ʒuA}EX{^AL[)
+		*/
+		const char magic[4] = { 'I', 'R', 'E', 'C' };
+		const uint32_t version = 1;
+
+		// Õt[ωڂtO
+		const uint8_t flagCursor = 0x01;
+		const uint8_t flagMouse = 0x02;
+		const uint8_t flagKeys = 0x04;
+
+		template<typename T>
+		void WriteValue(std::ofstream& ofs, const T& value)
+		{
+			ofs.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		template<typename T>
+		bool ReadValue(std::ifstream& ifs, T& value)
+		{
+			return static_cast<bool>(ifs.read(reinterpret_cast<char*>(&value), sizeof(T)));
+		}
+	} // unnamed namespace
+
+	/*
+	L[Ă邩ׂ
+
+	@param key ׂL[ER[h(GLFW_KEY_AȂ)
+
+	@retval true  L[Ă
+	@retval false L[ĂȂA܂͋L^͈͊ÕL[
+	*/
+	bool FrameInput::IsKeyPressed(int key) const
+	{
+		if (key < firstKey || key > lastKey)
+		{
+			return false;
+		}
+		const int i = key - firstKey;
+		return (keys[i / 8] & (1 << (i % 8))) != 0;
+	}
+
+	/*
+	L[̏Ԃݒ肷
+
+	@param key     ݒ肷L[ER[h(GLFW_KEY_AȂ)
+	@param pressed Ătrue
+	*/
+	void FrameInput::SetKey(int key, bool pressed)
+	{
+		if (key < firstKey || key > lastKey)
+		{
+			return;
+		}
+		const int i = key - firstKey;
+		if (pressed)
+		{
+			keys[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+		}
+		else
+		{
+			keys[i / 8] &= static_cast<uint8_t>(~(1 << (i % 8)));
+		}
+	}
+
+	/*
+	}EX{^Ă邩ׂ
+
+	@param button ׂ{^(GLFW_MOUSE_BUTTON_LEFTȂ)
+
+	@retval true  {^Ă
+	@retval false {^ĂȂ
+	*/
+	bool FrameInput::IsMousePressed(int button) const
+	{
+		if (button < 0 || button >= 8)
+		{
+			return false;
+		}
+		return (mouseButtons & (1 << button)) != 0;
+	}
+
+	/*
+	L^p̃t@CJ
+
+	@param filename t@C
+
+	@retval true  
+	@retval false s
+	*/
+	bool InputRecorder::Open(const char* filename)
+	{
+		Close();
+		ofs.open(filename, std::ios_base::binary);
+		if (!ofs)
+		{
+			std::cerr << "[G[]" << __func__ << ": " << filename << "J܂\n";
+			return false;
+		}
+		ofs.write(magic, sizeof(magic));
+		WriteValue(ofs, version);
+		prev = FrameInput();
+		return true;
+	}
+
+	/*
+	L^p̃t@C
+	*/
+	void InputRecorder::Close()
+	{
+		if (ofs.is_open())
+		{
+			ofs.close();
+		}
+	}
+
+	/*
+	1t[̓͂o
+
+	@param input o
+
+	@retval true  
+	@retval false s
+	*/
+	bool InputRecorder::Write(const FrameInput& input)
+	{
+		if (!ofs)
+		{
+			return false;
+		}
+
+		uint8_t flags = 0;
+		if (input.cursorX != prev.cursorX || input.cursorY != prev.cursorY)
+		{
+			flags |= flagCursor;
+		}
+		if (input.mouseButtons != prev.mouseButtons)
+		{
+			flags |= flagMouse;
+		}
+		if (memcmp(input.keys, prev.keys, sizeof(input.keys)) != 0)
+		{
+			flags |= flagKeys;
+		}
+
+		WriteValue(ofs, flags);
+		WriteValue(ofs, input.deltaTime);
+		WriteValue(ofs, input.buttons);
+		if (flags & flagCursor)
+		{
+			WriteValue(ofs, input.cursorX);
+			WriteValue(ofs, input.cursorY);
+		}
+		if (flags & flagMouse)
+		{
+			WriteValue(ofs, input.mouseButtons);
+		}
+		if (flags & flagKeys)
+		{
+			ofs.write(reinterpret_cast<const char*>(input.keys), sizeof(input.keys));
+		}
+		prev = input;
+		return static_cast<bool>(ofs);
+	}
+
+	/*
+	Đp̃t@CJ
+
+	@param filename t@C
+
+	@retval true  
+	@retval false s
+	*/
+	bool InputPlayer::Open(const char* filename)
+	{
+		Close();
+		ifs.open(filename, std::ios_base::binary);
+		if (!ifs)
+		{
+			std::cerr << "[G[]" << __func__ << ": " << filename << "J܂\n";
+			return false;
+		}
+		char header[sizeof(magic)];
+		uint32_t fileVersion = 0;
+		if (!ifs.read(header, sizeof(header)) || memcmp(header, magic, sizeof(magic)) != 0 ||
+			!ReadValue(ifs, fileVersion) || fileVersion != version)
+		{
+			std::cerr << "[G[]" << __func__ << ": " << filename << "͓͋L^t@Cł͂܂\n";
+			Close();
+			return false;
+		}
+		prev = FrameInput();
+		return true;
+	}
+
+	/*
+	Đp̃t@C
+	*/
+	void InputPlayer::Close()
+	{
+		if (ifs.is_open())
+		{
+			ifs.close();
+		}
+	}
+
+	/*
+	1t[̓͂ǂݍ
+
+	@param input ǂݍ񂾓͂̊i[
+
+	@retval true  
+	@retval false t@C̏I[ɒBA܂͓ǂݍ݂Ɏs
+	*/
+	bool InputPlayer::Read(FrameInput& input)
+	{
+		uint8_t flags = 0;
+		FrameInput tmp = prev;
+		if (!ReadValue(ifs, flags) || !ReadValue(ifs, tmp.deltaTime) || !ReadValue(ifs, tmp.buttons))
+		{
+			return false;
+		}
+		if (flags & flagCursor)
+		{
+			if (!ReadValue(ifs, tmp.cursorX) || !ReadValue(ifs, tmp.cursorY))
+			{
+				return false;
+			}
+		}
+		if (flags & flagMouse)
+		{
+			if (!ReadValue(ifs, tmp.mouseButtons))
+			{
+				return false;
+			}
+		}
+		if (flags & flagKeys)
+		{
+			if (!ifs.read(reinterpret_cast<char*>(tmp.keys), sizeof(tmp.keys)))
+			{
+				return false;
+			}
+		}
+		prev = tmp;
+		input = tmp;
+		return true;
+	}
+
+} // namespace GLFWEW
@@ -0,0 +1,80 @@
+/*
+@file InputRecord.h
+*/
+#ifndef INPUTRECORD_H_INCLUDED
+#define INPUTRECORD_H_INCLUDED
+#include <fstream>
+#include <stdint.h>
+
+namespace GLFWEW
+{
+	/*
+	1t[̓͏
+
+	L[GLFW_KEY_SPACE(32)`GLFW_KEY_LAST(348)͈̔͂rbgŕێ
+	*/
+	struct FrameInput
+	{
+		static const int firstKey = 32;  // L^ŏ̃L[ER[h
+		static const int lastKey = 348;  // L^Ō̃L[ER[h
+		static const int keyBytes = (lastKey - firstKey + 1 + 7) / 8;
+
+		bool IsKeyPressed(int key) const;
+		void SetKey(int key, bool pressed);
+		bool IsMousePressed(int button) const;
+
+		double deltaTime = 0;     // Õt[̌oߎ(b)
+		uint16_t buttons = 0;     // GamePad::buttonsɐݒ肷l
+		uint8_t mouseButtons = 0; // }EX{^̏(1rbgڂ{^)
+		double cursorX = 0;       // }EXJ[\XW
+		double cursorY = 0;       // }EXJ[\YW
+		uint8_t keys[keyBytes] = {}; // L[̏
+	};
+
+	/*
+	t[Ƃ̓͂t@CɏoNX
+
+	Õt[ωȂL[A}EX{^AJ[\ʒu͏oȂ
+	*/
+	class InputRecorder
+	{
+	public:
+		InputRecorder() = default;
+		~InputRecorder() = default;
+		InputRecorder(const InputRecorder&) = delete;
+		InputRecorder& operator=(const InputRecorder&) = delete;
+
+		bool Open(const char* filename);
+		void Close();
+		bool IsOpen() const { return ofs.is_open(); }
+		bool Write(const FrameInput&);
+
+	private:
+		std::ofstream ofs;
+		FrameInput prev; // Oɏo
+	};
+
+	/*
+	InputRecorderot@C͂ǂݍރNX
+	*/
+	class InputPlayer
+	{
+	public:
+		InputPlayer() = default;
+		~InputPlayer() = default;
+		InputPlayer(const InputPlayer&) = delete;
+		InputPlayer& operator=(const InputPlayer&) = delete;
+
+		bool Open(const char* filename);
+		void Close();
+		bool IsOpen() const { return ifs.is_open(); }
+		bool Read(FrameInput&);
+
+	private:
+		std::ifstream ifs;
+		FrameInput prev; // Oɓǂݍ񂾓
+	};
+
+} // namespace GLFWEW
+
+#endif // !INPUTRECORD_H_INCLUDED
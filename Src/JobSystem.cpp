@@ -0,0 +1,253 @@
+/*
+@file JobSystem.cpp
+*/
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <string>
+
+namespace /* unnamed */ {
+
+// ݂̃XbhgWuL[̔ԍ([J[ȊÕXbh0)
+thread_local size_t currentQueue = 0;
+
+} // unnamed namespace
+
+/*
+WuVXẽVOgCX^X擾
+
+@return WuVXẽCX^X
+*/
+JobSystem& JobSystem::Instance()
+{
+	static JobSystem instance;
+	return instance;
+}
+
+/*
+fXgN^
+*/
+JobSystem::~JobSystem()
+{
+	Finalize();
+}
+
+/*
+WuVXe
+
+@param workerCount [J[Xbh̐
+                   0̏ꍇ(_RA - 1)쐬
+
+@retval true  
+@retval false s
+*/
+bool JobSystem::Initialize(size_t workerCount)
+{
+	if (isRunning)
+	{
+		return true;
+	}
+	if (workerCount == 0)
+	{
+		const unsigned int n = std::thread::hardware_concurrency();
+		workerCount = n > 1 ? n - 1 : 0;
+	}
+
+	queues.clear();
+	for (size_t i = 0; i < workerCount + 1; ++i)
+	{
+		queues.emplace_back(new WorkQueue);
+	}
+	isRunning = true;
+	workers.reserve(workerCount);
+	for (size_t i = 0; i < workerCount; ++i)
+	{
+		workers.emplace_back(&JobSystem::WorkerMain, this, i + 1);
+	}
+	return true;
+}
+
+/*
+WuVXeI
+
+[J[Xbh̏I҂Ă߂
+*/
+void JobSystem::Finalize()
+{
+	if (!isRunning)
+	{
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		isRunning = false;
+	}
+	sleepCondition.notify_all();
+	for (std::thread& e : workers)
+	{
+		e.join();
+	}
+	workers.clear();
+	queues.clear();
+}
+
+/*
+Wu𖖔ɒǉ
+
+@param job ǉWu
+
+@retval true  ǉ
+@retval false L[t
+*/
+bool JobSystem::WorkQueue::PushBack(const Job& job)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (size >= capacity)
+	{
+		return false;
+	}
+	jobs[(head + size) % capacity] = job;
+	++size;
+	return true;
+}
+
+/*
+̃Wuo(̃Xbhp)
+
+@param job oWůi[
+
+@retval true  o
+@retval false L[
+*/
+bool JobSystem::WorkQueue::PopBack(Job& job)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (size == 0)
+	{
+		return false;
+	}
+	--size;
+	job = jobs[(head + size) % capacity];
+	return true;
+}
+
+/*
+擪̃Wuo(̃Xbhޗp)
+
+@param job oWůi[
+
+@retval true  o
+@retval false L[
+*/
+bool JobSystem::WorkQueue::PopFront(Job& job)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (size == 0)
+	{
+		return false;
+	}
+	job = jobs[head];
+	head = (head + 1) % capacity;
+	--size;
+	return true;
+}
+
+/*
+͈͂𕪊ăWuo^AׂďI܂ő҂
+
+@param count     vf
+@param grainSize 1̃Wuŏvf
+@param func      WuƂĎs֐
+@param data      funcɓnf[^
+*/
+void JobSystem::Run(size_t count, size_t grainSize, JobFunction func, const void* data)
+{
+	const size_t jobCount = (count + grainSize - 1) / grainSize;
+	std::atomic<size_t> counter(jobCount);
+
+	// 擪̃WuقǓ܂₷̂ŁA͖珈Ă
+	WorkQueue& queue = *queues[currentQueue];
+	for (size_t begin = 0; begin < count; begin += grainSize)
+	{
+		Job job;
+		job.function = func;
+		job.data = data;
+		job.begin = begin;
+		job.end = begin + grainSize < count ? begin + grainSize : count;
+		job.counter = &counter;
+		++pendingJobs;
+		if (!queue.PushBack(job))
+		{
+			// L[tȂ玩Ŏs
+			--pendingJobs;
+			func(data, job.begin, job.end);
+			--counter;
+		}
+	}
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+	sleepCondition.notify_all();
+
+	// ҂ĂԂŃWus
+	while (counter.load(std::memory_order_acquire) > 0)
+	{
+		if (!TryExecute(currentQueue))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+/*
+Wu1oĎs
+
+@param queueIndex ̃WuL[̔ԍ
+
+@retval true  Wus
+@retval false słWuȂ
+
+̃L[Ȃ瑼̃Xbh̃L[瓐
+*/
+bool JobSystem::TryExecute(size_t queueIndex)
+{
+	Job job;
+	bool found = queues[queueIndex]->PopBack(job);
+	for (size_t i = 1; !found && i < queues.size(); ++i)
+	{
+		found = queues[(queueIndex + i) % queues.size()]->PopFront(job);
+	}
+	if (!found)
+	{
+		return false;
+	}
+	--pendingJobs;
+	{
+		PROFILE_SCOPE("Job");
+		job.function(job.data, job.begin, job.end);
+	}
+	job.counter->fetch_sub(1, std::memory_order_release);
+	return true;
+}
+
+/*
+[J[Xbh̏
+
+@param queueIndex ̃Xbh̃WuL[̔ԍ
+*/
+void JobSystem::WorkerMain(size_t queueIndex)
+{
+	currentQueue = queueIndex;
+	if (Profiler::IsEnabled())
+	{
+		Profiler::Instance().SetThreadName(("Worker " + std::to_string(queueIndex)).c_str());
+	}
+	while (isRunning)
+	{
+		if (TryExecute(queueIndex))
+		{
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		sleepCondition.wait(lock, [this]() { return pendingJobs > 0 || !isRunning; });
+	}
+}
@@ -0,0 +1,118 @@
+/*
+@file JobSystem.h
+*/
+#ifndef JOBSYSTEM_H_INCLUDED
+#define JOBSYSTEM_H_INCLUDED
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <stddef.h>
+
+/*
+[NXeB[ÕWuVXe
+
+Œ萔̃[J[Xbhꂼꎩ̃WuL[A
+̃L[ɂȂ瑼̃Xbh̃L[̐擪Wu𓐂
+
+ƏI:
+-# AvP[V̏JobSystem::Initialize()Ăяo
+-# AvP[V̏IJobSystem::Finalize()Ăяo
+ĂȂꍇAParallelFor()͌ĂяoXbhłׂĎs
+*/
+class JobSystem
+{
+public:
+	static JobSystem& Instance();
+
+	bool Initialize(size_t workerCount = 0);
+	void Finalize();
+	size_t WorkerCount() const { return workers.size(); }
+
+	/*
+	[0, count)͈̔͂grainSizeɕĕɎs
+
+	@param count     vf
+	@param grainSize 1̃Wuŏvf
+	@param func      func(begin, end)̌`ŌĂяo֐
+
+	ׂẴWuI܂Ŗ߂ȂB҂ĂԂ͌ĂяoXbhWus
+	*/
+	template<typename F>
+	void ParallelFor(size_t count, size_t grainSize, const F& func)
+	{
+		if (grainSize == 0)
+		{
+			grainSize = 1;
+		}
+		if (workers.empty() || count <= grainSize)
+		{
+			if (count > 0)
+			{
+				func(static_cast<size_t>(0), count);
+			}
+			return;
+		}
+		Run(count, grainSize, &Invoke<F>, &func);
+	}
+
+private:
+	JobSystem() = default;
+	~JobSystem();
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	using JobFunction = void(*)(const void* data, size_t begin, size_t end);
+
+	// Wu
+	struct Job
+	{
+		JobFunction function = nullptr;         // s֐
+		const void* data = nullptr;             // functionɓnf[^
+		size_t begin = 0;                       // ͈͂̐擪
+		size_t end = 0;                         // ͈͂̏I[
+		std::atomic<size_t>* counter = nullptr; // Wu
+	};
+
+	/*
+	XbhƂ̃WuL[
+
+	̃Xbh͖oÃXbh͐擪瓐
+	*/
+	class WorkQueue
+	{
+	public:
+		WorkQueue() : jobs(capacity) {}
+		bool PushBack(const Job&);
+		bool PopBack(Job&);
+		bool PopFront(Job&);
+
+	private:
+		static const size_t capacity = 1024;
+		std::mutex mutex;
+		std::vector<Job> jobs; // Oobt@
+		size_t head = 0;       // 擪̈ʒu
+		size_t size = 0;       // i[ĂWu
+	};
+
+	template<typename F>
+	static void Invoke(const void* data, size_t begin, size_t end)
+	{
+		(*static_cast<const F*>(data))(begin, end);
+	}
+
+	void Run(size_t count, size_t grainSize, JobFunction func, const void* data);
+	bool TryExecute(size_t queueIndex);
+	void WorkerMain(size_t queueIndex);
+
+	std::vector<std::thread> workers;                 // [J[Xbh
+	std::vector<std::unique_ptr<WorkQueue>> queues;   // 0Ԃ̓[J[ȊÕXbhp
+	std::atomic<size_t> pendingJobs{ 0 };             // L[ɓĂWu
+	std::atomic<bool> isRunning{ false };             // falseɂȂ烏[J[I
+	std::mutex sleepMutex;
+	std::condition_variable sleepCondition;
+};
+
+#endif // !JOBSYSTEM_H_INCLUDED
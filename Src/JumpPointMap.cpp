@@ -0,0 +1,176 @@
+/*
+@file JumpPointMap.cpp
+*/
+#include "JumpPointMap.h"
+#include "NavGrid.h"
+#include "Profiler.h"
+
+namespace /* unnamed */ {
+
+/*
+ړdistances̓Yւ̕ϊ\B
+
+(dz + 1) * 3 + (dx + 1)ňBԂAstarׂ̗̊iqւ̈ړƓ
+*/
+const int directionIndices[9] = { 4, 2, 5, 0, -1, 1, 6, 3, 7 };
+
+} // unnamed namespace
+
+/*
+WvvZ
+
+@param grid iqƂ̈ړRXg(͈͂̑傫32767܂)
+
+grid́A̕\gI܂Ő邱
+*/
+void JumpPointMap::Build(const NavGrid& grid)
+{
+	PROFILE_SCOPE("JumpPointMap::Build");
+	this->grid = &grid;
+	revision = grid.Revision();
+	areaMin = grid.AreaMin();
+	areaSize = grid.AreaMax() - areaMin + 1;
+	distances.assign(static_cast<size_t>(areaSize.x) * areaSize.y * 8, 0);
+
+	// ΂߂̃Wv͏c̃WvĝŁAcɌvZ
+	BuildStraight(glm::ivec2(-1, 0));
+	BuildStraight(glm::ivec2(1, 0));
+	BuildStraight(glm::ivec2(0, -1));
+	BuildStraight(glm::ivec2(0, 1));
+	BuildDiagonal(glm::ivec2(-1, -1));
+	BuildDiagonal(glm::ivec2(1, -1));
+	BuildDiagonal(glm::ivec2(-1, 1));
+	BuildDiagonal(glm::ivec2(1, 1));
+}
+
+/*
+\iq݂̌̏ԂƈvĂ邩ׂ
+
+@param grid iqƂ̈ړRXg
+
+@retval true  grid쐬ƁAgrid͕`ĂȂ
+@retval false ʂ̊iq쐬A܂͍쐬grid`ꂽ
+*/
+bool JumpPointMap::IsValid(const NavGrid& grid) const
+{
+	return this->grid == &grid && revision == grid.Revision();
+}
+
+/*
+Wv擾
+
+@param cell      iq(iq͈͓̔ł邱)
+@param direction ړ(evf-1A0A1̂ꂩŁA0ł͂Ȃ)
+
+@return WvBȂWv|Cg܂ł̋A0ȉȂǂ܂ł̋̕𔽓]l
+*/
+int JumpPointMap::Distance(const glm::ivec2& cell, const glm::ivec2& direction) const
+{
+	const glm::ivec2 local = cell - areaMin;
+	return distances[(static_cast<size_t>(local.y) * areaSize.x + local.x) * 8 + DirectionIndex(direction)];
+}
+
+/*
+ړdistances̓Yɕϊ
+*/
+int JumpPointMap::DirectionIndex(const glm::ivec2& direction) const
+{
+	return directionIndices[(direction.y + 1) * 3 + (direction.x + 1)];
+}
+
+/*
+iq̃Wv擾
+
+@param x         iq͈̔͂̐擪XW
+@param z         iq͈̔͂̐擪ZW
+@param direction distances̓Y
+*/
+int16_t& JumpPointMap::At(int x, int z, int direction)
+{
+	return distances[(static_cast<size_t>(z) * areaSize.x + x) * 8 + direction];
+}
+
+/*
+iqʂ邩ׂ(iq͈̔͂̐擪̍WŎw肷B͈͊O͒ʂȂ)
+*/
+bool JumpPointMap::IsWalkable(int x, int z) const
+{
+	return grid->IsWalkable(areaMin.x + x, areaMin.y + z);
+}
+
+/*
+c̈ړ̃WvvZ
+
+@param direction ړ
+
+iސ̊iq珇ɌvZÅׂiq̃Wv1𑫂Ă
+c̈ړł́ÅiqʂāA1Ỏ̊iqʂȂ΃Wv|CgɂȂ
+*/
+void JumpPointMap::BuildStraight(const glm::ivec2& direction)
+{
+	const int index = DirectionIndex(direction);
+	const glm::ivec2 side(direction.y, direction.x); // ړ̉
+	const glm::ivec2 first(direction.x > 0 ? areaSize.x - 1 : 0, direction.y > 0 ? areaSize.y - 1 : 0);
+	const glm::ivec2 step(direction.x > 0 ? -1 : 1, direction.y > 0 ? -1 : 1);
+	for (int z = first.y; z >= 0 && z < areaSize.y; z += step.y)
+	{
+		for (int x = first.x; x >= 0 && x < areaSize.x; x += step.x)
+		{
+			const glm::ivec2 next(x + direction.x, z + direction.y);
+			int16_t& distance = At(x, z, index);
+			if (!IsWalkable(next.x, next.y))
+			{
+				distance = 0;
+			}
+			else if ((IsWalkable(next.x + side.x, next.y + side.y) && !IsWalkable(x + side.x, z + side.y)) ||
+				(IsWalkable(next.x - side.x, next.y - side.y) && !IsWalkable(x - side.x, z - side.y)))
+			{
+				distance = 1;
+			}
+			else
+			{
+				const int16_t d = At(next.x, next.y, index);
+				distance = static_cast<int16_t>(d > 0 ? d + 1 : d - 1);
+			}
+		}
+	}
+}
+
+/*
+΂߂̈ړ̃WvvZ
+
+@param direction ړ
+
+iސ̊iq珇ɌvZÅׂiq̃Wv1𑫂Ă
+΂߂̈ړł́Acǂ炩̕ɃWv|Cg΃Wv|CgɂȂ
+cׂ̗ʂȂꍇ͎΂߂ɈړłȂ(ǂ̊p蔲Ȃ)
+*/
+void JumpPointMap::BuildDiagonal(const glm::ivec2& direction)
+{
+	const int index = DirectionIndex(direction);
+	const int indexX = DirectionIndex(glm::ivec2(direction.x, 0));
+	const int indexZ = DirectionIndex(glm::ivec2(0, direction.y));
+	const glm::ivec2 first(direction.x > 0 ? areaSize.x - 1 : 0, direction.y > 0 ? areaSize.y - 1 : 0);
+	const glm::ivec2 step(direction.x > 0 ? -1 : 1, direction.y > 0 ? -1 : 1);
+	for (int z = first.y; z >= 0 && z < areaSize.y; z += step.y)
+	{
+		for (int x = first.x; x >= 0 && x < areaSize.x; x += step.x)
+		{
+			const glm::ivec2 next(x + direction.x, z + direction.y);
+			int16_t& distance = At(x, z, index);
+			if (!IsWalkable(next.x, next.y) || !IsWalkable(next.x, z) || !IsWalkable(x, next.y))
+			{
+				distance = 0;
+			}
+			else if (At(next.x, next.y, indexX) > 0 || At(next.x, next.y, indexZ) > 0)
+			{
+				distance = 1;
+			}
+			else
+			{
+				const int16_t d = At(next.x, next.y, index);
+				distance = static_cast<int16_t>(d > 0 ? d + 1 : d - 1);
+			}
+		}
+	}
+}
@@ -0,0 +1,48 @@
+/*
+@file JumpPointMap.h
+*/
+#ifndef JUMPPOINTMAP_H_INCLUDED
+#define JUMPPOINTMAP_H_INCLUDED
+#include <glm/glm.hpp>
+#include <vector>
+#include <stdint.h>
+
+class NavGrid;
+
+/*
+Jump Point SearchpɁAiqƂ8̃WvOvZNX(JPS+)
+
+WvȂA̕ɂ̐i񂾊iqWv|Cg
+0ȉȂA̕ɂ̓Wv|CgȂA𔽓]iނƕǂɓ
+Wv|Cg̒`AstarJPSƓ(΂߂̈ړŕǂ̊p蔲Ȃ)
+
+Q𓮂NavGrid̔ԍςAIsValid()falseɂȂ
+Ȃn`pȂ̂ŁA蒼ꍇ͂xBuild()Ăяo
+*/
+class JumpPointMap
+{
+public:
+	JumpPointMap() = default;
+	~JumpPointMap() = default;
+	JumpPointMap(const JumpPointMap&) = delete;
+	JumpPointMap& operator=(const JumpPointMap&) = delete;
+
+	void Build(const NavGrid& grid);
+	bool IsValid(const NavGrid& grid) const;
+	int Distance(const glm::ivec2& cell, const glm::ivec2& direction) const;
+
+private:
+	int DirectionIndex(const glm::ivec2& direction) const;
+	int16_t& At(int x, int z, int direction);
+	bool IsWalkable(int x, int z) const;
+	void BuildStraight(const glm::ivec2& direction);
+	void BuildDiagonal(const glm::ivec2& direction);
+
+	const NavGrid* grid = nullptr;
+	uint32_t revision = 0;                // 쐬Ƃ̊iq̔ԍ
+	glm::ivec2 areaMin = glm::ivec2(0);   // iq͈̔͂̍ŏW
+	glm::ivec2 areaSize = glm::ivec2(0);  // iq͈̔͂̑傫
+	std::vector<int16_t> distances;       // iqƂ8̃Wv
+};
+
+#endif // !JUMPPOINTMAP_H_INCLUDED
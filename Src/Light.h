@@ -66,7 +66,9 @@ class DirectionalLightActor : public Actor
 public:
 	DirectionalLightActor(const std::string& name, const glm::vec3& c,
 		const glm::vec3& d) : Actor(name, 1, glm::vec3(0)), color(c), direction(d)
-	{}
+	{
+		SetCollisionLayer(Collision::Layer::light, 0);
+	}
 	~DirectionalLightActor() = default;
 
 public:
@@ -83,7 +85,9 @@ class PointLightActor : public Actor
 public:
 	PointLightActor(const std::string name, const glm::vec3 c,
 		const glm::vec3& p) : Actor(name, 1, p), color(c)
-	{}
+	{
+		SetCollisionLayer(Collision::Layer::light, 0);
+	}
 	~PointLightActor() = default;
 
 public:
@@ -104,6 +108,7 @@ public:
 		cutOff(std::cos(cutOff)), innerCutOff(std::cos(innerCutOff))
 	{
 		position = p;
+		SetCollisionLayer(Collision::Layer::light, 0);
 	}
 	~SpotLightActor() = default;
 
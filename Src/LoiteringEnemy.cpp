@@ -115,176 +115,3 @@ void LoiteringEnemy::OnHit(const ActorPtr& b, const glm::vec3& p)
 {
 	EnemyActor::OnHit(b, p);
 }
-
-/*
-i[\ȃAN^[mۂ
-
-@param reserveCount AN^[z̊mې
-*/
-void LoiteringEnemyList::Reserve(size_t reserveCount)
-{
-	loiteringEnemies.reserve(reserveCount);
-}
-
-/*
-AN^[ǉ
-
-@param actor ǉAN^[
-*/
-void LoiteringEnemyList::Add(const LoiteringEnemyPtr& actor)
-{
-	loiteringEnemies.push_back(actor);
-}
-
-/*
-AN^[폜
-
-@param actor 폜AN^[
-*/
-bool LoiteringEnemyList::Remove(const LoiteringEnemyPtr& actor)
-{
-	//|C^vAN^T
-	//
-	for (auto itr = loiteringEnemies.begin(); itr != loiteringEnemies.end(); ++itr)
-	{
-		if (*itr == actor)
-		{
-			loiteringEnemies.erase(itr);
-			return true;
-		}
-	}
-	return false;
-}
-
-/*
-w肳ꂽWɑΉiq̃CfbNX擾
-
-@param pos CfbNX̌ɂȂʒu
-
-@retun posɑΉiq̃CfbNX
-*/
-glm::ivec2 LoiteringEnemyList::CalcMapIndex(const glm::vec3& pos) const
-{
-	const int x = std::max(0,
-		std::min(sepalationSizeX - 1, static_cast<int>(pos.x / mapGridSizeX)));
-	const int y = std::max(0,
-		std::min(sepalationSizeY - 1, static_cast<int>(pos.z / mapGridSizeY)));
-	return glm::ivec2(x, y);
-}
-
-/*
-AN^[̏ԂXV
-
-@param deltaTime O̍XV̌oߎ
-*/
-void LoiteringEnemyList::Update(float deltaTime)
-{
-	//͈for
-	for (const LoiteringEnemyPtr& e : loiteringEnemies)
-	{
-		if (e && e->health > 0)
-		{
-			e->Update(deltaTime);
-		}
-	}
-
-	for (auto i = loiteringEnemies.begin(); i != loiteringEnemies.end();)
-	{
-		const LoiteringEnemyPtr& e = *i;
-		if (!e || e->health <= 0)
-		{
-			// erase => vectorvf폜邽߂Ɏg
-			// sA̗vfwlԂĂ
-			i = loiteringEnemies.erase(i);
-		}
-		else
-		{
-			++i;
-		}
-	}
-
-	// iqԂɃAN^[蓖Ă
-	for (int y = 0; y < sepalationSizeY; ++y)
-	{
-		for (int x = 0; x < sepalationSizeX; ++x)
-		{
-			grid[y][x].clear();
-		}
-	}
-	for (auto i = loiteringEnemies.begin(); i != loiteringEnemies.end(); ++i)
-	{
-		const glm::ivec2 mapIndex = CalcMapIndex((*i)->position);
-		grid[mapIndex.y][mapIndex.x].push_back(*i);
-	}
-}
-
-
-
-/*
-AN^[`f[^XV
-*/
-void LoiteringEnemyList::UpdateDrawData(float deltaTime)
-{
-	for (const LoiteringEnemyPtr& e : loiteringEnemies)
-	{
-		if (e && e->health > 0) {
-			e->UpdateDrawData(deltaTime);
-		}
-	}
-}
-
-/*
-AN^[`悷
-*/
-void LoiteringEnemyList::Draw()
-{
-	for (const LoiteringEnemyPtr& e : loiteringEnemies)
-	{
-		if (e && e->health > 0) {
-			e->Draw();
-		}
-	}
-}
-
-/*
-w肳ꂽW̋ߖTɂAN^[̃Xg擾
-
-@param pos         ̊_ƂȂW
-@param maxDistance ߖTƂ݂Ȃő勗()
-
-@return Actor::positionpos甼amaxDistanceȓɂAN^[̔z
-*/
-std::vector<LoiteringEnemyPtr> LoiteringEnemyList::FindNearbyActors(
-	const glm::vec3& pos, float maxDistance) const
-{
-	std::vector<std::pair<float, LoiteringEnemyPtr>> buffer;
-	buffer.reserve(1000);
-
-	const glm::ivec2 mapIndex = CalcMapIndex(pos);
-	const glm::ivec2 min = glm::max(mapIndex - 1, 0);
-	const glm::ivec2 max = glm::min(
-		mapIndex + 1, glm::ivec2(sepalationSizeX - 1, sepalationSizeY - 1));
-	for (int y = min.y; y <= max.y; ++y)
-	{
-		for (int x = min.x; x <= max.x; ++x)
-		{
-			const std::vector<LoiteringEnemyPtr>& list = grid[y][x];
-			for (auto actor : list)
-			{
-				const float distance = glm::distance(glm::vec3(actor->position), pos);
-				buffer.push_back(std::make_pair(distance, actor));
-			}
-		}
-	}
-
-	std::vector<LoiteringEnemyPtr> result;
-	result.reserve(100);
-	for (const auto& e : buffer)
-	{
-		if (e.first <= maxDistance)
-		{
-			result.push_back(e.second);
-		}
-	}
-	return result;
-}
\ No newline at end of file
@@ -6,10 +6,18 @@
 #include "StatusScene.h"
 #include "GameOverScene.h"
 #include "SkeletalMeshActor.h"
+#include "Profiler.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/constants.hpp>
 #include <random>
 
+namespace /* unnamed */ {
+
+const size_t pathSearchBudget = 4000; // 1t[ŌoHTɎgĂ悢m[h
+const int pathSearchTimeLimit = 500;  // m[hɒBOłoHTł؂鎞(}CNb)
+
+} // unnamed namespace
+
 /*
 Փ˂
 
@@ -55,33 +63,23 @@ void PlayerCollisionHandler(const ActorPtr& a, const ActorPtr& b, const glm::vec
 	}
 }
 
+/*
+J̑OՂĂ邩ׂ
+
+@param front J̌\]s
+@param z     -2ȂJ2납AȊOȂJ̈ʒu璲ׂ
+
+@retval true  4ȓɏQn`
+@retval false Ȃ
+*/
 bool MainGameScene::CameraRayChack(glm::mat4 front, int z)
 {
-	for (int i = 0; i < 5; i++)
-	{
-		glm::vec3 a;
-		if (z == -2)
-		{
-			glm::vec3 ray = front * glm::vec4(0, 0, i + z, 1);
-			a = camera.position + ray;
-		}
-		else
-		{
-			glm::vec3 ray = front * glm::vec4(0, 0, i, 1);
-			a = camera.position + ray;
-		}
-		a.y = heightMap.Height(a);
-		float length = glm::length(player->position - a);
-		for (auto& object : objects)
-		{
-			glm::vec3 distance = enemy->ObjectChack(object, a);
-			if (glm::length(distance) < FLT_EPSILON)
-			{
-				return true;
-			}
-		}
-	}
-	return false;
+	const glm::vec3 dir = glm::normalize(glm::vec3(front * glm::vec4(0, 0, 1, 0)));
+	const float start = z == -2 ? -2.0f : 0.0f;
+	World::RaycastHit hit;
+	const Collision::LayerMask blockers = Collision::ToMask(Collision::Layer::obstacle) |
+		Collision::ToMask(Collision::Layer::terrain);
+	return world.Raycast(camera.position + dir * start, dir, 4.0f, &hit, nullptr, blockers);
 }
 
 StaticMeshActorPtr MainGameScene::CreateTreeWall(glm::vec3 pos, int axsis, int size)
@@ -91,8 +89,8 @@ StaticMeshActorPtr MainGameScene::CreateTreeWall(glm::vec3 pos, int axsis, int s
 		const Mesh::FilePtr meshTree = meshBuffer.GetFile("Res/red_pine_tree.gltf");
 		glm::vec3 position = glm::vec3(pos.x + size, pos.y, pos.z);
 		position.y = heightMap.Height(position);
-		StaticMeshActorPtr p = std::make_shared<StaticMeshActor>(
-			meshTree, "Tree", 100, position, glm::vec3(0));
+		StaticMeshActorPtr p = wallPool.GetPtr(wallPool.Create(
+			meshTree, "Tree", 100, position, glm::vec3(0)));
 		p->colLocal = Collision::CreateOBB(glm::vec3(0, 0, 0),
 			glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(0, 0, -1), glm::vec3(1));
 		p->scale = glm::vec3(1.5f);
@@ -103,8 +101,8 @@ StaticMeshActorPtr MainGameScene::CreateTreeWall(glm::vec3 pos, int axsis, int s
 		const Mesh::FilePtr meshTree = meshBuffer.GetFile("Res/red_pine_tree.gltf");
 		glm::vec3 position = glm::vec3(pos.x, pos.y, pos.z + size);
 		position.y = heightMap.Height(position);
-		StaticMeshActorPtr p = std::make_shared<StaticMeshActor>(
-			meshTree, "Tree", 100, position, glm::vec3(0));
+		StaticMeshActorPtr p = wallPool.GetPtr(wallPool.Create(
+			meshTree, "Tree", 100, position, glm::vec3(0)));
 		p->colLocal = Collision::CreateOBB(glm::vec3(0, 0, 0),
 			glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(0, 0, -1), glm::vec3(1));
 		p->scale = glm::vec3(1.5f);
@@ -122,8 +120,8 @@ StaticMeshActorPtr MainGameScene::CreateStoneWall(glm::vec3 pos, float rot, int
 		const Mesh::FilePtr meshStoneWall = meshBuffer.GetFile("Res/wall_stone.gltf");
 		glm::vec3 position = glm::vec3(pos.x + size, 0, pos.z);
 		position.y = heightMap.Height(position);
-		StaticMeshActorPtr p = std::make_shared<StaticMeshActor>(
-			meshStoneWall, "StoneWall", 100, position, glm::vec3(0));
+		StaticMeshActorPtr p = wallPool.GetPtr(wallPool.Create(
+			meshStoneWall, "StoneWall", 100, position, glm::vec3(0)));
 		p->colLocal = Collision::CreateOBB(glm::vec3(0, 0, 0),
 			glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(0, 0, -1), glm::vec3(2, 2, 0.5f));
 		p->rotation = glm::vec3(0, glm::radians(rot), 0);
@@ -134,8 +132,8 @@ StaticMeshActorPtr MainGameScene::CreateStoneWall(glm::vec3 pos, float rot, int
 		const Mesh::FilePtr meshStoneWall = meshBuffer.GetFile("Res/wall_stone.gltf");
 		glm::vec3 position = glm::vec3(pos.x, 0, pos.z + size);
 		position.y = heightMap.Height(position);
-		StaticMeshActorPtr p = std::make_shared<StaticMeshActor>(
-			meshStoneWall, "StoneWall", 100, position, glm::vec3(0));
+		StaticMeshActorPtr p = wallPool.GetPtr(wallPool.Create(
+			meshStoneWall, "StoneWall", 100, position, glm::vec3(0)));
 		p->colLocal = Collision::CreateOBB(glm::vec3(0, 0, 0),
 			glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(0, 0, -1), glm::vec3(0.5f, 2, 2));
 		p->rotation = glm::vec3(0, glm::radians(rot), 0);
@@ -210,6 +208,26 @@ bool MainGameScene::Initialize()
 	{
 		return false;
 	}
+	world.SetHeightMap(&heightMap);
+
+	// U͍UƂ肷(Q□A̍UƂ͔肵Ȃ)
+	{
+		using Collision::Layer;
+		Collision::LayerMatrix& layers = world.Layers();
+		layers.Reset();
+		const Layer attacks[] = { Layer::playerAttack, Layer::enemyAttack };
+		const Layer others[] = { Layer::defaultLayer, Layer::obstacle, Layer::light,
+			Layer::playerAttack, Layer::enemyAttack };
+		for (Layer a : attacks)
+		{
+			for (Layer b : others)
+			{
+				layers.Set(a, b, false);
+			}
+		}
+		layers.Set(Layer::playerAttack, Layer::player, false);
+		layers.Set(Layer::enemyAttack, Layer::enemy, false);
+	}
 	if (!heightMap.CreateMesh(meshBuffer, "Terrain"))
 	{
 		return false;
@@ -230,10 +248,12 @@ bool MainGameScene::Initialize()
 	glm::vec3 startPos(89, 0, 97);
 	startPos.y = heightMap.Height(startPos);
 	player = std::make_shared<PlayerActor>( &heightMap, meshBuffer, startPos);
+	player->SetContactCache(&world.Contacts());
 	cameraRadius = glm::radians(180.0f);
 	cameraRotate = player->rotation.y;
 	
 	objects.Reserve(500);
+	wallPool.Reserve(500);
 
 	rand.seed(0);
 
@@ -601,6 +621,16 @@ bool MainGameScene::Initialize()
 		sprites.push_back(sprWall);
 	}
 
+	// ǂƖ؂͓Ȃ̂ŁABVHďՓ˔ƏQ̌Ɏg
+	for (const ActorPtr& e : objects)
+	{
+		e->SetCollisionLayer(Collision::Layer::obstacle);
+	}
+	objects.SetStatic(true);
+
+	// n`ƏQAGLoHTp̊iq
+	navGrid.Build(glm::ivec2(0), heightMap.Size() - 1, &heightMap, &objects);
+	pathService.Initialize(&navGrid);
 
 	// Cg̔zu
 	lights.Add(std::make_shared<DirectionalLightActor>(
@@ -621,6 +651,8 @@ bool MainGameScene::Initialize()
 			p = std::make_shared<EnemyActor>(&heightMap, meshBuffer, glm::vec3(97, 0, 89));
 			p->position.y = heightMap.Height(p->position);
 			p->ObstacleActor(objects);
+			p->SetNavGrid(&navGrid);
+			p->SetPathService(&pathService);
 			sprEnemy.Texture(Texture::Image2D::Create("Res/Oni.tga"));
 			sprEnemy.Scale(glm::vec2(0.03f));
 			enemies.Add(p);
@@ -635,6 +667,8 @@ bool MainGameScene::Initialize()
 				p = std::make_shared<LoiteringEnemy>(&heightMap, meshBuffer, glm::vec3(97, 0, 89));
 				p->position.y = heightMap.Height(p->position);
 				p->ObstacleActor(objects);
+				p->SetNavGrid(&navGrid);
+				p->SetPathService(&pathService);
 				sprEnemy.Texture(Texture::Image2D::Create("Res/Oni.tga"));
 				sprEnemy.Scale(glm::vec2(0.03f));
 				enemies.Add(p);
@@ -708,10 +742,23 @@ void MainGameScene::ProcessInput()
 */
 void MainGameScene::Update(float deltaTime)
 {
+	PROFILE_SCOPE("MainGameScene::Update");
 	const GLFWEW::Window& window = GLFWEW::Window::Instance();
 	const float w = window.Width();
 	const float h = window.Height();
 	const float lineHenght = fontRenderer.LineHeight();
+
+	// `p̕Ԃ̎n_ƂāAXVȌԂۑ
+	prevCameraPosition = camera.position;
+	prevCameraTarget = camera.target;
+	player->SaveTransform();
+	enemies.SaveTransform();
+	L_enemies.SaveTransform();
+	objects.SaveTransform();
+
+	// O̍XVŎgȂՓ˔̋L^̂āAÎ~ĂAN^[𖰂点
+	world.Contacts().BeginFrame();
+
 	fontRenderer.BeginUpdate();
 
 	fntJizo.BeginUpdate();
@@ -783,7 +830,6 @@ void MainGameScene::Update(float deltaTime)
 	{
 		e->TargetActor(player);
 		DetectCollision(player, e);
-		DetectCollision(e, objects);
 		ActorPtr enemyAttackCollision = e->GetAttackCollision();
 		if (enemyAttackCollision)
 		{
@@ -802,7 +848,13 @@ void MainGameScene::Update(float deltaTime)
 	enemies.Update(deltaTime);
 	L_enemies.Update(deltaTime);
 	lights.Update(deltaTime);
+
+	// GvoHAt[̏ԂȂ͈͂ŒT
+	// ʂČKvꍇ́AԂł͑ł؂Ȃ
+	pathService.Update(pathSearchBudget, window.IsDeterministic() ? 0 : pathSearchTimeLimit);
 	
+	// ړ̈ʒuŔ肷(AN^[͈ړ̓rŐڐGʒu܂Ŗ߂)
+	DetectCollision(enemies, objects);
 	DetectCollision(player, objects);
 
 	glm::vec3 goalPos = glm::vec3(108, 0, 69);
@@ -815,12 +867,6 @@ void MainGameScene::Update(float deltaTime)
 	// Cg̍XV
 	glm::vec3 ambientColor(0.5f, 0.25f, 0.45f);
 	lightBuffer.Update(lights, ambientColor);
-	
-	player->UpdateDrawData(deltaTime);
-	enemies.UpdateDrawData(deltaTime);
-	L_enemies.UpdateDrawData(deltaTime);
-	objects.UpdateDrawData(deltaTime);
-	lights.UpdateDrawData(deltaTime);
 
 	spriteRenderer.BeginUpdate();
 	
@@ -856,11 +902,37 @@ void MainGameScene::Update(float deltaTime)
 	fontRenderer.EndUpdate();
 }
 
+/*
+V[̕`f[^XV
+
+@param deltaTime O̕`悩̌oߎԁibj
+@param alpha     O̍XVʂ̕ԌW(0`1)
+*/
+void MainGameScene::UpdateDrawData(float deltaTime, float alpha)
+{
+	PROFILE_SCOPE("MainGameScene::UpdateDrawData");
+	drawCameraPosition = glm::mix(prevCameraPosition, camera.position, alpha);
+	drawCameraTarget = glm::mix(prevCameraTarget, camera.target, alpha);
+
+	if (state == GameState::clear || state == GameState::over)
+	{
+		return;
+	}
+
+	player->Interpolate(alpha);
+	player->UpdateDrawData(deltaTime);
+	enemies.UpdateDrawData(deltaTime, alpha);
+	L_enemies.UpdateDrawData(deltaTime, alpha);
+	objects.UpdateDrawData(deltaTime, alpha);
+	lights.UpdateDrawData(deltaTime, alpha);
+}
+
 /*
 V[`悷
 */
 void MainGameScene::Render()
 {
+	PROFILE_SCOPE("MainGameScene::Render");
 	const GLFWEW::Window& window = GLFWEW::Window::Instance();
 	const glm::vec2 screenSize(window.Width(), window.Height());
 	
@@ -880,7 +952,7 @@ void MainGameScene::Render()
 	glEnable(GL_BLEND);
 	*/
 
-	const glm::mat4 matView = glm::lookAt(camera.position, camera.target, camera.up);
+	const glm::mat4 matView = glm::lookAt(drawCameraPosition, drawCameraTarget, camera.up);
 	const float aspectRatio =
 		static_cast<float>(window.Width()) / static_cast<float>(window.Height());
 	const glm::mat4 matProj =
@@ -891,7 +963,7 @@ void MainGameScene::Render()
 	
 	const glm::mat4 matModel = glm::translate(glm::mat4(1), cubePos);
 	meshBuffer.SetViewProjectionMatrix(matProj * matView);
-	meshBuffer.SetCameraPosition(camera.position);
+	meshBuffer.SetCameraPosition(drawCameraPosition);
 	meshBuffer.SetTime(window.Time());
 	Mesh::Draw(meshBuffer.GetFile("Terrain"), glm::mat4(1));
 
@@ -950,7 +1022,7 @@ bool MainGameScene::HandleJizoEffects(int id, const glm::vec3& pos)
 	}
 	for (auto& e : enemies)
 	{
-		e->health = 0;
+		e->SetHealth(0);
 	}
 
 	relayFrag = true;
@@ -968,6 +1040,8 @@ bool MainGameScene::HandleJizoEffects(int id, const glm::vec3& pos)
 			p->roundPoints[4] = glm::vec3(94, 0, 82);
 			p->position.y = heightMap.Height(p->position);
 			p->ObstacleActor(objects);
+			p->SetNavGrid(&navGrid);
+			p->SetPathService(&pathService);
 			enemies.Add(p);
 		}
 		else if (i == 1)
@@ -980,6 +1054,8 @@ bool MainGameScene::HandleJizoEffects(int id, const glm::vec3& pos)
 			p->roundPoints[4] = glm::vec3(100, 0, 72);
 			p->position.y = heightMap.Height(p->position);
 			p->ObstacleActor(objects);
+			p->SetNavGrid(&navGrid);
+			p->SetPathService(&pathService);
 			enemies.Add(p);
 		}
 		else if (i == 2)
@@ -992,6 +1068,8 @@ bool MainGameScene::HandleJizoEffects(int id, const glm::vec3& pos)
 			p->roundPoints[4] = glm::vec3(108, 0, 75);
 			p->position.y = heightMap.Height(p->position);
 			p->ObstacleActor(objects);
+			p->SetNavGrid(&navGrid);
+			p->SetPathService(&pathService);
 			enemies.Add(p);
 		}
 	}
@@ -13,6 +13,8 @@
 #include "LoiteringEnemy.h"
 #include "JizoActor.h"
 #include "Light.h"
+#include "NavGrid.h"
+#include "PathService.h"
 #include "FramebufferObject.h"
 #include <random>
 #include <vector>
@@ -29,6 +31,7 @@ public:
 	virtual bool Initialize() override;
 	virtual void ProcessInput() override;
 	virtual void Update(float) override;
+	virtual void UpdateDrawData(float, float) override;
 	virtual void Render() override;
 	virtual void Finalize() override {}
 
@@ -117,6 +120,10 @@ private:
 		void Update(const glm::mat4& matView);
 	};
 	Camera camera;
+	glm::vec3 prevCameraPosition = camera.position; // O̍XVJñJ̈ʒu
+	glm::vec3 prevCameraTarget = camera.target;     // O̍XVJn̒_
+	glm::vec3 drawCameraPosition = camera.position; // `ɎgJ̈ʒu
+	glm::vec3 drawCameraTarget = camera.target;     // `Ɏg_
 
 	enum CameraState
 	{
@@ -129,13 +136,23 @@ private:
 	PlayerActorPtr player;
 	LoiteringEnemyPtr L_enemy;
 	
-	EnemyActorList enemies;
-	LoiteringEnemyList L_enemies;
-	ActorList objects;
-	ActorList tree;
+	ActorPool<StaticMeshActor> wallPool{ 64 }; // ǂ؂Ȃǂ̔zumۂv[
+
+	// ׂẴAN^[XgLԃCfbNX
+	// XgɔjȂ悤AXgOɐ錾邱
+	World world;
+
+	// GjƂɗv̂ŁAG̃XgOɐ錾邱
+	PathService pathService;
+
+	EnemyActorList enemies{ world };
+	LoiteringEnemyList L_enemies{ world };
+	ActorList objects{ world };
+	ActorList tree{ world };
+	NavGrid navGrid; // objectsƒn`oHTp̊iq
 
 	LightBuffer lightBuffer;
-	ActorList lights;
+	ActorList lights{ world };
 
 
 	FramebufferObjectPtr fboMain;
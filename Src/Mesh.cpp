@@ -4,6 +4,7 @@
 #define NOMINMAX
 #include "Mesh.h"
 #include "SkeletalMesh.h"
+#include "Profiler.h"
 #include "json11/json11.hpp"
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -247,6 +248,7 @@ namespace Mesh
 	*/
 	bool Buffer::LoadMesh(const char* path)
 	{
+		PROFILE_SCOPE("Mesh::Buffer::LoadMesh");
 		// glTFt@Cǂݍ
 		std::vector<char> gltfFile = ReadFile(path);
 		if (gltfFile.empty())
@@ -0,0 +1,269 @@
+/*
+@file NavGrid.cpp
+*/
+#include "NavGrid.h"
+#include "Actor.h"
+#include "Terrain.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <float.h>
+
+namespace /* unnamed */ {
+
+const float agentRadius = 0.8f;   // Q炱̋ȓ̊iq͒ʂȂ(G̑傫)
+const float maxSlope = 1.0f;      // ʂ̍ő̌X(/B1.045x)
+const float slopeCostScale = 8.0f; // X1ɑ₷RXg
+
+} // unnamed namespace
+
+const uint8_t NavGrid::blockedCost;
+const uint8_t NavGrid::flatCost;
+const int NavGrid::tileSize;
+
+/*
+iq쐬
+
+@param areaMin   iq͈̔͂̍ŏW
+@param areaMax   iq͈̔͂̍őW(̍W͈͂Ɋ܂)
+@param heightMap nʂ̍(nullptrȂ畽Ƃ݂Ȃ)
+@param obstacles Q̃Xg(nullptrȂQȂ)
+
+heightMapobstaclesRefresh()ŎĝŁAiq蒷邱
+*/
+void NavGrid::Build(const glm::ivec2& areaMin, const glm::ivec2& areaMax,
+	const Terrain::HeightMap* heightMap, const ActorListBase* obstacles)
+{
+	PROFILE_SCOPE("NavGrid::Build");
+	this->areaMin = areaMin;
+	areaSize = glm::max(areaMax - areaMin + 1, glm::ivec2(0));
+	costs.assign(static_cast<size_t>(areaSize.x) * areaSize.y, flatCost);
+	tileCount = (areaSize + tileSize - 1) / tileSize;
+	slopeCounts.assign(static_cast<size_t>(tileCount.x) * tileCount.y, 0);
+	this->heightMap = heightMap;
+	this->obstacles = obstacles;
+	Rasterize(areaMin, areaMax);
+}
+
+/*
+w͈͂̊iq`
+
+@param cellMin ͈͂̍ŏW
+@param cellMax ͈͂̍őW(̍W͈͂Ɋ܂)
+
+n`̌XRXgvZƁA͈͂ɏdȂQ`݁Åiq𐔂
+*/
+void NavGrid::Rasterize(const glm::ivec2& cellMin, const glm::ivec2& cellMax)
+{
+	const glm::ivec2 first = glm::max(cellMin, areaMin);
+	const glm::ivec2 last = glm::min(cellMax, AreaMax());
+	if (first.x > last.x || first.y > last.y)
+	{
+		return;
+	}
+	++revision;
+
+	for (int z = first.y; z <= last.y; ++z)
+	{
+		for (int x = first.x; x <= last.x; ++x)
+		{
+			costs[(z - areaMin.y) * areaSize.x + (x - areaMin.x)] = TerrainCost(x, z);
+		}
+	}
+	if (obstacles)
+	{
+		RasterizeObstacles(first, last);
+	}
+	CountSlopes(first, last);
+}
+
+/*
+͈͂ɏdȂQiqɕ`
+
+@param first ͈͂̍ŏW(iq͈͓̔ł邱)
+@param last  ͈͂̍őW(iq͈͓̔ł邱)
+*/
+void NavGrid::RasterizeObstacles(const glm::ivec2& first, const glm::ivec2& last)
+{
+	// ͈͂̊iqagentRadiusȓɓ肤QW߂
+	Collision::AABB box;
+	box.min = glm::vec3(first.x - agentRadius, -FLT_MAX, first.y - agentRadius);
+	box.max = glm::vec3(last.x + agentRadius, FLT_MAX, last.y + agentRadius);
+	thread_local std::vector<uint32_t> found;
+	found.clear();
+	obstacles->QueryOverlap(box, found);
+
+	const ActorStore& store = obstacles->Store();
+	for (const uint32_t i : found)
+	{
+		// QAABBL͈͂̊iqAiq̒S̋Ŕ肷
+		const Collision::Shape& shape = store.colWorld[i];
+		const Collision::AABB aabb = Collision::CalcAABB(shape);
+		const glm::ivec2 shapeMin = glm::max(first, glm::ivec2(
+			static_cast<int>(std::ceil(aabb.min.x - agentRadius)),
+			static_cast<int>(std::ceil(aabb.min.z - agentRadius))));
+		const glm::ivec2 shapeMax = glm::min(last, glm::ivec2(
+			static_cast<int>(std::floor(aabb.max.x + agentRadius)),
+			static_cast<int>(std::floor(aabb.max.z + agentRadius))));
+		for (int z = shapeMin.y; z <= shapeMax.y; ++z)
+		{
+			for (int x = shapeMin.x; x <= shapeMax.x; ++x)
+			{
+				uint8_t& cost = costs[(z - areaMin.y) * areaSize.x + (x - areaMin.x)];
+				if (cost == blockedCost)
+				{
+					continue;
+				}
+				const glm::vec3 p(x, GroundHeight(x, z), z);
+				const glm::vec3 q = Collision::ClosestPointShape(shape, p);
+				if (glm::dot(p - q, p - q) <= agentRadius * agentRadius)
+				{
+					cost = blockedCost;
+				}
+			}
+		}
+	}
+}
+
+/*
+Q̌`󂪏dȂiq`
+
+@param shape ǉE폜EړQ̏Փˌ`(ړꍇ͈ړOƈړ̗)
+
+QXgXVƂŌĂяo
+*/
+void NavGrid::Refresh(const Collision::Shape& shape)
+{
+	PROFILE_SCOPE("NavGrid::Refresh");
+	glm::ivec2 cellMin, cellMax;
+	if (CellRange(shape, cellMin, cellMax))
+	{
+		Rasterize(cellMin, cellMax);
+	}
+}
+
+/*
+Փˌ`̉e󂯂iq͈̔͂vZ
+
+@param shape   Փˌ`
+@param cellMin ͈͂̍ŏW̊i[
+@param cellMax ͈͂̍őW̊i[(̍W͈͂Ɋ܂)
+
+@retval true  ͈͂vZ
+@retval false `󂪋Ȃ̂Ŕ͈͂Ȃ
+
+Refresh()ŕ`͈̂͂̔͂̊iq
+*/
+bool NavGrid::CellRange(const Collision::Shape& shape, glm::ivec2& cellMin, glm::ivec2& cellMax)
+{
+	const Collision::AABB aabb = Collision::CalcAABB(shape);
+	if (aabb.min.x > aabb.max.x)
+	{
+		return false;
+	}
+	cellMin = glm::ivec2(static_cast<int>(std::floor(aabb.min.x - agentRadius)),
+		static_cast<int>(std::floor(aabb.min.z - agentRadius)));
+	cellMax = glm::ivec2(static_cast<int>(std::ceil(aabb.max.x + agentRadius)),
+		static_cast<int>(std::ceil(aabb.max.z + agentRadius)));
+	return true;
+}
+
+/*
+͈͂̈ړRXglׂ
+
+@param cellMin ͈͂̍ŏW
+@param cellMax ͈͂̍őW(̍W͈͂Ɋ܂)
+
+@retval true  ͈͂̒ʂiq͑Sĕn(iq͈̔͊O͒ʂȂiqƂ݂Ȃ)
+@retval false ͈͂ɍ̊iq邩Ȃ
+
+^CPʂŒׂ̂ŁA͈͂̊Oɂ铯^C̍̊iqłfalseɂȂ
+*/
+bool NavGrid::IsUniform(const glm::ivec2& cellMin, const glm::ivec2& cellMax) const
+{
+	const glm::ivec2 first = glm::max(cellMin, areaMin);
+	const glm::ivec2 last = glm::min(cellMax, AreaMax());
+	if (first.x > last.x || first.y > last.y)
+	{
+		return true;
+	}
+	const glm::ivec2 tileMin = (first - areaMin) / tileSize;
+	const glm::ivec2 tileMax = (last - areaMin) / tileSize;
+	for (int z = tileMin.y; z <= tileMax.y; ++z)
+	{
+		for (int x = tileMin.x; x <= tileMax.x; ++x)
+		{
+			if (slopeCounts[z * tileCount.x + x])
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/*
+͈͂ɏdȂ^C̍̊iq𐔂
+
+@param first ͈͂̍ŏW(iq͈͓̔ł邱)
+@param last  ͈͂̍őW(iq͈͓̔ł邱)
+*/
+void NavGrid::CountSlopes(const glm::ivec2& first, const glm::ivec2& last)
+{
+	const glm::ivec2 tileMin = (first - areaMin) / tileSize;
+	const glm::ivec2 tileMax = (last - areaMin) / tileSize;
+	for (int tz = tileMin.y; tz <= tileMax.y; ++tz)
+	{
+		for (int tx = tileMin.x; tx <= tileMax.x; ++tx)
+		{
+			const int endX = std::min((tx + 1) * tileSize, areaSize.x);
+			const int endZ = std::min((tz + 1) * tileSize, areaSize.y);
+			uint16_t count = 0;
+			for (int z = tz * tileSize; z < endZ; ++z)
+			{
+				for (int x = tx * tileSize; x < endX; ++x)
+				{
+					const uint8_t cost = costs[z * areaSize.x + x];
+					if (cost != blockedCost && cost != flatCost)
+					{
+						++count;
+					}
+				}
+			}
+			slopeCounts[tz * tileCount.x + tx] = count;
+		}
+	}
+}
+
+/*
+n`̌Xiq̈ړRXgvZ
+
+@param x iqXW
+@param z iqZW
+
+@return iq̈ړRXg(}ȂblockedCost)
+*/
+uint8_t NavGrid::TerrainCost(int x, int z) const
+{
+	if (!heightMap)
+	{
+		return flatCost;
+	}
+	const glm::vec3 p(x, 0, z);
+	const float dx = heightMap->Height(p + glm::vec3(0.5f, 0, 0)) - heightMap->Height(p - glm::vec3(0.5f, 0, 0));
+	const float dz = heightMap->Height(p + glm::vec3(0, 0, 0.5f)) - heightMap->Height(p - glm::vec3(0, 0, 0.5f));
+	const float slope = std::sqrt(dx * dx + dz * dz);
+	if (slope > maxSlope)
+	{
+		return blockedCost;
+	}
+	return static_cast<uint8_t>(flatCost + static_cast<int>(slope * slopeCostScale));
+}
+
+/*
+iq̒S̒nʂ̍擾
+*/
+float NavGrid::GroundHeight(int x, int z) const
+{
+	return heightMap ? heightMap->Height(glm::vec3(x, 0, z)) : 0.0f;
+}
@@ -0,0 +1,84 @@
+/*
+@file NavGrid.h
+*/
+#ifndef NAVGRID_H_INCLUDED
+#define NAVGRID_H_INCLUDED
+#include "Collision.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <stdint.h>
+
+class ActorListBase;
+namespace Terrain { class HeightMap; }
+
+/*
+oHTpɁAiqƂ̈ړRXgL^NX
+
+iq̑傫1ŁAiq(x, z)̒S̓[hW(x, nʂ̍, z)ɂ(Astar̊iqƓ)
+RXg1oCgŁA0ȂʂȂA1nA⓹قǑ傫Ȃ
+
+Build()Œn`̌XƏQXg̏Փˌ`xiqɕ`݁A
+QǉE폜ƂRefresh()ł̌`󂪏dȂiq`
+Q苗(G̑傫)ȓ̊iqƁA}̊iq͒ʂȂ
+̊iq̐tileSizelƂɐĂAIsUniform()Ŕ͈͂̃RXglׂ
+
+T(G̍XV)ɏȂƁBǂݎ͕̃Xbh瓯ɍsĂ悢
+*/
+class NavGrid
+{
+public:
+	static const uint8_t blockedCost = 0; // ʂȂiq̃RXg
+	static const uint8_t flatCost = 1;    // ñRXg
+	static const int tileSize = 16;       // ̊iq𐔂P(iq̐)
+
+	NavGrid() = default;
+	~NavGrid() = default;
+	NavGrid(const NavGrid&) = delete;
+	NavGrid& operator=(const NavGrid&) = delete;
+
+	void Build(const glm::ivec2& areaMin, const glm::ivec2& areaMax,
+		const Terrain::HeightMap* heightMap, const ActorListBase* obstacles);
+	void Rasterize(const glm::ivec2& cellMin, const glm::ivec2& cellMax);
+	void Refresh(const Collision::Shape& shape);
+	static bool CellRange(const Collision::Shape& shape, glm::ivec2& cellMin, glm::ivec2& cellMax);
+	bool IsUniform(const glm::ivec2& cellMin, const glm::ivec2& cellMax) const;
+
+	/*
+	iq̈ړRXg擾(͈͊O͒ʂȂ)
+	*/
+	uint8_t Cost(int x, int z) const
+	{
+		const int lx = x - areaMin.x;
+		const int lz = z - areaMin.y;
+		if (lx < 0 || lz < 0 || lx >= areaSize.x || lz >= areaSize.y)
+		{
+			return blockedCost;
+		}
+		return costs[lz * areaSize.x + lx];
+	}
+	bool IsWalkable(int x, int z) const { return Cost(x, z) != blockedCost; }
+
+	const glm::ivec2& AreaMin() const { return areaMin; }
+	glm::ivec2 AreaMax() const { return areaMin + areaSize - 1; }
+
+	// iq`тɑԍ(TɊiqςׂ邽߂Ɏg)
+	uint32_t Revision() const { return revision; }
+
+private:
+	uint8_t TerrainCost(int x, int z) const;
+	float GroundHeight(int x, int z) const;
+	void RasterizeObstacles(const glm::ivec2& first, const glm::ivec2& last);
+	void CountSlopes(const glm::ivec2& first, const glm::ivec2& last);
+
+	glm::ivec2 areaMin = glm::ivec2(0);  // iq͈̔͂̍ŏW
+	glm::ivec2 areaSize = glm::ivec2(0); // iq͈̔͂̑傫
+	std::vector<uint8_t> costs;          // iqƂ̈ړRXg
+	uint32_t revision = 0;               // iq`
+	glm::ivec2 tileCount = glm::ivec2(0); // XZ̃^C̐
+	std::vector<uint16_t> slopeCounts;    // ^CƂ́AnłȂʂiq̐
+
+	const Terrain::HeightMap* heightMap = nullptr; // nʂ̍(nullptrȂ畽)
+	const ActorListBase* obstacles = nullptr;      // Q̃Xg
+};
+
+#endif // !NAVGRID_H_INCLUDED
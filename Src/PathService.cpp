@@ -0,0 +1,415 @@
+/*
+@file PathService.cpp
+*/
+#include "PathService.h"
+#include "NavGrid.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+
+namespace /* unnamed */ {
+
+// f⎞ԂmFԊu(N[YXgɈڂm[h̐)
+const size_t expansionsPerCheck = 64;
+
+} // unnamed namespace
+
+const PathService::Ticket PathService::invalidTicket;
+const PathService::AgentId PathService::invalidAgent;
+
+/*
+TɎgiqݒ肷
+
+@param grid iqƂ̈ړRXg(̃IuWFNg蒷邱)
+
+iqɕāAǂT̏
+܂Aiq̂܂܂̒TJPS+ōs߂ɃWvvZĂ
+󂯕tς݂̗v͑SĎ
+*/
+void PathService::Initialize(const NavGrid* grid)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	this->grid = grid;
+	hierarchy.Build(grid);
+	if (grid)
+	{
+		jumpPointMap.Build(*grid);
+		astar.SetJumpPointMap(&jumpPointMap);
+	}
+	arrivals.clear();
+	queries.clear();
+	responses.clear();
+	runningTicket = invalidTicket;
+	runningAgent = invalidAgent;
+	isRunning = false;
+}
+
+/*
+Q̌`󂪏dȂvZ
+
+@param shape ǉE폜EړQ̏Փˌ`
+
+NavGrid::Refresh()Ŋiq`ƁAUpdate()ƓXbhĂяo
+Wv͌vZȂ̂ŁAiq`Ƃ̒TJPS+̑JPSōs
+*/
+void PathService::Refresh(const Collision::Shape& shape)
+{
+	hierarchy.Refresh(shape);
+}
+
+/*
+G[WFgԍ𔭍s
+
+@return VG[WFgԍ
+
+ɓ͂v́A̔ԍ̏ɒT
+ԍ͔sɌ܂̂ŁAG쐬鏈ȂǁAš܂ƂŌĂяo
+*/
+PathService::AgentId PathService::RegisterAgent()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	const AgentId id = nextAgent;
+	if (++nextAgent == invalidAgent)
+	{
+		nextAgent = invalidAgent + 1;
+	}
+	return id;
+}
+
+/*
+oH̒Tv
+
+@param start X^[gn_̊iq
+@param goal  S[n_̊iq
+@param agent RegisterAgent()Ŏ󂯎G[WFgԍ(G[WFǧÂv͎)
+
+@return ʂ̎󂯎Ɏg`Pbg
+*/
+PathService::Ticket PathService::Request(const glm::ivec2& start, const glm::ivec2& goal,
+	AgentId agent)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (agent != invalidAgent)
+	{
+		Forget(agent);
+	}
+
+	Query q;
+	q.ticket = nextTicket;
+	if (++nextTicket == invalidTicket)
+	{
+		nextTicket = invalidTicket + 1;
+	}
+	q.agent = agent;
+	q.start = start;
+	q.goal = goal;
+	arrivals.push_back(q);
+	return q.ticket;
+}
+
+/*
+v̏Ԃ𒲂ׂ
+
+@param ticket    Request()Ŏ󂯎`Pbg
+@param waypoints oH̊i[Bʂfound̏ꍇAX^[gS[܂ł̗vɊi[
+
+@return v̏ԁBfoundnotFoundԂ`PbǵAȌunknownɂȂ
+*/
+PathService::Result PathService::Poll(Ticket ticket, std::vector<glm::ivec2>& waypoints)
+{
+	if (ticket == invalidTicket)
+	{
+		return Result::unknown;
+	}
+	std::lock_guard<std::mutex> lock(mutex);
+	for (auto itr = responses.begin(); itr != responses.end(); ++itr)
+	{
+		if (itr->ticket == ticket)
+		{
+			const Result result = itr->result;
+			waypoints.swap(itr->path);
+			if (&*itr != &responses.back())
+			{
+				*itr = std::move(responses.back());
+			}
+			responses.pop_back();
+			return result;
+		}
+	}
+	if (ticket == runningTicket)
+	{
+		return Result::pending;
+	}
+	for (const Query& e : queries)
+	{
+		if (e.ticket == ticket)
+		{
+			return Result::pending;
+		}
+	}
+	for (const Query& e : arrivals)
+	{
+		if (e.ticket == ticket)
+		{
+			return Result::pending;
+		}
+	}
+	return Result::unknown;
+}
+
+/*
+v
+
+@param ticket Request()Ŏ󂯎`Pbg
+
+T̗v́AUpdate()ŒTł؂
+*/
+void PathService::Cancel(Ticket ticket)
+{
+	if (ticket == invalidTicket)
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> lock(mutex);
+	if (ticket == runningTicket)
+	{
+		runningTicket = invalidTicket;
+		runningAgent = invalidAgent;
+	}
+	arrivals.erase(std::remove_if(arrivals.begin(), arrivals.end(),
+		[ticket](const Query& e) { return e.ticket == ticket; }), arrivals.end());
+	queries.erase(std::remove_if(queries.begin(), queries.end(),
+		[ticket](const Query& e) { return e.ticket == ticket; }), queries.end());
+	responses.erase(std::remove_if(responses.begin(), responses.end(),
+		[ticket](const Response& e) { return e.ticket == ticket; }), responses.end());
+}
+
+/*
+vԂɒT
+
+@param maxExpansions   TĂ悢m[h(N[YXgɈڂm[h̐)
+@param maxMicroseconds TɎgĂ悢(}CNb)B0ȉȂ玞Ԃł͑ł؂Ȃ
+
+ǑĂяoȍ~ɓ͂vAG[WFgԍ̏ɑ҂s̖ɉĂT
+(͕͂ɍXVG̎sŕς邽)
+m[hg؂AT̓rłfĎ̌ĂяoőT
+T̓rŊiqꂽꍇ́A̗vŏT
+ǂT͒ZԂŏÎŁArŒfȂ(Tm[h͐)
+
+Ԃ̏̓t[̏Ԃ邽߂̕یŁAw肷ƌʂsxɍE
+͂̋L^ĐȂǁAʂČKvꍇ0w肷邱
+*/
+void PathService::Update(size_t maxExpansions, int maxMicroseconds)
+{
+	PROFILE_SCOPE("PathService::Update");
+	if (!grid)
+	{
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		std::sort(arrivals.begin(), arrivals.end(), IsEarlier);
+		queries.insert(queries.end(), arrivals.begin(), arrivals.end());
+		arrivals.clear();
+	}
+
+	const bool hasTimeLimit = maxMicroseconds > 0;
+	const auto deadline = std::chrono::steady_clock::now() +
+		std::chrono::microseconds(maxMicroseconds);
+	size_t expansions = 0;
+	while (expansions < maxExpansions)
+	{
+		if (hasTimeLimit && std::chrono::steady_clock::now() >= deadline)
+		{
+			break;
+		}
+
+
+		bool isNew = false;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (isRunning && runningTicket != running.ticket)
+			{
+				isRunning = false; // ꂽ
+			}
+			if (!isRunning)
+			{
+				if (queries.empty())
+				{
+					runningTicket = invalidTicket;
+					runningAgent = invalidAgent;
+					return;
+				}
+				running = queries.front();
+				queries.pop_front();
+				runningTicket = running.ticket;
+				runningAgent = running.agent;
+				isRunning = true;
+				isNew = true;
+			}
+		}
+
+		if (isNew || gridRevision != grid->Revision())
+		{
+			gridRevision = grid->Revision();
+			if (!BeginQuery())
+			{
+				expansions += std::max<size_t>(hierarchy.ExpandedCount(), 1);
+				continue;
+			}
+		}
+		const size_t expandedBefore = astar.ExpandedCount();
+		const Astar::SearchState state = astar.Step(std::min(expansionsPerCheck, maxExpansions - expansions));
+		expansions += std::max<size_t>(astar.ExpandedCount() - expandedBefore, 1);
+		if (state == Astar::SearchState::found)
+		{
+			astar.GetPath(path);
+			Finish(Result::found);
+		}
+		else if (state == Astar::SearchState::notFound)
+		{
+			// 2_͂ޔ͈͂ŌȂ΁ǍoHǂĒT
+			if (isWindowed && hierarchy.FindAbstractPath(running.start, running.goal, path))
+			{
+				Finish(Result::found);
+			}
+			else
+			{
+				Finish(Result::notFound);
+			}
+			if (isWindowed)
+			{
+				expansions += hierarchy.ExpandedCount();
+			}
+		}
+	}
+}
+
+/*
+oH̗v̊Ԃ́Aiq̌oHT
+
+@param from Ԃ̎n_(Poll()Ŏ󂯎v)
+@param to   Ԃ̏I_(from̗̎v)
+@param path oH̊i[(fromto܂ł̊iqɊi[)
+
+@retval true  oH
+@retval false oH݂Ȃ(v󂯎ƂŊiqꂽꍇȂ)
+
+̃Xbh瓯ɌĂяoĂ悢
+*/
+bool PathService::Refine(const glm::ivec2& from, const glm::ivec2& to, std::vector<glm::ivec2>& path) const
+{
+	thread_local Astar astar;
+	astar.SetJumpPointMap(&jumpPointMap);
+	return hierarchy.Refine(from, to, astar, path);
+}
+
+/*
+T҂ƒT̗v̐擾
+*/
+size_t PathService::PendingCount() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return arrivals.size() + queries.size() + (runningTicket != invalidTicket ? 1 : 0);
+}
+
+/*
+G[WFg̗vƌʂSĎ
+
+mutexbNĂĂяo
+*/
+void PathService::Forget(AgentId agent)
+{
+	if (runningAgent == agent)
+	{
+		runningTicket = invalidTicket;
+		runningAgent = invalidAgent;
+	}
+	arrivals.erase(std::remove_if(arrivals.begin(), arrivals.end(),
+		[agent](const Query& e) { return e.agent == agent; }), arrivals.end());
+	queries.erase(std::remove_if(queries.begin(), queries.end(),
+		[agent](const Query& e) { return e.agent == agent; }), queries.end());
+	responses.erase(std::remove_if(responses.begin(), responses.end(),
+		[agent](const Response& e) { return e.agent == agent; }), responses.end());
+}
+
+/*
+T̗v̒TJn
+
+@retval true  iq̂܂A*ŒTJnBStep()ŒTi߂
+@retval false ǂĒTAʂ󂯎҂ɂ
+
+X^[gƃS[̋悪ׂ荇Ă΁A2_͂ޔ͈͂iq̂܂A*ŒT
+*/
+bool PathService::BeginQuery()
+{
+	const glm::ivec2 distance = glm::abs(hierarchy.ClusterOf(running.start) - hierarchy.ClusterOf(running.goal));
+	if (distance.x > 1 || distance.y > 1)
+	{
+		isWindowed = false;
+		Finish(hierarchy.FindAbstractPath(running.start, running.goal, path) ? Result::found : Result::notFound);
+		return false;
+	}
+
+	// 2_͂ޔ͈͂1LĒT
+	const glm::ivec2 areaMin = glm::max(glm::min(running.start, running.goal) - HierarchicalAstar::clusterSize,
+		grid->AreaMin());
+	const glm::ivec2 areaMax = glm::min(glm::max(running.start, running.goal) + HierarchicalAstar::clusterSize,
+		grid->AreaMax());
+	isWindowed = areaMin != grid->AreaMin() || areaMax != grid->AreaMax();
+	astar.SetArea(areaMin, areaMax);
+	astar.BeginSearch(running.start, running.goal, *grid);
+	return true;
+}
+
+/*
+T̗v̌ʂ󂯎҂ɂ
+
+@param result ŤʁBfound̏ꍇAoHpathɊi[Ă
+*/
+void PathService::Finish(Result result)
+{
+	isRunning = false;
+	Response r;
+	r.ticket = running.ticket;
+	r.agent = running.agent;
+	r.result = result;
+	if (result == Result::found)
+	{
+		r.path.swap(path);
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (runningTicket == running.ticket)
+	{
+		responses.push_back(std::move(r));
+		runningTicket = invalidTicket;
+		runningAgent = invalidAgent;
+	}
+}
+
+/*
+vT鏇Ԃ߂
+
+G[WFgԍ̏ɕׂBG[WFgw肵Ȃv͒n_̏ɕׂ
+*/
+bool PathService::IsEarlier(const Query& a, const Query& b)
+{
+	if (a.agent != b.agent)
+	{
+		return a.agent < b.agent;
+	}
+	if (a.start.x != b.start.x)
+	{
+		return a.start.x < b.start.x;
+	}
+	if (a.start.y != b.start.y)
+	{
+		return a.start.y < b.start.y;
+	}
+	if (a.goal.x != b.goal.x)
+	{
+		return a.goal.x < b.goal.x;
+	}
+	return a.goal.y < b.goal.y;
+}
@@ -0,0 +1,122 @@
+/*
+@file PathService.h
+*/
+#ifndef PATHSERVICE_H_INCLUDED
+#define PATHSERVICE_H_INCLUDED
+#include "Astar.h"
+#include "HierarchicalAstar.h"
+#include "JumpPointMap.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+
+class NavGrid;
+
+/*
+oHT̗v󂯕tāAt[܂m[hTNX
+
+g:
+-# Initialize()ŒTɎgiqݒ肷
+-# GRegisterAgent()ŃG[WFgԍ󂯎Ă
+-# GRequest()ŌoHvA󂯎`PbgPoll()ɓnČʂ󂯎
+   ʂ͂܂ł́AǑoHH葱Ȃǂđ҂
+-# V[͖t[Update()ĂяoBOUpdate()ȍ~ɓ͂v
+   G[WFgԍ̏ɕׂđ҂sɉA擪w肵m[h܂ŒT
+   g؂T̓rłfÃt[őT
+-# Q𓮂ANavGrid::Refresh()̂ƂRefresh()Ăяo
+
+󂯎oH́Av̊iqׂ́Bׂ荇v̊ԂRefine()Ŋiq̌oHɂ
+X^[gƃS[߂ꍇ́A2_͂ޔ͈͂iq̂܂A*ŒT
+(vׂ͗荇iqɂȂARefine()͒TɕԂ)
+ꍇHierarchicalAstarŋ̓ǂvT
+iq̂܂܂̒T́A͈͂̃RXglȂAstarIJPS(+)g
+
+T̐iݕ͗v̓͂⏈ԂɍEȂ̂ŁA͂̋L^ƍĐŌʂv
+(Update()ɎԂ̏w肵ꍇ)
+
+1̃G[WFgĂv1ŁAVvoƌÂv͎
+Request()APoll()ACancel()͕̃Xbh瓯ɌĂяoĂ悢(G̍XV͕ɍs)
+Update()͊iqXbhƓXbhĂяo
+*/
+class PathService
+{
+public:
+	using Ticket = uint32_t;
+	using AgentId = uint32_t;
+	static const Ticket invalidTicket = 0;   // ȃ`Pbg
+	static const AgentId invalidAgent = 0;   // ǂ̃G[WFgłȂ
+
+	// v̏
+	enum class Result
+	{
+		pending,  // T҂A܂͒T
+		found,    // oH
+		notFound, // oH݂Ȃ
+		unknown,  // ȃ`Pbg(ς݁A󂯎ς݂܂)
+	};
+
+	PathService() = default;
+	~PathService() = default;
+	PathService(const PathService&) = delete;
+	PathService& operator=(const PathService&) = delete;
+
+	void Initialize(const NavGrid* grid);
+	void Refresh(const Collision::Shape& shape);
+	AgentId RegisterAgent();
+	Ticket Request(const glm::ivec2& start, const glm::ivec2& goal, AgentId agent);
+	Result Poll(Ticket ticket, std::vector<glm::ivec2>& waypoints);
+	void Cancel(Ticket ticket);
+	bool Refine(const glm::ivec2& from, const glm::ivec2& to, std::vector<glm::ivec2>& path) const;
+	void Update(size_t maxExpansions, int maxMicroseconds = 0);
+	size_t PendingCount() const;
+
+private:
+	// T҂̗v
+	struct Query
+	{
+		Ticket ticket = invalidTicket;
+		AgentId agent = invalidAgent;
+		glm::ivec2 start = glm::ivec2(0);
+		glm::ivec2 goal = glm::ivec2(0);
+	};
+
+	// 󂯎҂̌
+	struct Response
+	{
+		Ticket ticket = invalidTicket;
+		AgentId agent = invalidAgent;
+		Result result = Result::notFound;
+		std::vector<glm::ivec2> path; // oH̗v
+	};
+
+	void Forget(AgentId agent);
+	bool BeginQuery();
+	void Finish(Result result);
+	static bool IsEarlier(const Query& a, const Query& b);
+
+	const NavGrid* grid = nullptr;
+	HierarchicalAstar hierarchy; // 2_̒Tp̋(Refine()͕̃Xbhǂݎ)
+	JumpPointMap jumpPointMap;   // JPS+̃Wv(Refine()͕̃Xbhǂݎ)
+
+	// mutexŕی삷ϐ
+	mutable std::mutex mutex;
+	std::vector<Query> arrivals;     // OUpdate()ȍ~ɓ͂v(͎͂ŝтɕς)
+	std::deque<Query> queries;       // T҂̗v(Update()ƂɃG[WFgԍŖɉ)
+	std::vector<Response> responses; // 󂯎҂̌
+	Ticket runningTicket = invalidTicket;  // T̗ṽ`Pbg(ꂽinvalidTicket)
+	AgentId runningAgent = invalidAgent;   // T̗ṽG[WFg
+	Ticket nextTicket = 1;                 // ɔs`Pbg
+	AgentId nextAgent = 1;                 // ɔsG[WFgԍ
+
+	// Update()ĂяoXbhgϐ
+	Astar astar;
+	std::vector<glm::ivec2> path; // oH̍Ɨ̈
+	Query running;                // T̗v
+	bool isWindowed = false;      // 2_͂ޔ͈͂TĂtrue
+	bool isRunning = false;       // T̗vtrue
+	uint32_t gridRevision = 0;    // TJnƂ̊iq̔ԍ
+};
+
+#endif // !PATHSERVICE_H_INCLUDED
@@ -5,6 +5,13 @@
 #include "SkeletalMesh.h"
 #include <glm/gtc/matrix_transform.hpp>
 
+namespace /* unnamed */ {
+
+// ĂAN^[Ƃ̔Aʏ̏Փ˔ƋʂContactCacheɋL^邽߂̒l
+const uint32_t boardingTag = 1;
+
+} // unnamed namespace
+
 /*
 RXgN^
 */
@@ -13,6 +20,8 @@ PlayerActor::PlayerActor(const Terrain::HeightMap* hm, const Mesh::Buffer& buffe
 	: SkeletalMeshActor(buffer.GetSkeletalMesh("Bikuni"), "Player", 13, pos, rot), heightMap(hm)
 {
 	colLocal = Collision::CreateSphere(glm::vec3(0, 0.7f, 0), 0.7f);
+	SetCollisionLayer(Collision::Layer::player);
+	attackCollisionPool.Reserve(1);
 	GetMesh()->Play("Idle");
 	state = State::idle;
 }
@@ -70,7 +79,11 @@ void PlayerActor::Update(float deltaTime)
 			Collision::Shape col = colWorld;
 			col.s.r += 0.1f; // Փ˔傫
 			glm::vec3 pa, pb;
-			if (!Collision::TestShapeShape(col, boardingActor->colWorld, &pa, &pb))
+			const bool isBoarding = contactCache ?
+				contactCache->Test(this, col, boardingActor.get(), boardingActor->colWorld,
+					&pa, &pb, boardingTag) :
+				Collision::TestShapeShape(col, boardingActor->colWorld, &pa, &pb);
+			if (!isBoarding)
 			{
 				boardingActor.reset();
 			}
@@ -144,17 +157,23 @@ void PlayerActor::Update(float deltaTime)
 				static const float radian = 1.0f;
 				const glm::vec3 front = glm::rotate(glm::mat4(1), rotation.y,
 					glm::vec3(0, 1, 0)) * glm::vec4(0, 0, 1.5f, 1);
-				attackCollision = std::make_shared<Actor>("PlayerAttackCollision", 5,
+				// O͒ZœKɎ܂钷ɂāÃq[vmۂ
+				attackHandle = attackCollisionPool.Create("AttackCollision", 5,
 					position + front + glm::vec3(0, 1, 0), glm::vec3(0), glm::vec3(radian));
+				attackCollision = attackCollisionPool.GetPtr(attackHandle);
 				attackCollision->colLocal = Collision::CreateSphere(glm::vec3(0), radian);
+				attackCollision->SetCollisionLayer(Collision::Layer::playerAttack,
+					Collision::ToMask(Collision::Layer::enemy));
 			}
 		}
 		else
 		{
+			attackCollisionPool.Destroy(attackHandle);
 			attackCollision.reset();
 		}
 		if (GetMesh()->IsFinished())
 		{
+			attackCollisionPool.Destroy(attackHandle);
 			attackCollision.reset();
 			GetMesh()->Play("Idle");
 			state = State::idle;
@@ -23,6 +23,7 @@ public:
 	void Jump();
 	void ProcessInput();
 	void SetBoardingActor(ActorPtr);
+	void SetContactCache(ContactCache* p) { contactCache = p; }
 	const ActorPtr& GetAttackCollision() const { return attackCollision; }
 
 private:
@@ -43,9 +44,12 @@ private:
 	ActorPtr boardingActor;    // ĂAN^[
 	float moveSpeed = 5.0f;    // ړx
 	ActorPtr attackCollision;  // U
+	ActorHandle attackHandle;  // Ũnh
+	ActorPool<Actor> attackCollisionPool{ 1 }; // Ug񂷂߂̃v[
 	float attackTimer = 0;     // U
 
 	const Terrain::HeightMap* heightMap = nullptr;
+	ContactCache* contactCache = nullptr; // ĂAN^[Ƃ̔ɎgL^
 public:
 	bool debugFrag = false;
 	glm::mat4 velocityRotY;
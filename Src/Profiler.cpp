@@ -0,0 +1,366 @@
+/*
+@file Profiler.cpp
+*/
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+namespace /* unnamed */ {
+
+// ݂̃XbhgL^obt@
+thread_local void* currentBuffer = nullptr;
+
+// ̊_
+const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+
+/*
+Oׂ
+
+񃊃eł|PʂႦ΃AhXقȂ邱Ƃ̂ŁAeŔr
+*/
+bool IsSameName(const char* a, const char* b)
+{
+	if (a == b)
+	{
+		return true;
+	}
+	return a && b && strcmp(a, b) == 0;
+}
+
+/*
+JSONƂďo͂
+*/
+void WriteJsonString(FILE* fp, const char* s)
+{
+	fputc('"', fp);
+	for (; *s; ++s)
+	{
+		if (*s == '"' || *s == '\\')
+		{
+			fputc('\\', fp);
+		}
+		fputc(*s, fp);
+	}
+	fputc('"', fp);
+}
+
+// t[̏Wv
+struct SummaryItem
+{
+	const char* name = nullptr;
+	const char* parent = nullptr;
+	int depth = 0;
+	int64_t first = 0; // ŏɊJn(\Ɏg)
+	int64_t total = 0; // v(imb)
+	int count = 0;     // Ăяo
+};
+
+/*
+Wvʂ؍\ŕ\
+
+@param items  Wv
+@param parent \Ԃ̐e̖O
+@param depth  \Ԃ̐[
+*/
+void PrintSummaryTree(const std::vector<SummaryItem>& items, const char* parent, int depth)
+{
+	for (const SummaryItem& e : items)
+	{
+		if (e.depth != depth || !IsSameName(e.parent, parent))
+		{
+			continue;
+		}
+		printf("  %*s%-*s %9.3fms %6d\n", depth * 2, "", 40 - depth * 2, e.name,
+			static_cast<double>(e.total) / 1000000.0, e.count);
+		PrintSummaryTree(items, e.name, depth + 1);
+	}
+}
+
+} // unnamed namespace
+
+std::atomic<bool> Profiler::isEnabled{ false };
+
+/*
+vt@C̃VOgCX^X擾
+
+@return vt@C̃CX^X
+*/
+Profiler& Profiler::Instance()
+{
+	static Profiler instance;
+	return instance;
+}
+
+/*
+v̗LE؂ւ
+
+@param enable trueȂvJnAfalseȂ~
+*/
+void Profiler::SetEnabled(bool enable)
+{
+	isEnabled.store(enable, std::memory_order_relaxed);
+}
+
+/*
+݂̃Xbh̖Oݒ肷
+
+@param name g[Xɕ\Xbh
+*/
+void Profiler::SetThreadName(const char* name)
+{
+	ThreadBuffer& buffer = CurrentBuffer();
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	buffer.name = name;
+}
+
+/*
+ݎ擾
+
+@return vOJňoߎ(imb)
+*/
+int64_t Profiler::Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - origin).count();
+}
+
+/*
+݂̃Xbh̋L^obt@擾
+
+߂ČĂяoXbhł̓obt@쐬
+*/
+Profiler::ThreadBuffer& Profiler::CurrentBuffer()
+{
+	if (!currentBuffer)
+	{
+		std::lock_guard<std::mutex> lock(buffersMutex);
+		buffers.emplace_back(new ThreadBuffer);
+		ThreadBuffer& buffer = *buffers.back();
+		buffer.events.resize(ThreadBuffer::capacity);
+		buffer.id = static_cast<int>(buffers.size());
+		buffer.name = "Thread " + std::to_string(buffer.id);
+		currentBuffer = &buffer;
+	}
+	return *static_cast<ThreadBuffer*>(currentBuffer);
+}
+
+/*
+Ԃ̌vJn
+
+@param name Ԃ̖O
+*/
+void Profiler::BeginScope(const char* name)
+{
+	CurrentBuffer().scopeStack.push_back(name);
+}
+
+/*
+Ԃ̌vIAL^
+
+@param begin Ԃ̊Jn
+*/
+void Profiler::EndScope(int64_t begin)
+{
+	const int64_t end = Now();
+	ThreadBuffer& buffer = CurrentBuffer();
+	if (buffer.scopeStack.empty())
+	{
+		return;
+	}
+	Event e;
+	e.name = buffer.scopeStack.back();
+	buffer.scopeStack.pop_back();
+	e.parent = buffer.scopeStack.empty() ? nullptr : buffer.scopeStack.back();
+	e.begin = begin;
+	e.end = end;
+	e.depth = static_cast<int>(buffer.scopeStack.size());
+
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	buffer.events[buffer.head] = e;
+	buffer.head = (buffer.head + 1) % ThreadBuffer::capacity;
+	if (buffer.size < ThreadBuffer::capacity)
+	{
+		++buffer.size;
+	}
+}
+
+/*
+t[̌vJn
+*/
+void Profiler::BeginFrame()
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+	frameBegin = Now();
+	BeginScope("Frame");
+}
+
+/*
+t[̌vI
+
+t[̏ԂSetSpikeThreshold()Őݒ肵Ԃ𒴂Ă\
+*/
+void Profiler::EndFrame()
+{
+	if (!IsEnabled() || frameBegin <= 0)
+	{
+		return;
+	}
+	EndScope(frameBegin);
+	lastFrameBegin = frameBegin;
+	lastFrameEnd = Now();
+	frameBegin = 0;
+	if (spikeThreshold > 0 && LastFrameTime() > spikeThreshold)
+	{
+		PrintFrameSummary();
+	}
+}
+
+/*
+ŌɏIt[̏Ԃ擾
+
+@return (~b)
+*/
+double Profiler::LastFrameTime() const
+{
+	return static_cast<double>(lastFrameEnd - lastFrameBegin) / 1000000.0;
+}
+
+/*
+w肵ԓɋL^ꂽԂ擾
+
+@param begin  擾鎞Ԃ̊Jn
+@param end    擾鎞Ԃ̏I
+@param result 擾Ԃ̊i[(XbhƂɊJn)
+*/
+void Profiler::CollectEvents(int64_t begin, int64_t end,
+	std::vector<std::pair<const ThreadBuffer*, std::vector<Event>>>& result) const
+{
+	std::lock_guard<std::mutex> lockBuffers(buffersMutex);
+	for (const auto& buffer : buffers)
+	{
+		std::vector<Event> events;
+		{
+			std::lock_guard<std::mutex> lock(buffer->mutex);
+			events.reserve(buffer->size);
+			const size_t first = (buffer->head + ThreadBuffer::capacity - buffer->size) %
+				ThreadBuffer::capacity;
+			for (size_t i = 0; i < buffer->size; ++i)
+			{
+				const Event& e = buffer->events[(first + i) % ThreadBuffer::capacity];
+				if (e.begin >= begin && e.end <= end)
+				{
+					events.push_back(e);
+				}
+			}
+		}
+		if (!events.empty())
+		{
+			std::sort(events.begin(), events.end(),
+				[](const Event& a, const Event& b) { return a.begin < b.begin; });
+			result.emplace_back(buffer.get(), std::move(events));
+		}
+	}
+}
+
+/*
+ŌɏIt[̓\
+
+XbhƂɁAԂ̍vԂƌĂяo񐔂Kw\ŕ\
+*/
+void Profiler::PrintFrameSummary() const
+{
+	if (lastFrameEnd <= lastFrameBegin)
+	{
+		return;
+	}
+	std::vector<std::pair<const ThreadBuffer*, std::vector<Event>>> threads;
+	CollectEvents(lastFrameBegin, lastFrameEnd, threads);
+
+	printf("[Profiler] frame %.3fms\n", LastFrameTime());
+	for (const auto& thread : threads)
+	{
+		std::vector<SummaryItem> items;
+		for (const Event& e : thread.second)
+		{
+			auto itr = std::find_if(items.begin(), items.end(), [&e](const SummaryItem& item) {
+				return item.depth == e.depth && IsSameName(item.name, e.name) &&
+					IsSameName(item.parent, e.parent);
+			});
+			if (itr == items.end())
+			{
+				SummaryItem item;
+				item.name = e.name;
+				item.parent = e.parent;
+				item.depth = e.depth;
+				item.first = e.begin;
+				items.push_back(item);
+				itr = items.end() - 1;
+			}
+			itr->total += e.end - e.begin;
+			++itr->count;
+		}
+		std::string name;
+		{
+			std::lock_guard<std::mutex> lock(thread.first->mutex);
+			name = thread.first->name;
+		}
+		printf(" %s\n", name.c_str());
+		PrintSummaryTree(items, nullptr, 0);
+	}
+	fflush(stdout);
+}
+
+/*
+L^ԂChromẽg[X`ŏo͂
+
+@param filename o͂t@C
+
+@retval true  o͐
+@retval false o͎s
+*/
+bool Profiler::WriteChromeTrace(const char* filename) const
+{
+	FILE* fp = fopen(filename, "w");
+	if (!fp)
+	{
+		std::cerr << "[G[]" << __func__ << ": " << filename << "쐬ł܂\n";
+		return false;
+	}
+
+	std::vector<std::pair<const ThreadBuffer*, std::vector<Event>>> threads;
+	CollectEvents(0, INT64_MAX, threads);
+
+	fputs("{\"traceEvents\":[\n", fp);
+	bool isFirst = true;
+	for (const auto& thread : threads)
+	{
+		std::string name;
+		{
+			std::lock_guard<std::mutex> lock(thread.first->mutex);
+			name = thread.first->name;
+		}
+		fprintf(fp, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":",
+			isFirst ? "" : ",\n", thread.first->id);
+		WriteJsonString(fp, name.c_str());
+		fputs("}}", fp);
+		isFirst = false;
+		for (const Event& e : thread.second)
+		{
+			fputs(",\n{\"name\":", fp);
+			WriteJsonString(fp, e.name);
+			fprintf(fp, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+				thread.first->id, static_cast<double>(e.begin) / 1000.0,
+				static_cast<double>(e.end - e.begin) / 1000.0);
+		}
+	}
+	fputs("\n],\"displayTimeUnit\":\"ms\"}\n", fp);
+	const bool result = !ferror(fp);
+	fclose(fp);
+	return result;
+}
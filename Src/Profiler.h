@@ -0,0 +1,135 @@
+/*
+@file Profiler.h
+*/
+#ifndef PROFILER_H_INCLUDED
+#define PROFILER_H_INCLUDED
+#include <vector>
+#include <memory>
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+Kw^CPUvt@C
+
+v֐ubN̐擪PROFILE_SCOPE("O")ƁA
+̃XR[v𔲂܂ł̎ԂXbhƂ̃Oobt@ɋL^
+L^ʂChromẽg[X`(chrome://tracingPerfettoŕ\łJSON)ŏo͂ł
+
+g:
+-# AvP[V̏Profiler::SetEnabled(true)Ăяo
+-# t[̐擪BeginFrame()AEndFrame()Ăяo
+-# IWriteChromeTrace()Ōʂt@Cɏo͂
+
+̂ƂPROFILE_SCOPÉAtO1ǂނŉL^Ȃ
+PROFILER_DISABLED`ărhƁAPROFILE_SCOPE̓R[h𐶐Ȃ
+*/
+class Profiler
+{
+public:
+	static Profiler& Instance();
+
+	// vԂ̋L^
+	struct Event
+	{
+		const char* name = nullptr;   // Ԃ̖O(񃊃e)
+		const char* parent = nullptr; // eԂ̖O(Ȃnullptr)
+		int64_t begin = 0;            // Jn(imb)
+		int64_t end = 0;              // I(imb)
+		int depth = 0;                // q̐[(0łO)
+	};
+
+	static bool IsEnabled() { return isEnabled.load(std::memory_order_relaxed); }
+	void SetEnabled(bool enable);
+	void SetSpikeThreshold(double ms) { spikeThreshold = ms; }
+	void SetThreadName(const char* name);
+
+	void BeginFrame();
+	void EndFrame();
+	double LastFrameTime() const;
+	void PrintFrameSummary() const;
+	bool WriteChromeTrace(const char* filename) const;
+
+	static int64_t Now();
+	void BeginScope(const char* name);
+	void EndScope(int64_t begin);
+
+private:
+	Profiler() = default;
+	~Profiler() = default;
+	Profiler(const Profiler&) = delete;
+	Profiler& operator=(const Profiler&) = delete;
+
+	/*
+	XbhƂ̋L^obt@
+
+	ނ͎̂̃XbhȂ̂ŁAmutex̂͏o͂Ƃ
+	*/
+	struct ThreadBuffer
+	{
+		static const size_t capacity = 65536;
+		mutable std::mutex mutex;
+		std::vector<Event> events;             // Oobt@
+		size_t head = 0;                       // ɏވʒu
+		size_t size = 0;                       // i[ĂL^̐
+		int id = 0;                            // g[Xɏo͂Xbhԍ
+		std::string name;                      // Xbh
+		std::vector<const char*> scopeStack;   // v̋Ԃ̖O
+	};
+
+	ThreadBuffer& CurrentBuffer();
+	void CollectEvents(int64_t begin, int64_t end,
+		std::vector<std::pair<const ThreadBuffer*, std::vector<Event>>>& result) const;
+
+	static std::atomic<bool> isEnabled;
+
+	mutable std::mutex buffersMutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+	int64_t frameBegin = 0;     // ṽt[̊Jn
+	int64_t lastFrameBegin = 0; // ŌɏIt[̊Jn
+	int64_t lastFrameEnd = 0;   // ŌɏIt[̏I
+	double spikeThreshold = 0;  // ̎(~b)𒴂t[̓\(0Ȃ\Ȃ)
+};
+
+/*
+XR[v𔲂܂ł̎ԂvNX
+
+PROFILE_SCOPE}Ng
+*/
+class ProfileScope
+{
+public:
+	explicit ProfileScope(const char* name)
+	{
+		if (Profiler::IsEnabled())
+		{
+			begin = Profiler::Now();
+			Profiler::Instance().BeginScope(name);
+		}
+	}
+	~ProfileScope()
+	{
+		if (begin >= 0)
+		{
+			Profiler::Instance().EndScope(begin);
+		}
+	}
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+	int64_t begin = -1; // vJn(vȂꍇ͕)
+};
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef PROFILER_DISABLED
+#define PROFILE_SCOPE(name) ((void)0)
+#else
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#endif
+
+#endif // !PROFILER_H_INCLUDED
@@ -2,6 +2,7 @@
 @file Scene.cpp
 */
 #include "Scene.h"
+#include "Profiler.h"
 #include <iostream>
 
 /*
@@ -231,6 +232,7 @@ bool SceneStack::Empty() const
 */
 void SceneStack::Update(float deltaTime)
 {
+	PROFILE_SCOPE("SceneStack::Update");
 	if (!Empty())
 	{
 		Current().ProcessInput();
@@ -244,11 +246,33 @@ void SceneStack::Update(float deltaTime)
 	}
 }
 
+/*
+V[̕`f[^XV
+
+@param deltaTime O̕`悩̌oߎ(b)
+@param alpha     V~[Vʂ̕ԌW(0`1)
+
+Œ莞ԃXebvłUpdate()1t[0ȏĂ΂̂ŁA
+`ɊւXV͂Ŗt[1񂾂s
+*/
+void SceneStack::UpdateDrawData(float deltaTime, float alpha)
+{
+	PROFILE_SCOPE("SceneStack::UpdateDrawData");
+	for (ScenePtr& e : stack)
+	{
+		if (e->IsVisible())
+		{
+			e->UpdateDrawData(deltaTime, alpha);
+		}
+	}
+}
+
 /*
 V[`悷
 */
 void SceneStack::Render()
 {
+	PROFILE_SCOPE("SceneStack::Render");
 	for (ScenePtr& e : stack)
 	{
 		if (e->IsVisible())
@@ -24,6 +24,7 @@ public:
 	virtual bool Initialize() = 0{}
 	virtual void ProcessInput() = 0{}
 	virtual void Update(float) = 0{}
+	virtual void UpdateDrawData(float, float) {}
 	virtual void Render() = 0{}
 	virtual void Finalize() = 0{}
 
@@ -60,6 +61,7 @@ public:
 	size_t Size() const;
 	bool Empty() const;
 	void Update(float);
+	void UpdateDrawData(float, float);
 	void Render();
 
 private:
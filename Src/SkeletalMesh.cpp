@@ -4,10 +4,12 @@
 #define NOMINMAX
 #include "SkeletalMesh.h"
 #include "UniformBuffer.h"
+#include "Profiler.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <iostream>
 #include <algorithm>
+#include <mutex>
 
 #pragma runtime_checks("", off)
 #pragma optimize("", on)
@@ -45,6 +47,7 @@ bool isInitialized = false; ///< 
 int currentUboIndex = 0; ///< UBO_uobt@̏ݑCfbNX.
 UniformBufferPtr ubo[2]; ///< {[s񓙂̓]ƂȂUBO(_uobt@).
 std::vector<uint8_t> uboData; ///< UBOɓ]f[^ꎞIɕۑ邽߂̃obt@.
+std::mutex uboDataMutex; ///< uboDataւ̒ǉɍs߂̃~[ebNX.
 GLint uboOffsetAlignment = 0;
 
 } // unnamed namespace
@@ -141,6 +144,8 @@ GLintptr PushUniformData(const void* data, size_t size)
 
   const size_t alignedSize = ((size + uboOffsetAlignment - 1) / uboOffsetAlignment) * uboOffsetAlignment;
 
+  // AN^[̕`f[^XV͕ɍŝŁAǉr.
+  std::lock_guard<std::mutex> lock(uboDataMutex);
   UniformBufferPtr pUbo = ubo[currentUboIndex];
   if (uboData.size() + alignedSize >= static_cast<size_t>(pUbo->Size())) {
     return -1;
@@ -159,6 +164,7 @@ GLintptr PushUniformData(const void* data, size_t size)
 */
 void UploadUniformData()
 {
+  PROFILE_SCOPE("SkeletalAnimation::UploadUniformData");
   if (!isInitialized) {
     return;
   }
@@ -403,6 +409,7 @@ SkeletalMesh::SkeletalMesh(const ExtendedFilePtr& f, const Node* n)
 */
 void SkeletalMesh::Update(float deltaTime, const glm::mat4& matModel, const glm::vec4& color)
 {
+  PROFILE_SCOPE("SkeletalMesh::Update");
   // Đt[XV.
   if (animation && state == State::play) {
     frame += deltaTime * animationSpeed;
@@ -27,16 +27,12 @@ SkeletalMeshActor::SkeletalMeshActor(const Mesh::SkeletalMeshPtr& m,
 * `̍XV.
 *
 * @param deltaTime oߎ.
+*
+* fsInterpolate()ŌvẐg.
 */
 void SkeletalMeshActor::UpdateDrawData(float deltaTime)
 {
   if (mesh) {
-    const glm::mat4 matT = glm::translate(glm::mat4(1), position);
-    const glm::mat4 matR_Y = glm::rotate(glm::mat4(1), rotation.y, glm::vec3(0, 1, 0));
-    const glm::mat4 matR_ZY = glm::rotate(matR_Y, rotation.z, glm::vec3(0, 0, -1));
-    const glm::mat4 matR_XZY = glm::rotate(matR_ZY, rotation.x, glm::vec3(1, 0, 0));
-    const glm::mat4 matS = glm::scale(glm::mat4(1), scale);
-    const glm::mat4 matModel = matT * matR_XZY * matS;
     mesh->Update(deltaTime, matModel, glm::vec4(1));
   }
 }
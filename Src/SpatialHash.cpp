@@ -0,0 +1,243 @@
+/*
+@file SpatialHash.cpp
+*/
+#include "SpatialHash.h"
+#include <algorithm>
+#include <cmath>
+
+/*
+RXgN^
+
+@param cellSize  iq̑傫()
+@param boundsMin zŊǗ͈͂̍ŏW(XZ)
+@param boundsMax zŊǗ͈͂̍őW(XZ)
+*/
+SpatialHash::SpatialHash(float cellSize, const glm::vec2& boundsMin, const glm::vec2& boundsMax)
+	: cellSize(cellSize > 0 ? cellSize : 1.0f)
+{
+	denseMin = glm::ivec2(glm::floor(boundsMin / this->cellSize));
+	const glm::ivec2 denseMax = glm::ivec2(glm::ceil(boundsMax / this->cellSize));
+	denseSize = glm::max(denseMax - denseMin, glm::ivec2(1));
+	dense.resize(denseSize.x * denseSize.y);
+}
+
+/*
+WɑΉiqvZ
+
+@param pos W
+
+@return pos܂ފiq̔ԍ
+*/
+glm::ivec2 SpatialHash::CalcCell(const glm::vec3& pos) const
+{
+	return glm::ivec2(static_cast<int>(std::floor(pos.x / cellSize)),
+		static_cast<int>(std::floor(pos.z / cellSize)));
+}
+
+/*
+iq擾
+
+@param cell iq̔ԍ
+
+@return cellɑΉiq
+        ͈͊OŖ쐬̏ꍇ͍쐬
+*/
+std::vector<uint32_t>& SpatialHash::GetCell(const glm::ivec2& cell)
+{
+	const glm::ivec2 local = cell - denseMin;
+	if (local.x >= 0 && local.y >= 0 && local.x < denseSize.x && local.y < denseSize.y)
+	{
+		return dense[local.y * denseSize.x + local.x];
+	}
+	const uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(cell.y)) << 32) |
+		static_cast<uint32_t>(cell.x);
+	return sparse[key];
+}
+
+/*
+iq
+
+@param cell iq̔ԍ
+
+@return cellɑΉiq
+        ͈͊OŖ쐬̏ꍇnullptr
+*/
+const std::vector<uint32_t>* SpatialHash::FindCell(const glm::ivec2& cell) const
+{
+	const glm::ivec2 local = cell - denseMin;
+	if (local.x >= 0 && local.y >= 0 && local.x < denseSize.x && local.y < denseSize.y)
+	{
+		return &dense[local.y * denseSize.x + local.x];
+	}
+	const uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(cell.y)) << 32) |
+		static_cast<uint32_t>(cell.x);
+	const auto itr = sparse.find(key);
+	if (itr == sparse.end())
+	{
+		return nullptr;
+	}
+	return &itr->second;
+}
+
+/*
+vfiqɓo^
+
+@param id vfID
+*/
+void SpatialHash::Link(uint32_t id)
+{
+	Entry& e = entries[id];
+	std::vector<uint32_t>& cell = GetCell(e.cell);
+	e.slot = static_cast<uint32_t>(cell.size());
+	cell.push_back(id);
+}
+
+/*
+vfiqO
+
+@param id vfID
+
+iq̍Ō̗vf󂢂ʒuɈڂ̂ŁAԂ͕ۂȂ
+*/
+void SpatialHash::Unlink(uint32_t id)
+{
+	Entry& e = entries[id];
+	std::vector<uint32_t>& cell = GetCell(e.cell);
+	const uint32_t last = cell.back();
+	cell[e.slot] = last;
+	entries[last].slot = e.slot;
+	cell.pop_back();
+	e.slot = unusedSlot;
+}
+
+/*
+vfǉ
+
+@param pos   vf̈ʒu
+@param value vfɊ֘Atf[^
+
+@return ǉvfID
+*/
+uint32_t SpatialHash::Insert(const glm::vec3& pos, uint32_t value)
+{
+	uint32_t id;
+	if (freeIds.empty())
+	{
+		id = static_cast<uint32_t>(entries.size());
+		entries.push_back(Entry());
+	}
+	else
+	{
+		id = freeIds.back();
+		freeIds.pop_back();
+	}
+	Entry& e = entries[id];
+	e.position = pos;
+	e.cell = CalcCell(pos);
+	e.value = value;
+	Link(id);
+	return id;
+}
+
+/*
+vf̈ʒuXV
+
+@param id  vfID
+@param pos Vʒu
+
+iq܂ꍇiqڂւ
+*/
+void SpatialHash::Move(uint32_t id, const glm::vec3& pos)
+{
+	Entry& e = entries[id];
+	e.position = pos;
+	const glm::ivec2 cell = CalcCell(pos);
+	if (cell != e.cell)
+	{
+		Unlink(id);
+		e.cell = cell;
+		Link(id);
+	}
+}
+
+/*
+vf폜
+
+@param id vfID
+*/
+void SpatialHash::Erase(uint32_t id)
+{
+	Unlink(id);
+	freeIds.push_back(id);
+}
+
+/*
+ׂĂ̗vf폜
+*/
+void SpatialHash::Clear()
+{
+	for (std::vector<uint32_t>& cell : dense)
+	{
+		cell.clear();
+	}
+	sparse.clear();
+	entries.clear();
+	freeIds.clear();
+}
+
+/*
+w肳ꂽW̋ߖTɂvf
+
+@param pos         ̊_ƂȂW
+@param maxDistance ߖTƂ݂Ȃő勗()
+@param result      vf̃f[^ǉz
+
+amaxDistance͈̔͂ɂiq𒲂ׂ
+͈͂vf葽̊iqɂꍇ́AׂĂ̗vf𒼐ڒׂ
+*/
+void SpatialHash::Query(const glm::vec3& pos, float maxDistance,
+	std::vector<uint32_t>& result) const
+{
+	const glm::ivec2 min = CalcCell(pos - glm::vec3(maxDistance));
+	const glm::ivec2 max = CalcCell(pos + glm::vec3(maxDistance));
+	const uint64_t cellCount = static_cast<uint64_t>(max.x - min.x + 1) *
+		static_cast<uint64_t>(max.y - min.y + 1);
+	const float maxDistance2 = maxDistance * maxDistance;
+
+	if (cellCount > entries.size())
+	{
+		for (const Entry& e : entries)
+		{
+			if (e.slot != unusedSlot)
+			{
+				const glm::vec3 v = e.position - pos;
+				if (glm::dot(v, v) <= maxDistance2)
+				{
+					result.push_back(e.value);
+				}
+			}
+		}
+		return;
+	}
+
+	for (int y = min.y; y <= max.y; ++y)
+	{
+		for (int x = min.x; x <= max.x; ++x)
+		{
+			const std::vector<uint32_t>* cell = FindCell(glm::ivec2(x, y));
+			if (!cell)
+			{
+				continue;
+			}
+			for (uint32_t id : *cell)
+			{
+				const Entry& e = entries[id];
+				const glm::vec3 v = e.position - pos;
+				if (glm::dot(v, v) <= maxDistance2)
+				{
+					result.push_back(e.value);
+				}
+			}
+		}
+	}
+}
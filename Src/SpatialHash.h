@@ -0,0 +1,62 @@
+/*
+@file SpatialHash.h
+*/
+#ifndef SPATIALHASH_H_INCLUDED
+#define SPATIALHASH_H_INCLUDED
+#include <glm/glm.hpp>
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+
+/*
+XZʂ̑傫̊iqɕāAʒuvfNX
+
+boundsMin`boundsMax͈͔̔͂zŁA͈͊O̓nbVe[uŊiqǗ̂
+Wɐ͂Ȃ
+vf͊iq܂Ƃʂ̊iqɈڂւ
+*/
+class SpatialHash
+{
+public:
+	explicit SpatialHash(float cellSize = 10.0f,
+		const glm::vec2& boundsMin = glm::vec2(0),
+		const glm::vec2& boundsMax = glm::vec2(200));
+	~SpatialHash() = default;
+
+	uint32_t Insert(const glm::vec3& pos, uint32_t value);
+	void Move(uint32_t id, const glm::vec3& pos);
+	void Erase(uint32_t id);
+	void SetValue(uint32_t id, uint32_t value) { entries[id].value = value; }
+	void Clear();
+	void Query(const glm::vec3& pos, float maxDistance, std::vector<uint32_t>& result) const;
+
+	float CellSize() const { return cellSize; }
+	size_t Size() const { return entries.size() - freeIds.size(); }
+
+private:
+	// iqɓo^vf
+	struct Entry
+	{
+		glm::vec3 position = glm::vec3(0); // ʒu
+		glm::ivec2 cell = glm::ivec2(0);   // iq
+		uint32_t value = 0;                // p̃f[^(z̃CfbNXȂ)
+		uint32_t slot = 0;                 // iq̈ʒu(gpȂunusedSlot)
+	};
+	static const uint32_t unusedSlot = 0xffffffff;
+
+	glm::ivec2 CalcCell(const glm::vec3& pos) const;
+	std::vector<uint32_t>& GetCell(const glm::ivec2& cell);
+	const std::vector<uint32_t>* FindCell(const glm::ivec2& cell) const;
+	void Link(uint32_t id);
+	void Unlink(uint32_t id);
+
+	float cellSize;         // iq̑傫()
+	glm::ivec2 denseMin;    // zŊǗŏ̊iq
+	glm::ivec2 denseSize;   // zŊǗiq̐
+	std::vector<std::vector<uint32_t>> dense;                   // ͈͓̊iq
+	std::unordered_map<uint64_t, std::vector<uint32_t>> sparse; // ͈͊O̊iq
+	std::vector<Entry> entries;    // vf̔z(CfbNXvfID)
+	std::vector<uint32_t> freeIds; // ėpłID
+};
+
+#endif // !SPATIALHASH_H_INCLUDED
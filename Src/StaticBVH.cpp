@@ -0,0 +1,401 @@
+/*
+@file StaticBVH.cpp
+*/
+#include "StaticBVH.h"
+#include <algorithm>
+#include <cmath>
+#include <float.h>
+
+namespace /* unnamed */ {
+
+/*
+2AABB͂AABBvZ
+*/
+Collision::AABB Merge(const Collision::AABB& a, const Collision::AABB& b)
+{
+	return { glm::min(a.min, b.min), glm::max(a.max, b.max) };
+}
+
+/*
+AABBׂ
+*/
+bool IsEmpty(const Collision::AABB& box)
+{
+	return box.min.x > box.max.x;
+}
+
+// ɎgX^bN̑傫(؂̐[log2(vf/maxLeafSize)xȂ̂ŏ\)
+const int stackSize = 64;
+
+} // unnamed namespace
+
+/*
+؂\z
+
+@param shapes Փˌ`̔z
+
+`󂪂Ȃvf͖؂Ɋ܂߂Ȃ
+*/
+void StaticBVH::Build(const std::vector<Collision::Shape>& shapes)
+{
+	Clear();
+	boxes.resize(shapes.size());
+	centers.resize(shapes.size());
+	items.reserve(shapes.size());
+	for (size_t i = 0; i < shapes.size(); ++i)
+	{
+		boxes[i] = Collision::CalcAABB(shapes[i]);
+		centers[i] = (boxes[i].min + boxes[i].max) * 0.5f;
+		if (!IsEmpty(boxes[i]))
+		{
+			items.push_back(static_cast<uint32_t>(i));
+		}
+	}
+	if (items.empty())
+	{
+		return;
+	}
+	nodes.reserve(items.size() * 2 / maxLeafSize + 1);
+	nodes.emplace_back();
+	Split(0, 0, static_cast<uint32_t>(items.size()));
+}
+
+/*
+߂𕪊
+
+@param nodeIndex 
+@param begin     ߂󂯎vf̐擪(items̃CfbNX)
+@param end       ߂󂯎vf̏I[(items̃CfbNX)
+
+SW͈̔͂łLŁAvfɂȂʒuŕ
+*/
+void StaticBVH::Split(uint32_t nodeIndex, uint32_t begin, uint32_t end)
+{
+	nodes[nodeIndex].box = CalcBounds(begin, end);
+	const uint32_t count = end - begin;
+	if (count <= maxLeafSize)
+	{
+		nodes[nodeIndex].first = begin;
+		nodes[nodeIndex].count = count;
+		return;
+	}
+
+	glm::vec3 cmin = centers[items[begin]];
+	glm::vec3 cmax = cmin;
+	for (uint32_t i = begin + 1; i < end; ++i)
+	{
+		cmin = glm::min(cmin, centers[items[i]]);
+		cmax = glm::max(cmax, centers[items[i]]);
+	}
+	const glm::vec3 extent = cmax - cmin;
+	int axis = 0;
+	if (extent.y > extent[axis])
+	{
+		axis = 1;
+	}
+	if (extent.z > extent[axis])
+	{
+		axis = 2;
+	}
+	const uint32_t mid = begin + count / 2;
+	std::nth_element(items.begin() + begin, items.begin() + mid, items.begin() + end,
+		[this, axis](uint32_t a, uint32_t b) { return centers[a][axis] < centers[b][axis]; });
+
+	// q2ׂĊmۂ(emplace_backŎQƂɂȂ̂œYŃANZX)
+	const uint32_t left = static_cast<uint32_t>(nodes.size());
+	nodes.emplace_back();
+	nodes.emplace_back();
+	nodes[nodeIndex].first = left;
+	nodes[nodeIndex].count = 0;
+	Split(left, begin, mid);
+	Split(left + 1, mid, end);
+}
+
+/*
+vf͂AABBvZ
+
+@param begin vf̐擪(items̃CfbNX)
+@param end   vf̏I[(items̃CfbNX)
+*/
+Collision::AABB StaticBVH::CalcBounds(uint32_t begin, uint32_t end) const
+{
+	Collision::AABB box = boxes[items[begin]];
+	for (uint32_t i = begin + 1; i < end; ++i)
+	{
+		box = Merge(box, boxes[items[i]]);
+	}
+	return box;
+}
+
+/*
+؂̌`ۂ܂AABBXV
+
+@param shapes Փˌ`̔z(Build()ƓԁAvfł邱)
+
+q͐eɕł̂ŁA珇ɌvZΎqɍXV
+*/
+void StaticBVH::Refit(const std::vector<Collision::Shape>& shapes)
+{
+	if (shapes.size() != boxes.size())
+	{
+		Build(shapes);
+		return;
+	}
+	for (uint32_t i : items)
+	{
+		boxes[i] = Collision::CalcAABB(shapes[i]);
+	}
+	for (size_t i = nodes.size(); i > 0; --i)
+	{
+		Node& node = nodes[i - 1];
+		if (node.count > 0)
+		{
+			node.box = CalcBounds(node.first, node.first + node.count);
+		}
+		else
+		{
+			node.box = Merge(nodes[node.first].box, nodes[node.first + 1].box);
+		}
+	}
+}
+
+/*
+؂ɂ
+*/
+void StaticBVH::Clear()
+{
+	nodes.clear();
+	items.clear();
+	boxes.clear();
+	centers.clear();
+}
+
+/*
+AABBƏdȂvf
+
+@param box    ͈
+@param result vf̃CfbNXǉz(Ԃ͕s)
+*/
+void StaticBVH::QueryOverlap(const Collision::AABB& box, std::vector<uint32_t>& result) const
+{
+	if (nodes.empty() || IsEmpty(box))
+	{
+		return;
+	}
+	uint32_t stack[stackSize];
+	int sp = 0;
+	stack[sp++] = 0;
+	while (sp > 0)
+	{
+		const Node& node = nodes[stack[--sp]];
+		if (!Collision::TestAABBAABB(node.box, box))
+		{
+			continue;
+		}
+		if (node.count > 0)
+		{
+			for (uint32_t i = node.first; i < node.first + node.count; ++i)
+			{
+				if (Collision::TestAABBAABB(boxes[items[i]], box))
+				{
+					result.push_back(items[i]);
+				}
+			}
+		}
+		else if (sp + 2 <= stackSize)
+		{
+			stack[sp++] = node.first;
+			stack[sp++] = node.first + 1;
+		}
+	}
+}
+
+/*
+_ɍł߂vf
+
+@param shapes      Build()ɓnՓˌ`̔z
+@param p           ̊_
+@param maxDistance ő勗
+@param index       vf̃CfbNX̊i[
+@param closest     vf̍ŋߐړ_̊i[(pɂꍇp)
+
+@retval true  maxDistanceȓɗvf
+@retval false Ȃ
+
+߂̎q璲ׁA艓߂ׂ͒Ȃ
+*/
+bool StaticBVH::FindClosest(const std::vector<Collision::Shape>& shapes, const glm::vec3& p,
+	float maxDistance, uint32_t* index, glm::vec3* closest) const
+{
+	if (nodes.empty())
+	{
+		return false;
+	}
+	float bestSq = maxDistance * maxDistance;
+	bool found = false;
+	uint32_t stack[stackSize];
+	int sp = 0;
+	stack[sp++] = 0;
+	while (sp > 0)
+	{
+		const Node& node = nodes[stack[--sp]];
+		if (Collision::DistanceSqAABB(node.box, p) > bestSq)
+		{
+			continue;
+		}
+		if (node.count > 0)
+		{
+			for (uint32_t i = node.first; i < node.first + node.count; ++i)
+			{
+				const uint32_t item = items[i];
+				if (Collision::DistanceSqAABB(boxes[item], p) > bestSq)
+				{
+					continue;
+				}
+				const glm::vec3 q = Collision::ClosestPointShape(shapes[item], p);
+				const glm::vec3 v = p - q;
+				const float d2 = glm::dot(v, v);
+				if (d2 <= bestSq)
+				{
+					bestSq = d2;
+					*index = item;
+					*closest = q;
+					found = true;
+				}
+			}
+		}
+		else if (sp + 2 <= stackSize)
+		{
+			// ɐςŁA߂o
+			const uint32_t a = node.first;
+			const uint32_t b = node.first + 1;
+			if (Collision::DistanceSqAABB(nodes[a].box, p) < Collision::DistanceSqAABB(nodes[b].box, p))
+			{
+				stack[sp++] = b;
+				stack[sp++] = a;
+			}
+			else
+			{
+				stack[sp++] = a;
+				stack[sp++] = b;
+			}
+		}
+	}
+	return found;
+}
+
+/*
+CƍŏɌvf
+
+@param shapes      Build()ɓnՓˌ`̔z
+@param origin      C̎n_
+@param dir         Č(KĂ邱)
+@param maxDistance C̒
+@param index       vf̃CfbNX̊i[
+@param t           _܂ł̋̊i[
+@param ignore      肵Ȃvf̃CfbNX(ȂinvalidIndex)
+
+@retval true  vf
+@retval false Ȃ
+*/
+bool StaticBVH::Raycast(const std::vector<Collision::Shape>& shapes, const glm::vec3& origin,
+	const glm::vec3& dir, float maxDistance, uint32_t* index, float* t, uint32_t ignore) const
+{
+	if (nodes.empty())
+	{
+		return false;
+	}
+	const glm::vec3 invDir = Collision::InverseDirection(dir);
+
+	float best = maxDistance;
+	bool found = false;
+	uint32_t stack[stackSize];
+	int sp = 0;
+	stack[sp++] = 0;
+	while (sp > 0)
+	{
+		const Node& node = nodes[stack[--sp]];
+		float tNode;
+		if (!Collision::IntersectRayAABB(origin, invDir, node.box, best, &tNode))
+		{
+			continue;
+		}
+		if (node.count > 0)
+		{
+			for (uint32_t i = node.first; i < node.first + node.count; ++i)
+			{
+				const uint32_t item = items[i];
+				float tItem;
+				if (item == ignore ||
+					!Collision::IntersectRayAABB(origin, invDir, boxes[item], best, &tItem))
+				{
+					continue;
+				}
+				if (Collision::IntersectRayShape(origin, dir, shapes[item], best, &tItem) &&
+					(!found || tItem < best || (tItem == best && item < *index)))
+				{
+					best = tItem;
+					*index = item;
+					found = true;
+				}
+			}
+		}
+		else if (sp + 2 <= stackSize)
+		{
+			stack[sp++] = node.first + 1;
+			stack[sp++] = node.first;
+		}
+	}
+	if (found)
+	{
+		*t = best;
+	}
+	return found;
+}
+
+/*
+CAABBvf
+
+@param origin      C̎n_
+@param dir         Č(KĂ邱)
+@param maxDistance C̒
+@param result      vf̃CfbNXǉz(Ԃ͕s)
+
+SĂ̗vf𒲂ׂꍇɁAڍׂȔ̌i荞ނ߂Ɏg
+*/
+void StaticBVH::QueryRay(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+	std::vector<uint32_t>& result) const
+{
+	if (nodes.empty())
+	{
+		return;
+	}
+	const glm::vec3 invDir = Collision::InverseDirection(dir);
+	uint32_t stack[stackSize];
+	int sp = 0;
+	stack[sp++] = 0;
+	while (sp > 0)
+	{
+		const Node& node = nodes[stack[--sp]];
+		float t;
+		if (!Collision::IntersectRayAABB(origin, invDir, node.box, maxDistance, &t))
+		{
+			continue;
+		}
+		if (node.count > 0)
+		{
+			for (uint32_t i = node.first; i < node.first + node.count; ++i)
+			{
+				if (Collision::IntersectRayAABB(origin, invDir, boxes[items[i]], maxDistance, &t))
+				{
+					result.push_back(items[i]);
+				}
+			}
+		}
+		else if (sp + 2 <= stackSize)
+		{
+			stack[sp++] = node.first + 1;
+			stack[sp++] = node.first;
+		}
+	}
+}
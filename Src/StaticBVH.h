@@ -0,0 +1,68 @@
+/*
+@file StaticBVH.h
+*/
+#ifndef STATICBVH_H_INCLUDED
+#define STATICBVH_H_INCLUDED
+#include "Collision.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <stdint.h>
+
+/*
+ȂՓˌ`̂߂̋E{[Kw(BVH)
+
+Փˌ`͂AABB񕪖؂ɂ܂Ƃ߁AdȂEŋߐړ_EC̊e
+vf̑ΐɋ߂Ԃōs悤ɂ
+vf̃CfbNX͍\zɎgz̃CfbNXŁABuild()蒼܂ŕςȂ
+
+`󂪓ꍇRefit()Ŗ؂̌`ۂ܂AABBXVł
+傫ꍇvfꍇBuild()ō蒼
+*/
+class StaticBVH
+{
+public:
+	StaticBVH() = default;
+	~StaticBVH() = default;
+
+	void Build(const std::vector<Collision::Shape>& shapes);
+	void Refit(const std::vector<Collision::Shape>& shapes);
+	void Clear();
+	bool Empty() const { return nodes.empty(); }
+	size_t Size() const { return items.size(); }
+
+	void QueryOverlap(const Collision::AABB& box, std::vector<uint32_t>& result) const;
+	bool FindClosest(const std::vector<Collision::Shape>& shapes, const glm::vec3& p,
+		float maxDistance, uint32_t* index, glm::vec3* closest) const;
+	bool Raycast(const std::vector<Collision::Shape>& shapes, const glm::vec3& origin,
+		const glm::vec3& dir, float maxDistance, uint32_t* index, float* t,
+		uint32_t ignore = invalidIndex) const;
+	void QueryRay(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+		std::vector<uint32_t>& result) const;
+
+	static const uint32_t invalidIndex = 0xffffffff;
+
+private:
+	/*
+	؂̐
+
+	count0Ȃ߂ŁAqfirstfirst + 1ɂ
+	count1ȏȂtŁAitems[first]count̗vf
+	*/
+	struct Node
+	{
+		Collision::AABB box; // q̗vfׂĈ͂AABB
+		uint32_t first = 0;  // q̐߁A܂͗vf̐擪
+		uint32_t count = 0;  // tvf̐
+	};
+	static const uint32_t maxLeafSize = 4;
+
+	void Split(uint32_t nodeIndex, uint32_t begin, uint32_t end);
+	Collision::AABB CalcBounds(uint32_t begin, uint32_t end) const;
+
+	std::vector<Node> nodes;              // 0ԂBq͕Keɕ
+	std::vector<uint32_t> items;          // tQƂvf̃CfbNX
+	std::vector<Collision::AABB> boxes;   // vfƂAABB
+	std::vector<glm::vec3> centers;       // \zɎgvfƂAABB̒S
+};
+
+#endif // !STATICBVH_H_INCLUDED
@@ -3,8 +3,11 @@
 */
 #include "Terrain.h"
 #include "Texture.h"
+#include "Profiler.h"
 #include <iostream>
 #include <algorithm>
+#include <cmath>
+#include <float.h>
 
 //n`ɊւNXi[閼O
 namespace Terrain
@@ -48,6 +51,8 @@ namespace Terrain
 			}
 		}
 
+		BuildHeightRanges();
+
 		for (int i = 0; i < 2; ++i)
 		{
 			// GL_RGBA8I   RGBA4vfȂ8rbgt
@@ -113,6 +118,268 @@ namespace Terrain
 		}
 	}
 
+	/*
+	̍ŏlƍől̃~bv}bv쐬
+
+	`̒nʂ4_̍̊ԂɎ܂̂ŁA0iڂ4_̍ŏlƍőlɂ
+	1iオ邲ƂɁA̒ȉc2܂Ƃ߂([1܂Ƃ߂)
+	*/
+	void HeightMap::BuildHeightRanges()
+	{
+		heightRanges.clear();
+		if (size.x < 2 || size.y < 2)
+		{
+			return;
+		}
+
+		HeightRange base;
+		base.size = size - 1;
+		base.minMax.resize(base.size.x * base.size.y);
+		for (int z = 0; z < base.size.y; ++z)
+		{
+			for (int x = 0; x < base.size.x; ++x)
+			{
+				const float h[] = {
+					heights[z * size.x + x], heights[z * size.x + x + 1],
+					heights[(z + 1) * size.x + x], heights[(z + 1) * size.x + x + 1] };
+				base.minMax[z * base.size.x + x] = glm::vec2(
+					std::min(std::min(h[0], h[1]), std::min(h[2], h[3])),
+					std::max(std::max(h[0], h[1]), std::max(h[2], h[3])));
+			}
+		}
+		heightRanges.push_back(std::move(base));
+
+		while (heightRanges.back().size.x > 1 || heightRanges.back().size.y > 1)
+		{
+			const HeightRange& lower = heightRanges.back();
+			HeightRange upper;
+			upper.size = (lower.size + 1) / 2;
+			upper.minMax.resize(upper.size.x * upper.size.y);
+			for (int z = 0; z < upper.size.y; ++z)
+			{
+				for (int x = 0; x < upper.size.x; ++x)
+				{
+					glm::vec2 range(FLT_MAX, -FLT_MAX);
+					const int xEnd = std::min(x * 2 + 2, lower.size.x);
+					const int zEnd = std::min(z * 2 + 2, lower.size.y);
+					for (int lz = z * 2; lz < zEnd; ++lz)
+					{
+						for (int lx = x * 2; lx < xEnd; ++lx)
+						{
+							const glm::vec2& e = lower.minMax[lz * lower.size.x + lx];
+							range.x = std::min(range.x, e.x);
+							range.y = std::max(range.y, e.y);
+						}
+					}
+					upper.minMax[z * upper.size.x + x] = range;
+				}
+			}
+			heightRanges.push_back(std::move(upper));
+		}
+	}
+
+	/*
+	CƒnʂĂ邩ׂ
+
+	@param origin      C̎n_
+	@param dir         Č(KĂ邱)
+	@param maxDistance C̒
+	@param t           _܂ł̋̊i[(n_nʂ艺ɂꍇ0)
+	@param normal      _܂ގOp`̖@̊i[
+
+	@retval true  Ă
+	@retval false ĂȂ
+
+	}bv͈̔͊O(XZ)ׂ͒Ȃ
+	CXZʏŒʉ߂鐳`n_ɋ߂ɂǂ(DDA)A`Ίp
+	؂eԂł́uC̍ - nʂ̍vIɕω邱ƂgČ_߂
+	`ɓ邽тɁA܂ލł傫ȃ~bv}bv͈̔͂珇ɒׁA
+	͈͂ʉ߂Ԃ̃C͈͓̍ő̍ɂ΁A͈͂Ɣ΂
+	*/
+	bool HeightMap::Raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+		float* t, glm::vec3* normal) const
+	{
+		if (size.x < 2 || size.y < 2 || heightRanges.empty())
+		{
+			return false;
+		}
+
+		// C}bv͈̔͂ɐ؂l߂
+		const glm::vec2 o(origin.x, origin.z);
+		const glm::vec2 d(dir.x, dir.z);
+		const glm::vec2 boundsMax = glm::vec2(size - 1);
+		float tEnter = 0;
+		float tExit = maxDistance;
+		for (int i = 0; i < 2; ++i)
+		{
+			if (std::abs(d[i]) < FLT_EPSILON)
+			{
+				if (o[i] < 0 || o[i] > boundsMax[i])
+				{
+					return false;
+				}
+				continue;
+			}
+			float t0 = -o[i] / d[i];
+			float t1 = (boundsMax[i] - o[i]) / d[i];
+			if (t0 > t1)
+			{
+				std::swap(t0, t1);
+			}
+			tEnter = std::max(tEnter, t0);
+			tExit = std::min(tExit, t1);
+			if (tEnter > tExit)
+			{
+				return false;
+			}
+		}
+
+		// C̍ƒnʂ̍̍
+		const auto diff = [this, &origin, &dir](float tt) {
+			const glm::vec3 p = origin + dir * tt;
+			return p.y - Height(p);
+		};
+
+		// ŏ̐`ƁAXEZ̋Ez鋗
+		const glm::vec2 pEnter = o + d * tEnter;
+		glm::ivec2 cell = glm::clamp(glm::ivec2(glm::floor(pEnter)), glm::ivec2(0), size - 2);
+		const glm::ivec2 step(d.x > 0 ? 1 : -1, d.y > 0 ? 1 : -1);
+		glm::vec2 tNext(FLT_MAX);
+		glm::vec2 tDelta(FLT_MAX);
+		const auto resetNext = [&]() {
+			for (int i = 0; i < 2; ++i)
+			{
+				if (std::abs(d[i]) >= FLT_EPSILON)
+				{
+					const float boundary = static_cast<float>(cell[i] + (step[i] > 0 ? 1 : 0));
+					tNext[i] = (boundary - o[i]) / d[i];
+					tDelta[i] = 1.0f / std::abs(d[i]);
+				}
+			}
+		};
+		resetNext();
+
+		float tA = tEnter;
+		float fA = diff(tA);
+		if (fA <= 0)
+		{
+			*t = tA;
+			*normal = FaceNormal(origin + dir * tA);
+			return true;
+		}
+		const int levelCount = static_cast<int>(heightRanges.size());
+		while (tA < tExit)
+		{
+			// CnʂmɏʂAł傫Ȕ͈͂TĔ΂
+			bool isSkipped = false;
+			for (int level = levelCount - 1; level >= 0; --level)
+			{
+				const HeightRange& range = heightRanges[level];
+				const glm::ivec2 block(cell.x >> level, cell.y >> level);
+				const glm::ivec2 blockMin = block * (1 << level);
+				const glm::ivec2 blockMax = glm::min(blockMin + (1 << level), size - 1);
+
+				// ͈͂o鋗ƁAo̎
+				float tBlock = tExit;
+				int axis = -1;
+				for (int i = 0; i < 2; ++i)
+				{
+					if (std::abs(d[i]) >= FLT_EPSILON)
+					{
+						const float boundary = static_cast<float>(step[i] > 0 ? blockMax[i] : blockMin[i]);
+						const float tb = (boundary - o[i]) / d[i];
+						if (tb < tBlock)
+						{
+							tBlock = tb;
+							axis = i;
+						}
+					}
+				}
+				const float yMin = origin.y + dir.y * (dir.y < 0 ? tBlock : tA);
+				if (yMin <= range.minMax[block.y * range.size.x + block.x].y)
+				{
+					continue;
+				}
+				if (axis < 0 || tBlock >= tExit)
+				{
+					return false;
+				}
+
+				// ͈͂oƂ̐`Ɉڂ(덷ŋ߂Ȃ悤ɂ)
+				tA = std::max(tA, tBlock);
+				const int other = 1 - axis;
+				cell[axis] = step[axis] > 0 ? blockMax[axis] : blockMin[axis] - 1;
+				cell[other] = glm::clamp(static_cast<int>(std::floor(o[other] + d[other] * tA)),
+					blockMin[other], blockMax[other] - 1);
+				if (cell[axis] < 0 || cell[axis] > size[axis] - 2)
+				{
+					return false;
+				}
+				resetNext();
+				fA = diff(tA);
+				if (fA <= 0)
+				{
+					*t = tA;
+					*normal = FaceNormal(origin + dir * tA);
+					return true;
+				}
+				isSkipped = true;
+				break;
+			}
+			if (isSkipped)
+			{
+				continue;
+			}
+
+			const float tB = std::min(std::min(tNext.x, tNext.y), tExit);
+
+			// `̑Ίp(offset.x + offset.y = 1)zʒuŋԂ𕪂
+			float ts[2] = { tB, tB };
+			const float dd = d.x + d.y;
+			if (std::abs(dd) >= FLT_EPSILON)
+			{
+				const float tm = (static_cast<float>(cell.x + cell.y + 1) - o.x - o.y) / dd;
+				if (tm > tA && tm < tB)
+				{
+					ts[0] = tm;
+				}
+			}
+			for (const float t1 : ts)
+			{
+				if (t1 <= tA)
+				{
+					continue;
+				}
+				const float f1 = diff(t1);
+				if (f1 <= 0)
+				{
+					*t = tA + (t1 - tA) * fA / (fA - f1);
+					*normal = FaceNormal(origin + dir * ((tA + t1) * 0.5f));
+					return true;
+				}
+				tA = t1;
+				fA = f1;
+			}
+
+			// ̐`ɐi
+			if (tNext.x < tNext.y)
+			{
+				cell.x += step.x;
+				tNext.x += tDelta.x;
+			}
+			else
+			{
+				cell.y += step.y;
+				tNext.y += tDelta.y;
+			}
+			if (cell.x < 0 || cell.y < 0 || cell.x > size.x - 2 || cell.y > size.y - 2)
+			{
+				break;
+			}
+		}
+		return false;
+	}
+
 	/*
 	}bv烁bV쐬
 
@@ -280,6 +547,7 @@ namespace Terrain
 	*/
 	void HeightMap::UpdateLightIndex(const ActorList& lights)
 	{
+		PROFILE_SCOPE("HeightMap::UpdateLightIndex");
 		std::vector<glm::i8vec4> pointLightIndex;
 		std::vector<glm::i8vec4> spotLightIndex;
 		pointLightIndex.resize(size.x * size.y, glm::i8vec4(-1));
@@ -357,4 +625,34 @@ namespace Terrain
 		return normalize(sum);
 	}
 
+	/*
+	w肵W܂ގOp`̖@vZ
+
+	@param pos @vZW
+
+	@return pos܂ގOp`̖@
+	*/
+	glm::vec3 HeightMap::FaceNormal(const glm::vec3& pos) const
+	{
+		// Height()Ɠ@ŎOp`I
+		const glm::vec2 fpos = glm::clamp(
+			glm::vec2(pos.x, pos.z), glm::vec2(0.0f), glm::vec2(size) - glm::vec2(1));
+		const glm::ivec2 index = glm::min(glm::ivec2(fpos), size - (glm::ivec2(2)));
+		const glm::vec2 offset = fpos - glm::vec2(index);
+		if (offset.x + offset.y < 1)
+		{
+			const float h0 = heights[index.y * size.x       + index.x];
+			const float h1 = heights[index.y * size.x       + (index.x + 1)];
+			const float h2 = heights[(index.y + 1) * size.x + index.x];
+			return glm::normalize(glm::vec3(h0 - h1, 1, h0 - h2));
+		}
+		else
+		{
+			const float h0 = heights[(index.y + 1) * size.x + (index.x + 1)];
+			const float h1 = heights[(index.y + 1) * size.x + index.x];
+			const float h2 = heights[index.y * size.x       + (index.x + 1)];
+			return glm::normalize(glm::vec3(h1 - h0, 1, h2 - h0));
+		}
+	}
+
 } // namespace Terrain
\ No newline at end of file
@@ -18,6 +18,7 @@ namespace Terrain
 	1. LoadFromFile()ŉ摜t@C獂ǂݍ
 	2. CreateMesh()œǂݍ񂾍񂩂n`bV쐬
 	3. n_̍𒲂ׂɂHeight()g
+	4. Cƒnʂ̌_𒲂ׂɂRaycast()g
 	*/
 	class HeightMap
 	{
@@ -27,6 +28,8 @@ namespace Terrain
 
 		bool LoadFromFile(const char* path, float scale, float baseLevel);
 		float Height(const glm::vec3& pos) const;
+		bool Raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+			float* t, glm::vec3* normal) const;
 		const glm::ivec2& Size() const;
 		bool CreateMesh(Mesh::Buffer& meshBuffer,
 			const char* meshName, const char* texName = nullptr) const;
@@ -41,7 +44,21 @@ namespace Terrain
 		std::vector<float> heights;      //f[^
 		Texture::BufferPtr lightIndex[2];
 
+		/*
+		`͈̔͂ɂnʂ̍̍ŏlƍől(~bv}bv1i)
+
+		0iڂ͐`1ƁA1iオ邲Ƃɏc2̐`܂Ƃ߂
+		*/
+		struct HeightRange
+		{
+			glm::ivec2 size = glm::ivec2(0); // ̒i̗vf
+			std::vector<glm::vec2> minMax;   // x=ŏ̍, y=ő̍
+		};
+		std::vector<HeightRange> heightRanges; // Raycast()Œnʂ͈̔͂΂߂Ɏg
+
 		glm::vec3 CalcNormal(int x, int z) const;
+		glm::vec3 FaceNormal(const glm::vec3& pos) const;
+		void BuildHeightRanges();
 	};
 
 } // namespace Terrain
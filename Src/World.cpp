@@ -0,0 +1,270 @@
+/*
+@file World.cpp
+*/
+#include "World.h"
+#include "Actor.h"
+#include "Terrain.h"
+#include <algorithm>
+
+/*
+RXgN^
+
+@param cellSize  iq̑傫()
+@param boundsMin zŊǗ͈͂̍ŏW(XZ)
+@param boundsMax zŊǗ͈͂̍őW(XZ)
+*/
+World::World(float cellSize, const glm::vec2& boundsMin, const glm::vec2& boundsMax)
+	: spatialHash(cellSize, boundsMin, boundsMax)
+{
+}
+
+/*
+AN^[o^
+
+@param owner AN^[郊Xg
+@param index Xg̃CfbNX
+@param pos   AN^[̈ʒu
+
+@return o^vfID
+*/
+uint32_t World::Register(const ActorListBase* owner, uint32_t index, const glm::vec3& pos)
+{
+	// vfID̂܂ܒlɂĂAʂlinks悤ɂ
+	const uint32_t id = spatialHash.Insert(pos, 0);
+	spatialHash.SetValue(id, id);
+	if (id >= links.size())
+	{
+		links.resize(id + 1);
+	}
+	links[id].owner = owner;
+	links[id].index = index;
+	return id;
+}
+
+/*
+AN^[̓o^
+
+@param id o^vfID
+*/
+void World::Unregister(uint32_t id)
+{
+	spatialHash.Erase(id);
+	links[id].owner = nullptr;
+}
+
+/*
+w肳ꂽXgɏAN^[ߖT猟
+
+@param pos         ̊_ƂȂW
+@param maxDistance ߖTƂ݂Ȃő勗()
+@param owner       Ώۂ̃Xg
+@param result      AN^[̃XgCfbNXǉz
+@param layerMask   Ώۂ̃C[
+*/
+void World::Query(const glm::vec3& pos, float maxDistance,
+	const ActorListBase* owner, std::vector<uint32_t>& result,
+	Collision::LayerMask layerMask) const
+{
+	const size_t first = result.size();
+	spatialHash.Query(pos, maxDistance, result);
+
+	// ̃XgƑΏۊÕC[̗vf菜AIDXgCfbNXɒu
+	const Collision::LayerMask* layer = owner->Store().layer.data();
+	size_t n = first;
+	for (size_t i = first; i < result.size(); ++i)
+	{
+		const Link& link = links[result[i]];
+		if (link.owner == owner && (layer[link.index] & layerMask))
+		{
+			result[n] = link.index;
+			++n;
+		}
+	}
+	result.resize(n);
+}
+
+/*
+ނ킸ߖTɂAN^[
+
+@param pos         ̊_ƂȂW
+@param maxDistance ߖTƂ݂Ȃő勗()
+@param layerMask   Ώۂ̃C[
+
+@return Actor::positionpos甼amaxDistanceȓɂAN^[̔z
+*/
+std::vector<ActorPtr> World::FindNearbyActors(const glm::vec3& pos, float maxDistance,
+	Collision::LayerMask layerMask) const
+{
+	std::vector<uint32_t> ids;
+	ids.reserve(100);
+	spatialHash.Query(pos, maxDistance, ids);
+
+	std::vector<ActorPtr> result;
+	result.reserve(ids.size());
+	for (uint32_t id : ids)
+	{
+		const Link& link = links[id];
+		if (link.owner->Store().layer[link.index] & layerMask)
+		{
+			result.push_back(link.owner->GetActor(link.index));
+		}
+	}
+	return result;
+}
+
+/*
+Č̑ΏۂɂAN^[Xgǉ
+
+@param list ǉ郊Xg(ActorListBasẽRXgN^Ă΂)
+*/
+void World::AddList(const ActorListBase* list)
+{
+	lists.push_back(list);
+}
+
+/*
+Č̑ΏۂAN^[XgO
+
+@param list OXg(ActorListBasẽfXgN^Ă΂)
+*/
+void World::RemoveList(const ActorListBase* list)
+{
+	lists.erase(std::remove(lists.begin(), lists.end(), list), lists.end());
+}
+
+/*
+CƍŏɌAN^[܂͒n`
+
+@param origin      C̎n_
+@param dir         Č(KĂ邱)
+@param maxDistance C̒
+@param hit         ̂̏̊i[
+@param ignore      肵ȂAN^[(C΂AN^[gȂ)
+@param layerMask   Ώۂ̃C[
+
+@retval true  镨̂
+@retval false Ȃ
+
+艓ׂ̂͒Ȃ悤ɁACk߂ȂeXg𒲂ׂ
+ȂXgBVHAȊÕXg͏Փˌ`AABBŌi荞
+n_̂̓ɂꍇA0A@̓C̋tɂȂ
+*/
+bool World::Raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+	RaycastHit* hit, const Actor* ignore, Collision::LayerMask layerMask) const
+{
+	float best = maxDistance;
+	bool found = false;
+	const ActorListBase* bestList = nullptr;
+	size_t bestIndex = 0;
+	glm::vec3 terrainNormal(0);
+	if (heightMap && (layerMask & Collision::ToMask(Collision::Layer::terrain)))
+	{
+		float t;
+		if (heightMap->Raycast(origin, dir, best, &t, &terrainNormal))
+		{
+			best = t;
+			found = true;
+		}
+	}
+	for (const ActorListBase* list : lists)
+	{
+		size_t index;
+		float t;
+		if (list->Raycast(origin, dir, best, &index, &t, ignore, layerMask) && (!found || t < best))
+		{
+			best = t;
+			bestList = list;
+			bestIndex = index;
+			found = true;
+		}
+	}
+	if (!found)
+	{
+		return false;
+	}
+
+	hit->distance = best;
+	hit->position = origin + dir * best;
+	hit->list = bestList;
+	hit->index = bestIndex;
+	if (bestList)
+	{
+		hit->actor = bestList->GetActor(bestIndex);
+		hit->normal = Collision::SurfaceNormalShape(bestList->Store().colWorld[bestIndex], hit->position);
+	}
+	else
+	{
+		hit->actor.reset();
+		hit->normal = terrainNormal;
+	}
+	if (best <= 0 || hit->normal == glm::vec3(0))
+	{
+		hit->normal = -dir;
+	}
+	return true;
+}
+
+/*
+CƌSẴAN^[ƒn`
+
+@param origin      C̎n_
+@param dir         Č(KĂ邱)
+@param maxDistance C̒
+@param hits        ̂̏ǉz(ǉ͈͂͋̋߂ɕ)
+@param ignore      肵ȂAN^[(C΂AN^[gȂ)
+@param layerMask   Ώۂ̃C[
+
+@return ǉ̂̐
+
+eAN^[Ƃ͍ŏ̌_L^Bn`ŏ̌_L^
+*/
+size_t World::RaycastAll(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+	std::vector<RaycastHit>& hits, const Actor* ignore, Collision::LayerMask layerMask) const
+{
+	const size_t first = hits.size();
+	if (heightMap && (layerMask & Collision::ToMask(Collision::Layer::terrain)))
+	{
+		RaycastHit hit;
+		if (heightMap->Raycast(origin, dir, maxDistance, &hit.distance, &hit.normal))
+		{
+			hit.position = origin + dir * hit.distance;
+			if (hit.distance <= 0)
+			{
+				hit.normal = -dir;
+			}
+			hits.push_back(hit);
+		}
+	}
+
+	thread_local std::vector<uint32_t> candidates;
+	for (const ActorListBase* list : lists)
+	{
+		candidates.clear();
+		list->QueryRay(origin, dir, maxDistance, candidates);
+		const ActorStore& store = list->Store();
+		for (const uint32_t i : candidates)
+		{
+			float t;
+			if (store.actor[i] == ignore || !(store.layer[i] & layerMask) ||
+				!Collision::IntersectRayShape(origin, dir, store.colWorld[i], maxDistance, &t))
+			{
+				continue;
+			}
+			RaycastHit hit;
+			hit.actor = list->GetActor(i);
+			hit.list = list;
+			hit.index = i;
+			hit.distance = t;
+			hit.position = origin + dir * t;
+			hit.normal = Collision::SurfaceNormalShape(store.colWorld[i], hit.position);
+			if (t <= 0 || hit.normal == glm::vec3(0))
+			{
+				hit.normal = -dir;
+			}
+			hits.push_back(hit);
+		}
+	}
+	std::stable_sort(hits.begin() + first, hits.end(),
+		[](const RaycastHit& l, const RaycastHit& r) { return l.distance < r.distance; });
+	return hits.size() - first;
+}
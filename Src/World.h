@@ -0,0 +1,98 @@
+/*
+@file World.h
+*/
+#ifndef WORLD_H_INCLUDED
+#define WORLD_H_INCLUDED
+#include "SpatialHash.h"
+#include "ContactCache.h"
+#include "Collision.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <memory>
+#include <stdint.h>
+
+class Actor;
+using ActorPtr = std::shared_ptr<Actor>;
+class ActorListBase;
+namespace Terrain { class HeightMap; }
+
+/*
+AN^[XgLԃCfbNX
+
+ނ̈ႤAN^[Xg1̊iqɓo^āA
+ނ܂ߖT1̌ōς܂悤ɂ
+
+Raycast()RaycastAll()́Ao^ꂽXg̏Փˌ`ƁA
+SetHeightMap()Őݒ肵n`ΏۂɃČs
+֐layerMaskɂ͑Ώۂɂ郌C[̃rbgw肷
+n`Collision::Layer::terraiñrbg܂܂ꍇΏۂɂȂ
+*/
+class World
+{
+public:
+	// Č̌
+	struct RaycastHit
+	{
+		ActorPtr actor;                      // AN^[(n`Ȃnullptr)
+		const ActorListBase* list = nullptr; // actor郊Xg(n`Ȃnullptr)
+		size_t index = 0;                    // list̃CfbNX
+		glm::vec3 position = glm::vec3(0);   // _̍W
+		glm::vec3 normal = glm::vec3(0);     // _̖@
+		float distance = 0;                  // n__܂ł̋
+	};
+
+	explicit World(float cellSize = 10.0f,
+		const glm::vec2& boundsMin = glm::vec2(0),
+		const glm::vec2& boundsMax = glm::vec2(200));
+	~World() = default;
+	World(const World&) = delete;
+	World& operator=(const World&) = delete;
+
+	uint32_t Register(const ActorListBase* owner, uint32_t index, const glm::vec3& pos);
+	void Unregister(uint32_t id);
+	void Move(uint32_t id, const glm::vec3& pos) { spatialHash.Move(id, pos); }
+	void SetIndex(uint32_t id, uint32_t index) { links[id].index = index; }
+
+	void Query(const glm::vec3& pos, float maxDistance,
+		const ActorListBase* owner, std::vector<uint32_t>& result,
+		Collision::LayerMask layerMask = Collision::allLayers) const;
+	std::vector<ActorPtr> FindNearbyActors(const glm::vec3& pos, float maxDistance,
+		Collision::LayerMask layerMask = Collision::allLayers) const;
+
+	// Č̑Ώ
+	void AddList(const ActorListBase* list);
+	void RemoveList(const ActorListBase* list);
+	void SetHeightMap(const Terrain::HeightMap* hm) { heightMap = hm; }
+
+	bool Raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+		RaycastHit* hit, const Actor* ignore = nullptr,
+		Collision::LayerMask layerMask = Collision::allLayers) const;
+	size_t RaycastAll(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+		std::vector<RaycastHit>& hits, const Actor* ignore = nullptr,
+		Collision::LayerMask layerMask = Collision::allLayers) const;
+
+	// Փ˔sC[̑gݍ킹
+	Collision::LayerMatrix& Layers() { return layers; }
+	const Collision::LayerMatrix& Layers() const { return layers; }
+
+	// Փ˔̌ʂ̃t[ɎzL^
+	ContactCache& Contacts() { return contacts; }
+	const ContactCache& Contacts() const { return contacts; }
+
+private:
+	// o^ꂽvf̏
+	struct Link
+	{
+		const ActorListBase* owner = nullptr; // AN^[Xg
+		uint32_t index = 0;                   // Xg̃CfbNX
+	};
+
+	SpatialHash spatialHash;
+	std::vector<Link> links; // spatialHash̗vfIDƂ̏
+	std::vector<const ActorListBase*> lists;       // WorldgAN^[Xg
+	const Terrain::HeightMap* heightMap = nullptr; // ČɎgn`
+	ContactCache contacts; // AN^[m̏Փ˔̋L^
+	Collision::LayerMatrix layers; // Փ˔sC[̑gݍ킹
+};
+
+#endif // !WORLD_H_INCLUDED